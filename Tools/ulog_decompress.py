@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+"""
+Convert a compressed log file (.ulgz, written by the logger with SDLOG_COMPRESS=1)
+back to a ULog file.
+
+The file starts with a header (magic 'ULogLZ4', version, timestamp, block size),
+followed by independently compressed blocks (LZ4 block format), each with a header:
+sync word 'ZBLK', uncompressed offset (uint64), uncompressed size (uint32) and
+compressed size (uint32, bit 31 set if the block is stored uncompressed).
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+FILE_HEADER = struct.Struct('<7sBQI')
+BLOCK_HEADER = struct.Struct('<IQII')
+BLOCK_SYNC = 0x4b4c425a
+BLOCK_STORED = 1 << 31
+MAGIC = b'ULogLZ4'
+
+try:
+    import lz4.block
+
+    def decompress_block(data, size):
+        return lz4.block.decompress(data, uncompressed_size=size)
+
+except ImportError:
+
+    def decompress_block(data, size):
+        """ pure python LZ4 block decoder (install the lz4 module for speed) """
+        out = bytearray()
+        ip = 0
+        end = len(data)
+
+        def read_length(ip, length):
+            while True:
+                b = data[ip]
+                ip += 1
+                length += b
+                if b != 255:
+                    return ip, length
+
+        while ip < end:
+            token = data[ip]
+            ip += 1
+            literal_length = token >> 4
+            if literal_length == 15:
+                ip, literal_length = read_length(ip, literal_length)
+            out += data[ip:ip + literal_length]
+            ip += literal_length
+            if ip >= end:
+                break
+            offset = data[ip] | (data[ip + 1] << 8)
+            ip += 2
+            match_length = token & 0xf
+            if match_length == 15:
+                ip, match_length = read_length(ip, match_length)
+            match_length += 4
+            if offset == 0 or offset > len(out):
+                raise ValueError('invalid match offset')
+            start = len(out) - offset
+            if match_length <= offset:
+                out += out[start:start + match_length]
+            else:
+                # overlapping match: repeat the pattern
+                pattern = out[start:]
+                out += (pattern * (match_length // offset + 1))[:match_length]
+
+        if len(out) != size:
+            raise ValueError('size mismatch')
+        return bytes(out)
+
+
+def read_blocks(f):
+    """ yield (file position, block header, data), resynchronizing on corrupt blocks """
+    f.seek(0)
+    data = f.read()
+    pos = FILE_HEADER.size
+    while pos + BLOCK_HEADER.size <= len(data):
+        sync, offset, size, compressed_size = BLOCK_HEADER.unpack_from(data, pos)
+        length = compressed_size & ~BLOCK_STORED
+        if sync != BLOCK_SYNC or pos + BLOCK_HEADER.size + length > len(data):
+            next_pos = data.find(struct.pack('<I', BLOCK_SYNC), pos + 1)
+            print('Corrupt or truncated block at file offset {:}, {:}'.format(
+                pos, 'skipping' if next_pos >= 0 else 'stopping'), file=sys.stderr)
+            if next_pos < 0:
+                return
+            pos = next_pos
+            continue
+        start = pos + BLOCK_HEADER.size
+        yield pos, (offset, size, compressed_size), data[start:start + length]
+        pos = start + length
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decompress a .ulgz log file to ULog')
+    parser.add_argument('input', help='compressed log file (.ulgz)')
+    parser.add_argument('-o', '--output', help='output file (default: input with .ulg extension)')
+    parser.add_argument('-l', '--list', action='store_true',
+                        help='list the blocks (file offset, ULog offset, sizes) instead of decompressing')
+    args = parser.parse_args()
+
+    with open(args.input, 'rb') as f:
+        magic, version, timestamp, block_size = FILE_HEADER.unpack(f.read(FILE_HEADER.size))
+        if magic != MAGIC or version != 1:
+            sys.exit('{:}: not a compressed log file (version 1)'.format(args.input))
+
+        if args.list:
+            print('{:>12} {:>12} {:>8} {:>8}'.format('file offset', 'ulog offset', 'size', 'stored'))
+            for pos, (offset, size, compressed_size), _ in read_blocks(f):
+                print('{:12} {:12} {:8} {:>8}'.format(pos, offset, size,
+                                                      'raw' if compressed_size & BLOCK_STORED else
+                                                      compressed_size))
+            return
+
+        output = args.output
+        if output is None:
+            output = os.path.splitext(args.input)[0] + '.ulg'
+
+        written = 0
+        with open(output, 'wb') as out:
+            for pos, (offset, size, compressed_size), block in read_blocks(f):
+                if offset != written:
+                    # data is lost, the ULog parser can resync on the following message
+                    print('Gap of {:} bytes at ULog offset {:}'.format(offset - written, written),
+                          file=sys.stderr)
+                    written = offset
+                if not compressed_size & BLOCK_STORED:
+                    try:
+                        block = decompress_block(block, size)
+                    except Exception as e:
+                        print('Failed to decompress block at file offset {:}: {:}'.format(pos, e),
+                              file=sys.stderr)
+                        continue
+                out.write(block)
+                written += len(block)
+
+            print('Wrote {:} ({:} bytes)'.format(output, out.tell()))
+
+
+if __name__ == '__main__':
+    main()
@@ -87,6 +87,7 @@ private:
 	static void	schedule_trampoline(void *arg);
 
 	hrt_call	_call{};
+	hrt_abstime	_next_release{0};	// deadline of the next _call, which is cleared while it's being called
 };
 
 } // namespace px4
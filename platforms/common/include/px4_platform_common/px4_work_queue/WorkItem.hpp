@@ -83,6 +83,23 @@ public:
 
 	const char *ItemName() const { return _item_name; }
 
+	/**
+	 * @return the name of the WorkQueue, nullptr if not attached to one
+	 */
+	const char *WorkQueueName() const { return (_wq != nullptr) ? _wq->get_name() : nullptr; }
+
+#if defined(CONFIG_ORB_GRAPH)
+	/**
+	 * @return the WorkItem running on the calling thread, nullptr outside of Run()
+	 */
+	static const WorkItem *Current() { return _current; }
+
+	/**
+	 * @return a counter of deleted WorkItems, a pointer cached before it changed may refer to another item
+	 */
+	static uint32_t DeletedCount() { return _deleted_count.load(); }
+#endif /* CONFIG_ORB_GRAPH */
+
 protected:
 
 	explicit WorkItem(const char *name, const wq_config_t &config);
@@ -99,16 +116,87 @@ protected:
 
 	void RunPreamble()
 	{
+		const hrt_abstime now = hrt_absolute_time();
+
 		if (_run_count == 0) {
-			_time_first_run = hrt_absolute_time();
+			_time_first_run = now;
 			_run_count = 1;
 
 		} else {
 			_run_count++;
 		}
+
+#if defined(CONFIG_WORK_QUEUE_TIMING)
+		// take the release, the next one can arrive while running
+		hrt_abstime release = _release_time.load();
+
+		while (!_release_time.compare_exchange(&release, 0)) {}
+
+		_run_start = now;
+		_run_lag = (release != 0 && now > release) ? (now - release) : 0;
+		_run_deadline = (release != 0 && _deadline_us > 0) ? (release + _deadline_us) : 0;
+#endif /* CONFIG_WORK_QUEUE_TIMING */
 	}
 
-	friend void WorkQueue::Run();
+	void RunPostamble()
+	{
+#if defined(CONFIG_WORK_QUEUE_TIMING)
+		const hrt_abstime now = hrt_absolute_time();
+		const uint32_t run_time = now - _run_start;
+
+		// sampled and reset from another thread, see sample_timing()
+		_timing_runs.fetch_add(1);
+		_lag_sum.fetch_add(_run_lag);
+		store_max(_lag_max, _run_lag);
+		_run_time_sum.fetch_add(run_time);
+		store_max(_run_time_max, run_time);
+
+		if ((_run_deadline != 0) && (now > _run_deadline)) {
+			_deadline_misses.fetch_add(1);
+		}
+
+#endif /* CONFIG_WORK_QUEUE_TIMING */
+	}
+
+#if defined(CONFIG_WORK_QUEUE_TIMING)
+	static void store_max(px4::atomic<uint32_t> &max, uint32_t value)
+	{
+		uint32_t current = max.load();
+
+		while ((value > current) && !max.compare_exchange(&current, value)) {}
+	}
+
+	/**
+	 * Remember when the item became runnable, only the earliest release that has not run yet is kept.
+	 */
+	void SetReleaseTime(hrt_abstime time)
+	{
+		hrt_abstime none = 0;
+		_release_time.compare_exchange(&none, time);
+	}
+
+	struct timing_window_t {
+		uint32_t runs;
+		uint32_t lag_sum;
+		uint32_t lag_max;
+		uint32_t run_time_sum;
+		uint32_t run_time_max;
+		uint32_t deadline_misses;
+	};
+
+	/**
+	 * Scheduling statistics since the previous reset.
+	 * @return the raw window, to pass to reset_timing()
+	 */
+	timing_window_t sample_timing(work_item_timing_t &timing) const;
+
+	/**
+	 * Remove a sampled window from the statistics, runs that finished after the sample are kept.
+	 */
+	void reset_timing(const timing_window_t &window);
+#endif /* CONFIG_WORK_QUEUE_TIMING */
+
+	friend class WorkQueue;
 	virtual void Run() = 0;
 
 	/**
@@ -130,10 +218,36 @@ protected:
 	const char 	*_item_name;
 	uint32_t	_run_count{0};
 
+	uint32_t	_deadline_us{0};	// relative to the release, 0 if none
+
 private:
 
+#if defined(CONFIG_WORK_QUEUE_TIMING)
+	px4::atomic<hrt_abstime> _release_time{0};
+	hrt_abstime	_run_start{0};
+	hrt_abstime	_run_deadline{0};
+	uint32_t	_run_lag{0};
+
+	// reset by reset_timing()
+	px4::atomic<uint32_t>	_timing_runs{0};
+	px4::atomic<uint32_t>	_lag_sum{0};
+	px4::atomic<uint32_t>	_lag_max{0};
+	px4::atomic<uint32_t>	_run_time_sum{0};
+	px4::atomic<uint32_t>	_run_time_max{0};
+	px4::atomic<uint32_t>	_deadline_misses{0};
+#endif /* CONFIG_WORK_QUEUE_TIMING */
+
+#ifndef __PX4_NUTTX
+	px4::atomic_bool _queued{false}; // pushed to the WorkQueue and not run yet
+#endif /* __PX4_NUTTX */
+
 	WorkQueue	*_wq{nullptr};
 
+#if defined(CONFIG_ORB_GRAPH)
+	static thread_local const WorkItem *_current; // set by the WorkQueue around Run()
+	static px4::atomic<uint32_t> _deleted_count;
+#endif /* CONFIG_ORB_GRAPH */
+
 };
 
 } // namespace px4
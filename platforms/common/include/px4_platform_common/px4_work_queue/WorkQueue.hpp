@@ -38,6 +38,7 @@
 #include <containers/BlockingList.hpp>
 #include <containers/List.hpp>
 #include <containers/IntrusiveQueue.hpp>
+#include <containers/IntrusiveMPSCQueue.hpp>
 #include <px4_platform_common/atomic.h>
 #include <px4_platform_common/defines.h>
 #include <px4_platform_common/sem.h>
@@ -47,6 +48,7 @@ namespace px4
 {
 
 class WorkItem;
+class WorkQueuePool;
 
 class WorkQueue : public IntrusiveSortedListNode<WorkQueue *>
 {
@@ -54,6 +56,13 @@ public:
 	explicit WorkQueue(const wq_config_t &wq_config);
 	WorkQueue() = delete;
 
+#if defined(__PX4_LINUX)
+	/**
+	 * WorkQueue without a thread of its own, run by the worker threads of pool.
+	 */
+	WorkQueue(const wq_config_t &wq_config, WorkQueuePool *pool);
+#endif /* __PX4_LINUX */
+
 	~WorkQueue();
 
 	const wq_config_t &get_config() const { return _config; }
@@ -69,10 +78,28 @@ public:
 
 	void Run();
 
+#if defined(__PX4_LINUX)
+	/**
+	 * Run everything queued, called by a worker of the WorkQueuePool.
+	 * @return false once the WorkQueue was asked to stop
+	 */
+	bool RunPooled();
+
+	bool pooled() const { return _pool != nullptr; }
+#endif /* __PX4_LINUX */
+
 	void request_stop() { _should_exit.store(true); }
 
 	void print_status(bool last = false);
 
+#if defined(CONFIG_WORK_QUEUE_TIMING)
+	/**
+	 * Sample the scheduling statistics of all attached WorkItems (see WorkQueueManagerTimingStats()).
+	 */
+	void sample_timing(bool (*callback)(const char *wq_name, const char *item_name,
+					    const work_item_timing_t &timing, void *arg), void *arg);
+#endif /* CONFIG_WORK_QUEUE_TIMING */
+
 	// WorkQueues sorted numerically by relative priority (-1 to -255)
 	bool operator<=(const WorkQueue &rhs) const { return _config.relative_priority >= rhs.get_config().relative_priority; }
 
@@ -82,6 +109,12 @@ private:
 
 	inline void SignalWorkerThread();
 
+	void ProcessQueue();
+
+#if defined(ENABLE_LOCKSTEP_SCHEDULER)
+	void RegisterLockstepComponent();
+#endif // ENABLE_LOCKSTEP_SCHEDULER
+
 #ifdef __PX4_NUTTX
 	// In NuttX work can be enqueued from an ISR
 	void work_lock() { _flags = enter_critical_section(); }
@@ -95,16 +128,35 @@ private:
 #endif
 
 	IntrusiveQueue<WorkItem *>	_q;
+#ifndef __PX4_NUTTX
+	IntrusiveMPSCQueue<WorkItem *>	_pending;	// lock-free Add(), moved to _q by the worker holding work_lock()
+#endif /* __PX4_NUTTX */
 	px4_sem_t			_process_lock;
 	px4_sem_t			_exit_lock;
 	const wq_config_t		&_config;
 	BlockingList<WorkItem *>	_work_items;
+	WorkItem			*_running{nullptr};	// cleared if it's detached while running
 	px4::atomic_bool		_should_exit{false};
 
 #if defined(ENABLE_LOCKSTEP_SCHEDULER)
-	int _lockstep_component {-1};
+	px4::atomic<int> _lockstep_component{-1};	// registered by Add(), unregistered by the worker once idle
 #endif // ENABLE_LOCKSTEP_SCHEDULER
 
+#if defined(__PX4_LINUX)
+	friend class WorkQueuePool;
+
+	enum PoolState : int {
+		POOL_IDLE,
+		POOL_SCHEDULED,		// waiting for a worker
+		POOL_RUNNING,
+		POOL_RUNNING_SIGNALLED,	// has to run again
+	};
+
+	WorkQueuePool			*_pool{nullptr};
+	px4::atomic<int>		_pool_state{POOL_IDLE};
+	px4::atomic<int>		_pool_worker{0};	// worker that ran it last
+#endif /* __PX4_LINUX */
+
 };
 
 } // namespace px4
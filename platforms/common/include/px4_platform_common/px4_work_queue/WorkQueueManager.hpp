@@ -96,6 +96,16 @@ static constexpr wq_config_t test2{"wq:test2", 2000, 0};
 
 } // namespace wq_configurations
 
+struct work_item_timing_t {
+	uint32_t interval;		// [us] ScheduleOnInterval() period, 0 if not periodic
+	uint32_t runs;			// runs since the window was last reset
+	uint32_t lag_avg;		// [us] from the release (deadline or ScheduleNow()) to the start of Run()
+	uint32_t lag_max;		// [us]
+	uint32_t run_time_avg;		// [us]
+	uint32_t run_time_max;		// [us]
+	uint32_t deadline_misses;	// runs of a periodic item that finished after the next release
+};
+
 /**
  * Start the work queue manager task.
  */
@@ -111,6 +121,18 @@ int WorkQueueManagerStop();
  */
 int WorkQueueManagerStatus();
 
+#if defined(CONFIG_WORK_QUEUE_TIMING)
+/**
+ * Sample the scheduling statistics of every WorkItem.
+ *
+ * @param callback		Called for every WorkItem, with the WorkQueue lists locked. Returns true to start
+ *				a new window for the item, false to keep accumulating (e.g. it was not reported).
+ * @param arg			Passed to callback.
+ */
+void WorkQueueManagerTimingStats(bool (*callback)(const char *wq_name, const char *item_name,
+				 const work_item_timing_t &timing, void *arg), void *arg);
+#endif /* CONFIG_WORK_QUEUE_TIMING */
+
 /**
  * Create (or find) a work queue with a particular configuration.
  *
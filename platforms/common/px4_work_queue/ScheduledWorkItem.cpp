@@ -47,21 +47,34 @@ ScheduledWorkItem::~ScheduledWorkItem()
 void ScheduledWorkItem::schedule_trampoline(void *arg)
 {
 	ScheduledWorkItem *dev = static_cast<ScheduledWorkItem *>(arg);
+
+#if defined(CONFIG_WORK_QUEUE_TIMING)
+	// same as the hrt, periodic calls keep their phase
+	dev->SetReleaseTime(dev->_next_release);
+	dev->_next_release += dev->_call.period;
+#endif /* CONFIG_WORK_QUEUE_TIMING */
+
 	dev->ScheduleNow();
 }
 
 void ScheduledWorkItem::ScheduleDelayed(uint32_t delay_us)
 {
+	_deadline_us = 0;
+	_next_release = hrt_absolute_time() + delay_us;
 	hrt_call_after(&_call, delay_us, (hrt_callout)&ScheduledWorkItem::schedule_trampoline, this);
 }
 
 void ScheduledWorkItem::ScheduleOnInterval(uint32_t interval_us, uint32_t delay_us)
 {
+	_deadline_us = interval_us;
+	_next_release = hrt_absolute_time() + delay_us;
 	hrt_call_every(&_call, delay_us, interval_us, (hrt_callout)&ScheduledWorkItem::schedule_trampoline, this);
 }
 
 void ScheduledWorkItem::ScheduleAt(hrt_abstime time_us)
 {
+	_deadline_us = 0;
+	_next_release = time_us;
 	hrt_call_at(&_call, time_us, (hrt_callout)&ScheduledWorkItem::schedule_trampoline, this);
 }
 
@@ -69,6 +82,7 @@ void ScheduledWorkItem::ScheduleClear()
 {
 	// first clear any scheduled hrt call, then remove the item from the runnable queue
 	hrt_cancel(&_call);
+	_deadline_us = 0;
 	WorkItem::ScheduleClear();
 }
 
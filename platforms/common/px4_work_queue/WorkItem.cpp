@@ -42,6 +42,11 @@
 namespace px4
 {
 
+#if defined(CONFIG_ORB_GRAPH)
+thread_local const WorkItem *WorkItem::_current = nullptr;
+px4::atomic<uint32_t> WorkItem::_deleted_count{0};
+#endif /* CONFIG_ORB_GRAPH */
+
 WorkItem::WorkItem(const char *name, const wq_config_t &config) :
 	_item_name(name)
 {
@@ -63,6 +68,11 @@ WorkItem::WorkItem(const char *name, const WorkItem &work_item) :
 WorkItem::~WorkItem()
 {
 	Deinit();
+
+#if defined(CONFIG_ORB_GRAPH)
+	// invalidates the publishers cached by address (see uORB::Graph::current_publisher())
+	_deleted_count.fetch_add(1);
+#endif /* CONFIG_ORB_GRAPH */
 }
 
 bool WorkItem::Init(const wq_config_t &config)
@@ -132,6 +142,44 @@ float WorkItem::average_interval() const
 	return 0.f;
 }
 
+#if defined(CONFIG_WORK_QUEUE_TIMING)
+WorkItem::timing_window_t WorkItem::sample_timing(work_item_timing_t &timing) const
+{
+	// the sums can be a run ahead of the count while the WorkQueue thread is in RunPostamble()
+	timing_window_t window{};
+	window.runs = _timing_runs.load();
+	window.lag_sum = _lag_sum.load();
+	window.lag_max = _lag_max.load();
+	window.run_time_sum = _run_time_sum.load();
+	window.run_time_max = _run_time_max.load();
+	window.deadline_misses = _deadline_misses.load();
+
+	timing.interval = _deadline_us;
+	timing.runs = window.runs;
+	timing.lag_avg = (window.runs > 0) ? (window.lag_sum / window.runs) : 0;
+	timing.lag_max = window.lag_max;
+	timing.run_time_avg = (window.runs > 0) ? (window.run_time_sum / window.runs) : 0;
+	timing.run_time_max = window.run_time_max;
+	timing.deadline_misses = window.deadline_misses;
+
+	return window;
+}
+
+void WorkItem::reset_timing(const timing_window_t &window)
+{
+	_timing_runs.fetch_sub(window.runs);
+	_lag_sum.fetch_sub(window.lag_sum);
+	_run_time_sum.fetch_sub(window.run_time_sum);
+	_deadline_misses.fetch_sub(window.deadline_misses);
+
+	// a larger maximum since the sample belongs to the next window
+	uint32_t lag_max = window.lag_max;
+	_lag_max.compare_exchange(&lag_max, 0);
+	uint32_t run_time_max = window.run_time_max;
+	_run_time_max.compare_exchange(&run_time_max, 0);
+}
+#endif /* CONFIG_WORK_QUEUE_TIMING */
+
 void WorkItem::print_run_status()
 {
 	PX4_INFO_RAW("%-29s %8.1f Hz %12.0f us\n", _item_name, (double)average_rate(), (double)average_interval());
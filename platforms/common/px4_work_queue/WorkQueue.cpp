@@ -41,6 +41,10 @@
 #include <px4_platform_common/time.h>
 #include <drivers/drv_hrt.h>
 
+#if defined(__PX4_LINUX)
+#include "WorkQueuePool.hpp"
+#endif /* __PX4_LINUX */
+
 namespace px4
 {
 
@@ -65,6 +69,21 @@ WorkQueue::WorkQueue(const wq_config_t &config) :
 	px4_sem_setprotocol(&_exit_lock, SEM_PRIO_NONE);
 }
 
+#if defined(__PX4_LINUX)
+WorkQueue::WorkQueue(const wq_config_t &config, WorkQueuePool *pool) :
+	_config(config),
+	_pool(pool)
+{
+	px4_sem_init(&_qlock, 0, 1);
+
+	px4_sem_init(&_process_lock, 0, 0);
+	px4_sem_setprotocol(&_process_lock, SEM_PRIO_NONE);
+
+	px4_sem_init(&_exit_lock, 0, 1);
+	px4_sem_setprotocol(&_exit_lock, SEM_PRIO_NONE);
+}
+#endif /* __PX4_LINUX */
+
 WorkQueue::~WorkQueue()
 {
 
@@ -105,6 +124,11 @@ void WorkQueue::Detach(WorkItem *item)
 
 	_work_items.remove(item);
 
+	if (_running == item) {
+		// deleted from its own Run()
+		_running = nullptr;
+	}
+
 	if (_work_items.size() == 0) {
 		// shutdown, no active WorkItems
 		PX4_DEBUG("stopping: %s, last active WorkItem closing", _config.name);
@@ -128,24 +152,93 @@ void WorkQueue::Detach(WorkItem *item)
 
 void WorkQueue::Add(WorkItem *item)
 {
+#if defined(__PX4_NUTTX)
 	work_lock();
 
-#if defined(ENABLE_LOCKSTEP_SCHEDULER)
+#if defined(CONFIG_WORK_QUEUE_TIMING)
 
-	if (_lockstep_component == -1) {
-		_lockstep_component = px4_lockstep_register_component();
+	if (item->_release_time.load() == 0) {
+		item->SetReleaseTime(hrt_absolute_time());
 	}
 
-#endif // ENABLE_LOCKSTEP_SCHEDULER
+#endif /* CONFIG_WORK_QUEUE_TIMING */
 
 	_q.push(item);
 	work_unlock();
 
 	SignalWorkerThread();
+#else
+	bool queued = false;
+
+	// already queued and not run yet
+	if (!item->_queued.compare_exchange(&queued, true)) {
+		return;
+	}
+
+#if defined(CONFIG_WORK_QUEUE_TIMING)
+
+	if (item->_release_time.load() == 0) {
+		item->SetReleaseTime(hrt_absolute_time());
+	}
+
+#endif /* CONFIG_WORK_QUEUE_TIMING */
+
+#if defined(ENABLE_LOCKSTEP_SCHEDULER)
+	// the component has to be registered before the worker can see the item
+	RegisterLockstepComponent();
+#endif // ENABLE_LOCKSTEP_SCHEDULER
+
+	// only the push that makes the queue non-empty wakes the worker, it drains everything pushed after
+	if (_pending.push(item)) {
+		SignalWorkerThread();
+	}
+
+#endif // __PX4_NUTTX
+}
+
+#if defined(ENABLE_LOCKSTEP_SCHEDULER)
+void WorkQueue::RegisterLockstepComponent()
+{
+	if (_lockstep_component.load() == -1) {
+		const int component = px4_lockstep_register_component(get_name());
+		int none = -1;
+
+		if (!_lockstep_component.compare_exchange(&none, component)) {
+			// registered concurrently
+			px4_lockstep_unregister_component(component);
+		}
+	}
 }
+#endif // ENABLE_LOCKSTEP_SCHEDULER
 
 void WorkQueue::SignalWorkerThread()
 {
+#if defined(__PX4_LINUX)
+
+	if (_pool != nullptr) {
+		int state = _pool_state.load();
+
+		for (;;) {
+			if (state == POOL_IDLE) {
+				if (_pool_state.compare_exchange(&state, POOL_SCHEDULED)) {
+					_pool->Schedule(this);
+					return;
+				}
+
+			} else if (state == POOL_RUNNING) {
+				if (_pool_state.compare_exchange(&state, POOL_RUNNING_SIGNALLED)) {
+					return;
+				}
+
+			} else {
+				// already scheduled or signalled
+				return;
+			}
+		}
+	}
+
+#endif /* __PX4_LINUX */
+
 	int sem_val;
 
 	if (px4_sem_getvalue(&_process_lock, &sem_val) == 0 && sem_val <= 0) {
@@ -156,7 +249,18 @@ void WorkQueue::SignalWorkerThread()
 void WorkQueue::Remove(WorkItem *item)
 {
 	work_lock();
+
+#if defined(__PX4_NUTTX)
 	_q.remove(item);
+#else
+	_pending.drain(_q);
+
+	if (_q.remove(item)) {
+		item->_queued.store(false);
+	}
+
+#endif // __PX4_NUTTX
+
 	work_unlock();
 }
 
@@ -164,8 +268,16 @@ void WorkQueue::Clear()
 {
 	work_lock();
 
+#if !defined(__PX4_NUTTX)
+	_pending.drain(_q);
+#endif // !__PX4_NUTTX
+
 	while (!_q.empty()) {
+#if defined(__PX4_NUTTX)
 		_q.pop();
+#else
+		_q.pop()->_queued.store(false);
+#endif // __PX4_NUTTX
 	}
 
 	work_unlock();
@@ -177,38 +289,132 @@ void WorkQueue::Run()
 		// loop as the wait may be interrupted by a signal
 		do {} while (px4_sem_wait(&_process_lock) != 0);
 
-		work_lock();
+		ProcessQueue();
+	}
+
+	PX4_DEBUG("%s: exiting", _config.name);
+}
+
+#if defined(__PX4_LINUX)
+bool WorkQueue::RunPooled()
+{
+	_pool_state.store(POOL_RUNNING);
+
+	ProcessQueue();
+
+	if (should_exit()) {
+		PX4_DEBUG("%s: exiting", _config.name);
+		return false;
+	}
+
+	int state = POOL_RUNNING;
+
+	if (!_pool_state.compare_exchange(&state, POOL_IDLE)) {
+		// signalled while running, go to the back of the ready queue so other pooled queues get a turn
+		_pool_state.store(POOL_SCHEDULED);
+		_pool->Schedule(this);
+	}
+
+	return true;
+}
+#endif /* __PX4_LINUX */
+
+void WorkQueue::ProcessQueue()
+{
+	work_lock();
+
+#if !defined(__PX4_NUTTX)
+	_pending.drain(_q);
+#endif // !__PX4_NUTTX
 
-		// process queued work
-		while (!_q.empty()) {
-			WorkItem *work = _q.pop();
+	// process queued work
+	while (!_q.empty()) {
+		WorkItem *work = _q.pop();
+
+#if !defined(__PX4_NUTTX)
+		// Add() may queue it again from here on
+		work->_queued.store(false);
+#endif // !__PX4_NUTTX
+
+		_running = work;
+
+		work_unlock(); // unlock work queue to run (item may requeue itself)
+		work->RunPreamble();
+#if defined(CONFIG_ORB_GRAPH)
+		WorkItem::_current = work;
+#endif /* CONFIG_ORB_GRAPH */
+		work->Run();
+		// Note: after Run() we cannot access work anymore, as it might have been deleted
+#if defined(CONFIG_ORB_GRAPH)
+		WorkItem::_current = nullptr;
+#endif /* CONFIG_ORB_GRAPH */
+		work_lock(); // re-lock
+
+		if (_running == work) {
+			work->RunPostamble();
+			_running = nullptr;
+		}
+
+#if defined(__PX4_LINUX)
 
-			work_unlock(); // unlock work queue to run (item may requeue itself)
-			work->RunPreamble();
-			work->Run();
-			// Note: after Run() we cannot access work anymore, as it might have been deleted
-			work_lock(); // re-lock
+		// a pooled queue only runs what was queued when it started, anything newer signals another pass
+		if (pooled()) {
+			continue;
 		}
 
+#endif /* __PX4_LINUX */
+
+#if !defined(__PX4_NUTTX)
+		_pending.drain(_q);
+#endif // !__PX4_NUTTX
+	}
+
 #if defined(ENABLE_LOCKSTEP_SCHEDULER)
 
-		if (_q.empty()) {
-			px4_lockstep_unregister_component(_lockstep_component);
-			_lockstep_component = -1;
+	if (_q.empty() && _pending.empty()) {
+		int component = _lockstep_component.load();
+
+		if ((component != -1) && _lockstep_component.compare_exchange(&component, -1)) {
+			px4_lockstep_unregister_component(component);
 		}
 
+		// an Add() that found the component still registered may have pushed in the meantime,
+		// it already signalled the next pass, which unregisters again
+		if (!_pending.empty()) {
+			RegisterLockstepComponent();
+		}
+	}
+
 #endif // ENABLE_LOCKSTEP_SCHEDULER
 
-		work_unlock();
-	}
+	work_unlock();
+}
 
-	PX4_DEBUG("%s: exiting", _config.name);
+#if defined(CONFIG_WORK_QUEUE_TIMING)
+void WorkQueue::sample_timing(bool (*callback)(const char *wq_name, const char *item_name,
+				 const work_item_timing_t &timing, void *arg), void *arg)
+{
+	LockGuard lg{_work_items.mutex()};
+
+	for (WorkItem *item : _work_items) {
+		work_item_timing_t timing{};
+		const WorkItem::timing_window_t window = item->sample_timing(timing);
+
+		if (callback(get_name(), item->ItemName(), timing, arg)) {
+			item->reset_timing(window);
+		}
+	}
 }
+#endif /* CONFIG_WORK_QUEUE_TIMING */
 
 void WorkQueue::print_status(bool last)
 {
 	const size_t num_items = _work_items.size();
+#if defined(__PX4_LINUX)
+	PX4_INFO_RAW("%-16s%s\n", get_name(), pooled() ? " (pooled)" : "");
+#else
 	PX4_INFO_RAW("%-16s\n", get_name());
+#endif /* __PX4_LINUX */
 	unsigned i = 0;
 
 	for (WorkItem *item : _work_items) {
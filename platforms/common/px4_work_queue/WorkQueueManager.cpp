@@ -49,6 +49,10 @@
 #include <limits.h>
 #include <string.h>
 
+#if defined(CONFIG_WORK_QUEUE_POOL)
+#include "WorkQueuePool.hpp"
+#endif /* CONFIG_WORK_QUEUE_POOL */
+
 using namespace time_literals;
 
 namespace px4
@@ -63,6 +67,11 @@ static BlockingQueue<const wq_config_t *, 1> *_wq_manager_create_queue{nullptr};
 static px4::atomic_bool _wq_manager_should_exit{true};
 static px4::atomic_bool _wq_manager_running{false};
 
+#if defined(CONFIG_WORK_QUEUE_POOL)
+// worker threads shared by the pooled WorkQueues, started with the first one
+static WorkQueuePool *_wq_manager_pool{nullptr};
+#endif /* CONFIG_WORK_QUEUE_POOL */
+
 
 static WorkQueue *
 FindWorkQueueByName(const char *name)
@@ -254,6 +263,73 @@ WorkQueueRunner(int argc, char *argv[])
 }
 #endif
 
+#if defined(CONFIG_WORK_QUEUE_AFFINITY) || defined(CONFIG_WORK_QUEUE_POOL)
+/**
+ * Find a WorkQueue in a space separated list of name prefixes, each optionally followed by =value.
+ * @return the rest of the matching entry ("" or "=value"), nullptr if there's none
+ */
+static const char *
+MatchWorkQueue(const char *list, const char *name)
+{
+	const char *entry = list;
+
+	while (*entry != '\0') {
+		while (*entry == ' ') {
+			entry++;
+		}
+
+		const size_t prefix_length = strcspn(entry, " =");
+
+		if ((prefix_length > 0) && (strncmp(entry, name, prefix_length) == 0)) {
+			return entry + prefix_length;
+		}
+
+		entry += strcspn(entry, " ");
+	}
+
+	return nullptr;
+}
+#endif
+
+#if defined(CONFIG_WORK_QUEUE_POOL)
+static void
+WorkQueuePoolExited(WorkQueue *wq)
+{
+	_wq_manager_wqs_list->remove(wq);
+}
+
+static bool
+WorkQueueStartPooled(const wq_config_t *config, int sched_priority)
+{
+	if (_wq_manager_pool == nullptr) {
+		WorkQueuePool *pool = new WorkQueuePool(CONFIG_WORK_QUEUE_POOL_THREADS,
+							PX4_STACK_ADJUSTED(CONFIG_WORK_QUEUE_POOL_STACK_SIZE), WorkQueuePoolExited);
+
+		if ((pool == nullptr) || (pool->Start() == 0)) {
+			delete pool;
+			return false;
+		}
+
+		_wq_manager_pool = pool;
+	}
+
+	WorkQueue *wq = new WorkQueue(*config, _wq_manager_pool);
+
+	if (wq == nullptr) {
+		return false;
+	}
+
+	// the pool runs at the priority of its most important WorkQueue
+	_wq_manager_pool->RequirePriority(sched_priority);
+
+	_wq_manager_wqs_list->add(wq);
+
+	PX4_DEBUG("starting: %s, pooled, priority: %d", config->name, sched_priority);
+
+	return true;
+}
+#endif /* CONFIG_WORK_QUEUE_POOL */
+
 static int
 WorkQueueManagerRun(int, char **)
 {
@@ -282,6 +358,14 @@ WorkQueueManagerRun(int, char **)
 			// priority
 			int sched_priority = sched_get_priority_max(SCHED_FIFO) + wq->relative_priority;
 
+#if defined(CONFIG_WORK_QUEUE_POOL)
+
+			if (MatchWorkQueue(CONFIG_WORK_QUEUE_POOL_QUEUES, wq->name) && WorkQueueStartPooled(wq, sched_priority)) {
+				continue;
+			}
+
+#endif /* CONFIG_WORK_QUEUE_POOL */
+
 			// use pthreads for NuttX flat and posix builds. For NuttX protected build, use tasks or kernel threads
 #if !defined(__PX4_NUTTX) || defined(CONFIG_BUILD_FLAT)
 			pthread_attr_t attr;
@@ -319,10 +403,42 @@ WorkQueueManagerRun(int, char **)
 				PX4_ERR("setting sched params for %s failed (%i)", wq->name, ret_setschedparam);
 			}
 
+#if defined(__PX4_LINUX) && defined(CONFIG_WORK_QUEUE_AFFINITY)
+			// pin to a CPU, with the SCHED_FIFO priority applied instead of inherited
+			const char *affinity = MatchWorkQueue(CONFIG_WORK_QUEUE_AFFINITY, wq->name);
+			const int cpu = ((affinity != nullptr) && (affinity[0] == '=')) ? atoi(affinity + 1) : -1;
+
+			if (cpu >= 0) {
+				cpu_set_t cpuset;
+				CPU_ZERO(&cpuset);
+				CPU_SET(cpu, &cpuset);
+
+				int ret_setaffinity = pthread_attr_setaffinity_np(&attr, sizeof(cpuset), &cpuset);
+
+				if (ret_setaffinity != 0) {
+					PX4_ERR("setting CPU %d affinity for %s failed (%i)", cpu, wq->name, ret_setaffinity);
+				}
+
+				pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+			}
+
+#endif /* __PX4_LINUX && CONFIG_WORK_QUEUE_AFFINITY */
+
 			// create thread
 			pthread_t thread;
 			int ret_create = pthread_create(&thread, &attr, WorkQueueRunner, (void *)wq);
 
+#if defined(__PX4_LINUX) && defined(CONFIG_WORK_QUEUE_AFFINITY)
+
+			if ((ret_create == EPERM) && (cpu >= 0)) {
+				// no realtime privileges, keep the affinity but inherit the scheduling
+				PX4_WARN("%s: SCHED_FIFO not permitted", wq->name);
+				pthread_attr_setinheritsched(&attr, PTHREAD_INHERIT_SCHED);
+				ret_create = pthread_create(&thread, &attr, WorkQueueRunner, (void *)wq);
+			}
+
+#endif /* __PX4_LINUX && CONFIG_WORK_QUEUE_AFFINITY */
+
 			if (ret_create == 0) {
 				PX4_DEBUG("starting: %s, priority: %d, stack: %zu bytes", wq->name, param.sched_priority, stacksize);
 
@@ -441,6 +557,12 @@ WorkQueueManagerStop()
 			_wq_manager_wqs_list = nullptr;
 		}
 
+#if defined(CONFIG_WORK_QUEUE_POOL)
+		// all pooled WorkQueues are gone, stop the workers
+		delete _wq_manager_pool;
+		_wq_manager_pool = nullptr;
+#endif /* CONFIG_WORK_QUEUE_POOL */
+
 		_wq_manager_should_exit.store(true);
 
 		if (_wq_manager_create_queue != nullptr) {
@@ -461,6 +583,21 @@ WorkQueueManagerStop()
 	return PX4_OK;
 }
 
+#if defined(CONFIG_WORK_QUEUE_TIMING)
+void
+WorkQueueManagerTimingStats(bool (*callback)(const char *wq_name, const char *item_name,
+			    const work_item_timing_t &timing, void *arg), void *arg)
+{
+	if (!_wq_manager_should_exit.load() && _wq_manager_running.load()) {
+		LockGuard lg{_wq_manager_wqs_list->mutex()};
+
+		for (WorkQueue *wq : *_wq_manager_wqs_list) {
+			wq->sample_timing(callback, arg);
+		}
+	}
+}
+#endif /* CONFIG_WORK_QUEUE_TIMING */
+
 int
 WorkQueueManagerStatus()
 {
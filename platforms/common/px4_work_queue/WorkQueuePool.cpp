@@ -0,0 +1,273 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "WorkQueuePool.hpp"
+
+#if defined(__PX4_LINUX)
+
+#include <px4_platform_common/px4_work_queue/WorkQueue.hpp>
+#include <px4_platform_common/log.h>
+
+#include <limits.h>
+#include <sched.h>
+#include <string.h>
+#include <unistd.h>
+
+namespace px4
+{
+
+WorkQueuePool::WorkQueuePool(int threads, size_t stacksize, void (*exited)(WorkQueue *wq)) :
+	_threads((threads < 1) ? 1 : ((threads > MAX_THREADS) ? MAX_THREADS : threads)),
+	_stacksize(stacksize),
+	_exited(exited)
+{
+	for (int i = 0; i < MAX_THREADS; i++) {
+		_workers[i].pool = this;
+		_workers[i].index = i;
+
+		px4_sem_init(&_workers[i].wakeup, 0, 0);
+		px4_sem_setprotocol(&_workers[i].wakeup, SEM_PRIO_NONE);
+
+		pthread_mutex_init(&_workers[i].mutex, nullptr);
+	}
+}
+
+WorkQueuePool::~WorkQueuePool()
+{
+	_should_exit.store(true);
+
+	for (int i = 0; i < MAX_THREADS; i++) {
+		if (_workers[i].running) {
+			px4_sem_post(&_workers[i].wakeup);
+			pthread_join(_workers[i].thread, nullptr);
+		}
+
+		px4_sem_destroy(&_workers[i].wakeup);
+		pthread_mutex_destroy(&_workers[i].mutex);
+	}
+}
+
+int WorkQueuePool::Start()
+{
+	// the desired stacksize rounded up to a multiple of the page size, required by pthread_attr_setstacksize
+	const size_t page_size = sysconf(_SC_PAGESIZE);
+	const size_t stacksize_min = (_stacksize > (size_t)PTHREAD_STACK_MIN) ? _stacksize : (size_t)PTHREAD_STACK_MIN;
+	const size_t stacksize = stacksize_min + page_size - (stacksize_min % page_size);
+
+	int running = 0;
+
+	for (int i = 0; i < _threads; i++) {
+		Worker &worker = _workers[i];
+
+		if (worker.running) {
+			running++;
+			continue;
+		}
+
+		pthread_attr_t attr;
+		pthread_attr_init(&attr);
+
+		int ret_setstacksize = pthread_attr_setstacksize(&attr, stacksize);
+
+		if (ret_setstacksize != 0) {
+			PX4_ERR("setting stack size for wq:pool%d failed (%i)", i, ret_setstacksize);
+		}
+
+		int ret_create = pthread_create(&worker.thread, &attr, WorkerRun, &worker);
+		pthread_attr_destroy(&attr);
+
+		if (ret_create == 0) {
+			char name[16];
+			snprintf(name, sizeof(name), "wq:pool%d", i);
+			pthread_setname_np(worker.thread, name);
+
+			worker.running = true;
+			running++;
+
+		} else {
+			PX4_ERR("failed to create thread for wq:pool%d (%i): %s", i, ret_create, strerror(ret_create));
+		}
+	}
+
+	return running;
+}
+
+void WorkQueuePool::RequirePriority(int sched_priority)
+{
+	int current = _sched_priority.load();
+
+	while (sched_priority > current) {
+		if (_sched_priority.compare_exchange(&current, sched_priority)) {
+			sched_param param{};
+			param.sched_priority = sched_priority;
+
+			for (int i = 0; i < _threads; i++) {
+				if (_workers[i].running) {
+					int ret = pthread_setschedparam(_workers[i].thread, SCHED_FIFO, &param);
+
+					if (ret != 0) {
+						// not permitted without realtime privileges
+						PX4_DEBUG("wq:pool%d priority %d failed (%i)", i, sched_priority, ret);
+					}
+				}
+			}
+
+			return;
+		}
+	}
+}
+
+void WorkQueuePool::Schedule(WorkQueue *wq)
+{
+	// prefer the worker that ran it last, it probably still has it in cache
+	Worker &worker = _workers[wq->_pool_worker.load()];
+
+	if (!Push(worker, wq)) {
+		// can't happen, there are fewer pooled WorkQueues than ready slots
+		PX4_ERR("%s: pool full", wq->get_name());
+		return;
+	}
+
+	if (worker.idle.load()) {
+		px4_sem_post(&worker.wakeup);
+		return;
+	}
+
+	// busy, let an idle worker steal it
+	for (int i = 0; i < _threads; i++) {
+		if (_workers[i].idle.load()) {
+			px4_sem_post(&_workers[i].wakeup);
+			return;
+		}
+	}
+
+	// all busy, the next worker to finish picks it up
+}
+
+void *WorkQueuePool::WorkerRun(void *arg)
+{
+	Worker *worker = static_cast<Worker *>(arg);
+	worker->pool->Run(*worker);
+	return nullptr;
+}
+
+void WorkQueuePool::Run(Worker &worker)
+{
+	while (!_should_exit.load()) {
+		WorkQueue *wq = Pop(worker);
+
+		if (wq == nullptr) {
+			wq = Steal(worker);
+		}
+
+		if (wq == nullptr) {
+			worker.idle.store(true);
+
+			// check again, Schedule() might have missed the idle flag
+			wq = Pop(worker);
+
+			if (wq == nullptr) {
+				wq = Steal(worker);
+			}
+
+			if (wq == nullptr) {
+				// loop as the wait may be interrupted by a signal
+				do {} while (px4_sem_wait(&worker.wakeup) != 0);
+
+				worker.idle.store(false);
+				continue;
+			}
+
+			worker.idle.store(false);
+		}
+
+		wq->_pool_worker.store(worker.index);
+
+		if (!wq->RunPooled()) {
+			_exited(wq);
+			delete wq;
+		}
+	}
+}
+
+bool WorkQueuePool::Push(Worker &worker, WorkQueue *wq)
+{
+	bool ret = false;
+
+	pthread_mutex_lock(&worker.mutex);
+
+	if (worker.count < MAX_READY) {
+		worker.ready[(worker.head + worker.count) % MAX_READY] = wq;
+		worker.count++;
+		ret = true;
+	}
+
+	pthread_mutex_unlock(&worker.mutex);
+
+	return ret;
+}
+
+WorkQueue *WorkQueuePool::Pop(Worker &worker)
+{
+	WorkQueue *wq = nullptr;
+
+	pthread_mutex_lock(&worker.mutex);
+
+	if (worker.count > 0) {
+		wq = worker.ready[worker.head];
+		worker.head = (worker.head + 1) % MAX_READY;
+		worker.count--;
+	}
+
+	pthread_mutex_unlock(&worker.mutex);
+
+	return wq;
+}
+
+WorkQueue *WorkQueuePool::Steal(Worker &thief)
+{
+	for (int i = 1; i < _threads; i++) {
+		WorkQueue *wq = Pop(_workers[(thief.index + i) % _threads]);
+
+		if (wq != nullptr) {
+			return wq;
+		}
+	}
+
+	return nullptr;
+}
+
+} // namespace px4
+
+#endif /* __PX4_LINUX */
@@ -0,0 +1,126 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#pragma once
+
+#include <px4_platform_common/atomic.h>
+#include <px4_platform_common/sem.h>
+
+#include <pthread.h>
+
+namespace px4
+{
+
+class WorkQueue;
+
+/**
+ * Worker threads shared by WorkQueues that are rarely active (Linux only).
+ *
+ * A scheduled WorkQueue is handed to the worker that ran it last. Idle
+ * workers steal from the others, so one WorkQueue that runs long does not
+ * hold up the rest. A WorkQueue only ever runs on one worker at a time.
+ */
+class WorkQueuePool
+{
+public:
+	/**
+	 * @param threads number of worker threads
+	 * @param stacksize worker stack size
+	 * @param exited called by the worker when a WorkQueue stopped, before it's deleted
+	 */
+	WorkQueuePool(int threads, size_t stacksize, void (*exited)(WorkQueue *wq));
+	~WorkQueuePool();
+
+	// no copy, assignment, move, move assignment
+	WorkQueuePool(const WorkQueuePool &) = delete;
+	WorkQueuePool &operator=(const WorkQueuePool &) = delete;
+	WorkQueuePool(WorkQueuePool &&) = delete;
+	WorkQueuePool &operator=(WorkQueuePool &&) = delete;
+
+	/**
+	 * Start the worker threads.
+	 * @return number of workers running
+	 */
+	int Start();
+
+	/**
+	 * Raise the worker priority to at least sched_priority (SCHED_FIFO).
+	 */
+	void RequirePriority(int sched_priority);
+
+	/**
+	 * Queue a WorkQueue that has work to run.
+	 */
+	void Schedule(WorkQueue *wq);
+
+	int threads() const { return _threads; }
+
+private:
+
+	static constexpr int MAX_THREADS = 8;
+	static constexpr int MAX_READY = 32; // per worker, more than there are WorkQueues to pool
+
+	struct Worker {
+		WorkQueuePool *pool{nullptr};
+		int index{0};
+		pthread_t thread{};
+		bool running{false};
+		px4_sem_t wakeup;
+		pthread_mutex_t mutex;
+		px4::atomic_bool idle{false};
+
+		// ring of scheduled WorkQueues
+		WorkQueue *ready[MAX_READY] {};
+		int head{0};
+		int count{0};
+	};
+
+	static void *WorkerRun(void *arg);
+
+	void Run(Worker &worker);
+
+	bool Push(Worker &worker, WorkQueue *wq);
+	WorkQueue *Pop(Worker &worker);
+	WorkQueue *Steal(Worker &thief);
+
+	Worker _workers[MAX_THREADS];
+	const int _threads;
+	const size_t _stacksize;
+	void (*_exited)(WorkQueue *wq);
+
+	px4::atomic_bool _should_exit{false};
+	px4::atomic<int> _sched_priority{0};
+};
+
+} // namespace px4
@@ -38,6 +38,8 @@
 
 #pragma once
 
+#include <stdlib.h>
+
 #include <px4_platform_common/defines.h>
 #include <systemlib/err.h>
 
@@ -58,12 +60,46 @@ public:
 
 	orb_id_t get_topic() const { return get_orb_meta(_orb_id); }
 
+	/**
+	 * Publish the message returned by loan().
+	 */
+	bool publish_loaned()
+	{
+		void *loan = _loan;
+		_loan = nullptr;
+
+		if (loan == nullptr) {
+			return false;
+		}
+
+		if (loan == _loan_buffer) {
+			return (Manager::orb_publish(get_topic(), _handle, loan) == PX4_OK);
+		}
+
+		return (Manager::orb_publish_loaned(get_topic(), _handle, loan) == PX4_OK);
+	}
+
+	/**
+	 * Drop the message returned by loan() without publishing it.
+	 */
+	void return_loan()
+	{
+		if (_loan != nullptr && _loan != _loan_buffer) {
+			Manager::orb_return_loan(_handle, _loan);
+		}
+
+		_loan = nullptr;
+	}
+
 protected:
 
 	PublicationBase(ORB_ID id) : _orb_id(id) {}
 
 	~PublicationBase()
 	{
+		return_loan();
+		free(_loan_buffer);
+
 		if (_handle != nullptr) {
 			// don't automatically unadvertise queued publications (eg vehicle_command)
 			if (Manager::orb_get_queue_size(_handle) == 1) {
@@ -72,8 +108,32 @@ protected:
 		}
 	}
 
+	/**
+	 * Lend the slot of the next message, or a buffer of the publication if the topic can't lend.
+	 * Call after advertising.
+	 */
+	void *loan(size_t size)
+	{
+		return_loan();
+
+		_loan = Manager::orb_loan(_handle);
+
+		if (_loan == nullptr) {
+			if (_loan_buffer == nullptr) {
+				_loan_buffer = malloc(size);
+			}
+
+			_loan = _loan_buffer;
+		}
+
+		return _loan;
+	}
+
 	orb_advert_t _handle{nullptr};
 	const ORB_ID _orb_id;
+
+	void *_loan{nullptr};        ///< message being filled by the publisher
+	void *_loan_buffer{nullptr}; ///< used instead of a lent slot if the topic can't lend
 };
 
 /**
@@ -113,6 +173,22 @@ public:
 
 		return (Manager::orb_publish(get_topic(), _handle, &data) == PX4_OK);
 	}
+
+	/**
+	 * Get the next message to fill in place, instead of filling a struct that publish() copies.
+	 * The message holds old data, every field has to be written before publish_loaned().
+	 * The topic must have a single publisher. Loans are zero-copy only if the topic was not
+	 * published with publish() before, otherwise they are copied on publish_loaned().
+	 * @return the message, or nullptr if out of memory
+	 */
+	T *loan()
+	{
+		if (!advertised()) {
+			advertise();
+		}
+
+		return static_cast<T *>(PublicationBase::loan(sizeof(T)));
+	}
 };
 
 /**
@@ -92,6 +92,18 @@ public:
 		return (orb_publish(get_topic(), _handle, &data) == PX4_OK);
 	}
 
+	/**
+	 * Get the next message to fill in place, see Publication::loan().
+	 */
+	T *loan()
+	{
+		if (!advertised()) {
+			advertise();
+		}
+
+		return static_cast<T *>(PublicationBase::loan(sizeof(T)));
+	}
+
 	int get_instance()
 	{
 		// advertise if not already advertised
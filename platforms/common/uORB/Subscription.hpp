@@ -144,7 +144,7 @@ public:
 	bool update(void *dst)
 	{
 		if (subscribe()) {
-			return Manager::orb_data_copy(_node, dst, _last_generation, true);
+			return Manager::orb_data_copy(_node, dst, _last_generation, true, _callback);
 		}
 
 		return false;
@@ -157,12 +157,36 @@ public:
 	bool copy(void *dst)
 	{
 		if (subscribe()) {
-			return Manager::orb_data_copy(_node, dst, _last_generation, false);
+			return Manager::orb_data_copy(_node, dst, _last_generation, false, _callback);
 		}
 
 		return false;
 	}
 
+	/**
+	 * Borrow the next message instead of copying it.
+	 * The message stays in the queue of the topic: check borrow_valid() once done reading it, and
+	 * discard what was read if a publication overwrote it in the meantime.
+	 * Always nullptr in the NuttX protected build, where the queue is in kernel memory.
+	 * @return the message, or nullptr if there is no update
+	 */
+	const void *borrow()
+	{
+		if (subscribe()) {
+			return Manager::orb_data_borrow(_node, _last_generation, _borrowed_generation);
+		}
+
+		return nullptr;
+	}
+
+	/**
+	 * Check that the message returned by the last borrow() was not overwritten.
+	 */
+	bool borrow_valid() const
+	{
+		return (_node != nullptr) && Manager::orb_borrow_valid(_node, _borrowed_generation);
+	}
+
 	/**
 	 * Change subscription instance
 	 * @param instance The new multi-Subscription instance
@@ -185,9 +209,12 @@ protected:
 	void *_node{nullptr};
 
 	unsigned _last_generation{0}; /**< last generation the subscriber has seen */
+	unsigned _borrowed_generation{0}; /**< generation of the last borrowed message */
 
 	ORB_ID _orb_id{ORB_ID::INVALID};
 	uint8_t _instance{0};
+
+	bool _callback{false}; /**< registered for callbacks, only used for the latency histograms */
 };
 
 // Subscription wrapper class with data
@@ -72,6 +72,7 @@ public:
 			if (_subscription.get_node() && Manager::register_callback(_subscription.get_node(), this)) {
 				// registered
 				_registered = true;
+				_subscription._callback = true;
 
 			} else {
 				// force topic creation by subscribing with old API
@@ -81,6 +82,7 @@ public:
 				if (_subscription.subscribe()) {
 					if (_subscription.get_node() && Manager::register_callback(_subscription.get_node(), this)) {
 						_registered = true;
+						_subscription._callback = true;
 					}
 				}
 
@@ -98,6 +100,7 @@ public:
 		}
 
 		_registered = false;
+		_subscription._callback = false;
 	}
 
 	/**
@@ -133,6 +136,11 @@ public:
 
 	virtual void call() = 0;
 
+	/**
+	 * @return the WorkItem scheduled by the callback, if any
+	 */
+	virtual px4::WorkItem *work_item() const { return nullptr; }
+
 	bool registered() const { return _registered; }
 
 protected:
@@ -171,6 +179,8 @@ public:
 		}
 	}
 
+	px4::WorkItem *work_item() const override { return _work_item; }
+
 	/**
 	 * Optionally limit callback until more samples are available.
 	 *
@@ -0,0 +1,153 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * Test for WorkItem callbacks scheduled by a publication
+ */
+
+#include <gtest/gtest.h>
+#include <px4_platform_common/atomic.h>
+#include <px4_platform_common/px4_work_queue/WorkItem.hpp>
+#include <px4_platform_common/px4_work_queue/WorkQueueManager.hpp>
+#include <uORB/Publication.hpp>
+#include <uORB/SubscriptionCallback.hpp>
+#include <uORB/topics/orb_test_medium.h>
+
+#include <unistd.h>
+
+class CallbackWorker : public px4::WorkItem
+{
+public:
+	explicit CallbackWorker(const px4::wq_config_t &config) : px4::WorkItem("callback_worker", config) {}
+
+	void Run() override
+	{
+		orb_test_medium_s message;
+
+		if (sub.update(&message)) {
+			runs.fetch_add(1);
+		}
+	}
+
+	uORB::SubscriptionCallbackWorkItem sub{this, ORB_ID(orb_test_medium)};
+	px4::atomic<int> runs{0};
+};
+
+class uORBCallbackTest : public ::testing::Test
+{
+protected:
+	static void SetUpTestSuite()
+	{
+		uORB::Manager::initialize();
+		px4::WorkQueueManagerStart();
+	}
+
+	// wait for the WorkQueues to catch up
+	static bool wait_runs(CallbackWorker *workers[], int count, int runs)
+	{
+		for (int i = 0; i < 100; i++) {
+			bool done = true;
+
+			for (int j = 0; j < count; j++) {
+				done = done && (workers[j]->runs.load() >= runs);
+			}
+
+			if (done) {
+				return true;
+			}
+
+			usleep(10000);
+		}
+
+		return false;
+	}
+
+	uORB::Publication<orb_test_medium_s> _pub{ORB_ID(orb_test_medium)};
+};
+
+TEST_F(uORBCallbackTest, all_callbacks_on_a_work_queue_run)
+{
+	ASSERT_TRUE(_pub.advertise());
+
+	CallbackWorker a{px4::wq_configurations::test1};
+	CallbackWorker b{px4::wq_configurations::test1};
+	CallbackWorker c{px4::wq_configurations::test2};
+	CallbackWorker *workers[] {&a, &b, &c};
+
+	for (auto worker : workers) {
+		ASSERT_TRUE(worker->sub.registerCallback());
+	}
+
+	orb_test_medium_s message{};
+
+	for (int i = 1; i <= 3; i++) {
+		message.val = i;
+		ASSERT_TRUE(_pub.publish(message));
+		EXPECT_TRUE(wait_runs(workers, 3, i));
+	}
+
+	for (auto worker : workers) {
+		EXPECT_EQ(worker->runs.load(), 3);
+		worker->sub.unregisterCallback();
+	}
+}
+
+TEST_F(uORBCallbackTest, unregistered_callback_is_not_called)
+{
+	ASSERT_TRUE(_pub.advertise());
+
+	CallbackWorker a{px4::wq_configurations::test1};
+	CallbackWorker b{px4::wq_configurations::test1};
+	CallbackWorker *workers[] {&a, &b};
+
+	ASSERT_TRUE(a.sub.registerCallback());
+	ASSERT_TRUE(b.sub.registerCallback());
+	b.sub.unregisterCallback();
+
+	orb_test_medium_s message{};
+	ASSERT_TRUE(_pub.publish(message));
+	EXPECT_TRUE(wait_runs(workers, 1, 1));
+	usleep(20000);
+	EXPECT_EQ(b.runs.load(), 0);
+
+	// registering again picks up the next publication
+	a.sub.unregisterCallback();
+	ASSERT_TRUE(b.sub.registerCallback());
+
+	ASSERT_TRUE(_pub.publish(message));
+	EXPECT_TRUE(wait_runs(&workers[1], 1, 1));
+	EXPECT_EQ(a.runs.load(), 1);
+
+	b.sub.unregisterCallback();
+}
@@ -0,0 +1,172 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * Test for the loan and borrow API
+ */
+
+#include <gtest/gtest.h>
+#include <uORB/Publication.hpp>
+#include <uORB/PublicationMulti.hpp>
+#include <uORB/Subscription.hpp>
+#include <uORB/topics/orb_test_large.h>
+#include <uORB/topics/orb_test_medium.h>
+
+namespace uORB
+{
+namespace test
+{
+
+class uORBLoanTest : public ::testing::Test
+{
+protected:
+	static void SetUpTestSuite()
+	{
+		uORB::Manager::initialize();
+	}
+
+	static void TearDownTestSuite()
+	{
+		uORB::Manager::terminate();
+	}
+};
+
+TEST_F(uORBLoanTest, LoanedMessageIsPublished)
+{
+	uORB::Publication<orb_test_large_s> pub{ORB_ID(orb_test_large)};
+	ASSERT_TRUE(pub.advertise());
+	uORB::Subscription sub{ORB_ID(orb_test_large)};
+	uORB::Subscription borrower{ORB_ID(orb_test_large)};
+
+	for (int i = 1; i <= 5; i++) {
+		orb_test_large_s *message = pub.loan();
+		ASSERT_NE(message, nullptr);
+		message->timestamp = i;
+		message->val = i * 10;
+		memset(message->junk, i, sizeof(message->junk));
+		ASSERT_TRUE(pub.publish_loaned());
+
+		orb_test_large_s copy{};
+		ASSERT_TRUE(sub.update(&copy));
+		EXPECT_EQ(copy.val, i * 10);
+		EXPECT_EQ(copy.junk[511], i);
+
+		const orb_test_large_s *borrowed = static_cast<const orb_test_large_s *>(borrower.borrow());
+		ASSERT_NE(borrowed, nullptr);
+		EXPECT_EQ(borrowed->val, i * 10);
+		EXPECT_TRUE(borrower.borrow_valid());
+	}
+
+	// a loan that is given back is not published
+	ASSERT_NE(pub.loan(), nullptr);
+	pub.return_loan();
+	EXPECT_FALSE(sub.updated());
+	EXPECT_FALSE(pub.publish_loaned());
+}
+
+TEST_F(uORBLoanTest, BorrowIsInvalidatedByOverwrite)
+{
+	uORB::Publication<orb_test_large_s> pub{ORB_ID(orb_test_large)};
+	ASSERT_TRUE(pub.advertise());
+	uORB::Subscription sub{ORB_ID(orb_test_large)};
+
+	orb_test_large_s *message = pub.loan();
+	ASSERT_NE(message, nullptr);
+	message->val = 1;
+	ASSERT_TRUE(pub.publish_loaned());
+
+	const orb_test_large_s *borrowed = static_cast<const orb_test_large_s *>(sub.borrow());
+	ASSERT_NE(borrowed, nullptr);
+	EXPECT_EQ(borrowed->val, 1);
+	EXPECT_TRUE(sub.borrow_valid());
+
+	// the next loan may overwrite the borrowed slot once another message is out
+	message = pub.loan();
+	ASSERT_NE(message, nullptr);
+	EXPECT_NE(static_cast<const void *>(message), static_cast<const void *>(borrowed));
+	message->val = 2;
+	ASSERT_TRUE(pub.publish_loaned());
+	EXPECT_FALSE(sub.borrow_valid());
+}
+
+TEST_F(uORBLoanTest, QueuedLoansKeepOrder)
+{
+	uORB::Publication<orb_test_medium_s> pub{ORB_ID(orb_test_medium_queue)};
+	ASSERT_TRUE(pub.advertise());
+	uORB::Subscription sub{ORB_ID(orb_test_medium_queue)};
+
+	for (int i = 0; i < 16; i++) {
+		orb_test_medium_s *message = pub.loan();
+		ASSERT_NE(message, nullptr);
+		*message = {};
+		message->val = i;
+		ASSERT_TRUE(pub.publish_loaned());
+	}
+
+	for (int i = 0; i < 16; i++) {
+		const orb_test_medium_s *borrowed = static_cast<const orb_test_medium_s *>(sub.borrow());
+		ASSERT_NE(borrowed, nullptr);
+		EXPECT_EQ(borrowed->val, i);
+		EXPECT_TRUE(sub.borrow_valid());
+	}
+
+	EXPECT_EQ(sub.borrow(), nullptr);
+}
+
+TEST_F(uORBLoanTest, CopiesWhenTopicCannotLend)
+{
+	uORB::PublicationMulti<orb_test_medium_s> pub{ORB_ID(orb_test_medium_multi)};
+	ASSERT_TRUE(pub.advertise());
+	uORB::Subscription sub{ORB_ID(orb_test_medium_multi)};
+
+	// the first publish() allocates the queue without spare slots
+	orb_test_medium_s data{};
+	data.val = 1;
+	ASSERT_TRUE(pub.publish(data));
+
+	orb_test_medium_s *message = pub.loan();
+	ASSERT_NE(message, nullptr);
+	*message = {};
+	message->val = 2;
+	ASSERT_TRUE(pub.publish_loaned());
+
+	orb_test_medium_s copy{};
+	ASSERT_TRUE(sub.update(&copy));
+	EXPECT_EQ(copy.val, 1);
+	ASSERT_TRUE(sub.update(&copy));
+	EXPECT_EQ(copy.val, 2);
+}
+
+} // namespace test
+} // namespace uORB
@@ -0,0 +1,134 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * Test for the topic queues in shared memory (ORB_SHM)
+ */
+
+#include <gtest/gtest.h>
+#include <uORB/Publication.hpp>
+#include <uORB/uORBSharedMemory.hpp>
+#include <uORB/topics/orb_test_large.h>
+#include <uORB/topics/orb_test_medium.h>
+
+namespace uORB
+{
+namespace test
+{
+
+class uORBSharedMemoryTest : public ::testing::Test
+{
+protected:
+	static void SetUpTestSuite()
+	{
+		uORB::Manager::initialize();
+	}
+
+	static void TearDownTestSuite()
+	{
+		uORB::Manager::terminate();
+	}
+};
+
+TEST_F(uORBSharedMemoryTest, ReaderSeesPublications)
+{
+	uORB::Publication<orb_test_medium_s> pub{ORB_ID(orb_test_medium)};
+	orb_test_medium_s data{};
+	data.val = 1;
+	ASSERT_TRUE(pub.publish(data));
+
+	shm::TopicReader reader;
+	ASSERT_TRUE(reader.open("orb_test_medium", 0, pub.get_topic()->message_hash));
+	EXPECT_FALSE(reader.open("orb_test_medium", 0, pub.get_topic()->message_hash + 1));
+	ASSERT_TRUE(reader.open("orb_test_medium", 0, pub.get_topic()->message_hash));
+	EXPECT_EQ(reader.size(), sizeof(orb_test_medium_s));
+
+	for (int i = 2; i <= 5; i++) {
+		orb_test_medium_s copy{};
+		EXPECT_TRUE(reader.copy(&copy));
+		EXPECT_EQ(copy.val, i - 1);
+		EXPECT_FALSE(reader.updated());
+
+		data.val = i;
+		ASSERT_TRUE(pub.publish(data));
+		EXPECT_TRUE(reader.updated());
+	}
+}
+
+TEST_F(uORBSharedMemoryTest, BorrowIsInvalidatedByOverwrite)
+{
+	uORB::Publication<orb_test_large_s> pub{ORB_ID(orb_test_large)};
+	ASSERT_TRUE(pub.advertise());
+
+	orb_test_large_s *message = pub.loan();
+	ASSERT_NE(message, nullptr);
+	message->val = 1;
+	ASSERT_TRUE(pub.publish_loaned());
+
+	shm::TopicReader reader;
+	ASSERT_TRUE(reader.open("orb_test_large"));
+
+	uint32_t generation = 0;
+	const orb_test_large_s *borrowed = static_cast<const orb_test_large_s *>(reader.borrow(generation));
+	ASSERT_NE(borrowed, nullptr);
+	EXPECT_EQ(borrowed->val, 1);
+	EXPECT_TRUE(reader.valid(generation));
+
+	// the two slots of the loaned queue: the next loan writes the other one
+	message = pub.loan();
+	ASSERT_NE(message, nullptr);
+	EXPECT_TRUE(reader.valid(generation));
+	message->val = 2;
+	ASSERT_TRUE(pub.publish_loaned());
+	EXPECT_TRUE(reader.valid(generation));
+
+	// and the one after overwrites the borrowed message
+	message = pub.loan();
+	ASSERT_NE(message, nullptr);
+	EXPECT_FALSE(reader.valid(generation));
+	pub.return_loan();
+}
+
+TEST_F(uORBSharedMemoryTest, TopicsAreReadOnly)
+{
+	uORB::Publication<orb_test_medium_s> pub{ORB_ID(orb_test_medium)};
+	ASSERT_TRUE(pub.publish(orb_test_medium_s{}));
+
+	// only the topics in ORB_SHM_WRITABLE have an inbox
+	shm::TopicWriter writer;
+	EXPECT_FALSE(writer.open("orb_test_medium"));
+}
+
+} // namespace test
+} // namespace uORB
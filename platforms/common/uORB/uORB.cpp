@@ -51,6 +51,10 @@
 #include <sys/boardctl.h>
 #endif
 
+#ifdef CONFIG_ORB_SHM
+#include "uORBSharedMemory.hpp"
+#endif /* CONFIG_ORB_SHM */
+
 static uORB::DeviceMaster *g_dev = nullptr;
 
 int uorb_start(void)
@@ -76,6 +80,14 @@ int uorb_start(void)
 
 #endif
 
+#ifdef CONFIG_ORB_SHM
+
+	if (uORB::SharedMemory::start() != PX4_OK) {
+		PX4_ERR("shared memory inbox failed");
+	}
+
+#endif /* CONFIG_ORB_SHM */
+
 	return OK;
 }
 
@@ -113,6 +125,42 @@ int uorb_top(char **topic_filter, int num_filters)
 	return OK;
 }
 
+int uorb_graph(const char *source, const char *sink, bool json, uint32_t interval_us)
+{
+#if !defined(CONFIG_ORB_GRAPH)
+	PX4_INFO("graph not built, enable ORB_GRAPH");
+#else
+
+	if (g_dev != nullptr) {
+		g_dev->showGraph(source, sink, json, interval_us);
+
+	} else {
+		PX4_INFO("uorb is not running");
+	}
+
+#endif
+	return OK;
+}
+
+int uorb_latency(char **topic_filter, int num_filters, bool reset)
+{
+#if !defined(CONFIG_ORB_LATENCY)
+	PX4_INFO("latency histograms not built, enable ORB_LATENCY");
+#elif !defined(__PX4_NUTTX) || defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+
+	if (g_dev != nullptr) {
+		g_dev->showLatency(topic_filter, num_filters, reset);
+
+	} else {
+		PX4_INFO("uorb is not running");
+	}
+
+#else
+	boardctl(ORBIOCDEVMASTERCMD, ORB_DEVMASTER_LATENCY);
+#endif
+	return OK;
+}
+
 orb_advert_t orb_advertise(const struct orb_metadata *meta, const void *data)
 {
 	return uORB::Manager::get_instance()->orb_advertise(meta, data);
@@ -121,6 +121,8 @@ __BEGIN_DECLS
 int uorb_start(void);
 int uorb_status(void);
 int uorb_top(char **topic_filter, int num_filters);
+int uorb_latency(char **topic_filter, int num_filters, bool reset);
+int uorb_graph(const char *source, const char *sink, bool json, uint32_t interval_us);
 
 /**
  * ORB topic advertiser handle.
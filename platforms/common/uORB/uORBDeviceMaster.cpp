@@ -39,6 +39,15 @@
 #include <px4_platform_common/sem.hpp>
 #include <systemlib/px4_macros.h>
 
+#ifdef CONFIG_ORB_LATENCY
+#include "Publication.hpp"
+#include <uORB/topics/orb_latency.h>
+#endif /* CONFIG_ORB_LATENCY */
+
+#ifdef CONFIG_ORB_GRAPH
+#include "uORBGraph.hpp"
+#endif /* CONFIG_ORB_GRAPH */
+
 #include <math.h>
 
 #ifndef __PX4_QURT // QuRT has no poll()
@@ -431,6 +440,117 @@ void uORB::DeviceMaster::showTop(char **topic_filter, int num_filters)
 
 #undef CLEAR_LINE
 
+#ifdef CONFIG_ORB_LATENCY
+void uORB::DeviceMaster::showLatency(char **topic_filter, int num_filters, bool reset)
+{
+	static_assert(orb_latency_s::LATENCY_BINS == DeviceNode::LATENCY_BINS, "latency bins mismatch");
+
+	lock();
+	DeviceNodeStatisticsData *first_node = nullptr;
+	size_t max_topic_name_length = 0;
+	int num_topics = 0;
+	int ret = addNewDeviceNodes(&first_node, num_topics, max_topic_name_length, topic_filter, num_filters);
+	unlock();
+
+	if (ret != 0) {
+		PX4_ERR("addNewDeviceNodes failed (%i)", ret);
+	}
+
+	uORB::Publication<orb_latency_s> orb_latency_pub{ORB_ID(orb_latency)};
+
+	PX4_INFO_RAW("%-*s INST         ", (int)max_topic_name_length - 2, "TOPIC NAME");
+
+	for (int bin = 1; bin < DeviceNode::LATENCY_BINS; bin++) {
+		// upper bound of the bin in us
+		char label[8];
+		const unsigned bound = 2u << (bin - 1);
+		snprintf(label, sizeof(label), (bound < 1024) ? "<%u" : "<%uk", (bound < 1024) ? bound : bound / 1024);
+		PX4_INFO_RAW(" %5s", label);
+	}
+
+	PX4_INFO_RAW("  more   max(us)\n");
+
+	DeviceNodeStatisticsData *cur_node = first_node;
+
+	while (cur_node) {
+		DeviceNode *node = cur_node->node;
+		DeviceNode::Latency latency;
+		node->get_latency(latency, reset);
+
+		uint32_t callback_count = 0;
+		uint32_t copy_count = 0;
+
+		for (int bin = 0; bin < DeviceNode::LATENCY_BINS; bin++) {
+			callback_count += latency.callback[bin];
+			copy_count += latency.copy[bin];
+		}
+
+		if (callback_count > 0 || copy_count > 0) {
+			for (int row = 0; row < 2; row++) {
+				const uint32_t *histogram = (row == 0) ? latency.callback : latency.copy;
+
+				if (row == 0) {
+					PX4_INFO_RAW("%-*s %2i callback", (int)max_topic_name_length, node->get_meta()->o_name,
+						     (int)node->get_instance());
+
+				} else {
+					PX4_INFO_RAW("%-*s    copy    ", (int)max_topic_name_length, "");
+				}
+
+				for (int bin = 0; bin < DeviceNode::LATENCY_BINS; bin++) {
+					PX4_INFO_RAW(" %5u", (unsigned)histogram[bin]);
+				}
+
+				PX4_INFO_RAW(" %9u\n", (unsigned)((row == 0) ? latency.callback_max : latency.copy_max));
+			}
+
+			orb_latency_s report{};
+			strncpy(report.topic_name, node->get_meta()->o_name, sizeof(report.topic_name) - 1);
+			report.instance = node->get_instance();
+			memcpy(report.callback_latency, latency.callback, sizeof(report.callback_latency));
+			memcpy(report.copy_latency, latency.copy, sizeof(report.copy_latency));
+			report.callback_latency_max = latency.callback_max;
+			report.copy_latency_max = latency.copy_max;
+			report.timestamp = hrt_absolute_time();
+			orb_latency_pub.publish(report);
+		}
+
+		DeviceNodeStatisticsData *prev = cur_node;
+		cur_node = cur_node->next;
+		delete prev;
+	}
+}
+#endif /* CONFIG_ORB_LATENCY */
+
+#ifdef CONFIG_ORB_GRAPH
+void uORB::DeviceMaster::showGraph(const char *source, const char *sink, bool json, uint32_t interval_us)
+{
+	lock();
+
+	const int num_nodes = _node_list.size();
+	DeviceNode **nodes = new DeviceNode *[num_nodes];
+
+	if (nodes == nullptr) {
+		unlock();
+		PX4_ERR("alloc failed");
+		return;
+	}
+
+	int i = 0;
+
+	for (auto node : _node_list) {
+		nodes[i++] = node;
+	}
+
+	/* a DeviceNode is never deleted, so it's safe to unlock here and still access the DeviceNodes */
+	unlock();
+
+	Graph::show(nodes, num_nodes, source, sink, json, interval_us);
+
+	delete[] nodes;
+}
+#endif /* CONFIG_ORB_GRAPH */
+
 uORB::DeviceNode *uORB::DeviceMaster::getDeviceNode(const char *nodepath)
 {
 	lock();
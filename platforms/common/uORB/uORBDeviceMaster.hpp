@@ -115,6 +115,28 @@ public:
 	 */
 	void showTop(char **topic_filter, int num_filters);
 
+#ifdef CONFIG_ORB_LATENCY
+	/**
+	 * Print the latency histograms of the topics that were copied since the last reset,
+	 * and publish them as orb_latency.
+	 * @param topic_filter list of topic filters: if set, each string can be a substring for topics to match.
+	 * @param num_filters
+	 * @param reset clear the histograms after printing them
+	 */
+	void showLatency(char **topic_filter, int num_filters, bool reset);
+#endif /* CONFIG_ORB_LATENCY */
+
+#ifdef CONFIG_ORB_GRAPH
+	/**
+	 * Print the graph of publishers, topics and callback subscribers, see Graph::show().
+	 * @param source topic the critical path starts from
+	 * @param sink topic the critical path ends at
+	 * @param json print JSON instead of DOT
+	 * @param interval_us time to measure the rates
+	 */
+	void showGraph(const char *source, const char *sink, bool json, uint32_t interval_us);
+#endif /* CONFIG_ORB_GRAPH */
+
 private:
 	// Private constructor, uORB::Manager takes care of its creation
 	DeviceMaster();
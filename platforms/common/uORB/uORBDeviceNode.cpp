@@ -57,7 +57,21 @@ uORB::DeviceNode::DeviceNode(const struct orb_metadata *meta, const uint8_t inst
 
 uORB::DeviceNode::~DeviceNode()
 {
+#ifdef CONFIG_ORB_SHM
+
+	if (_shm) {
+		SharedMemory::unmap_topic(_meta, _instance, _shm);
+
+	} else {
+		free(_data);
+	}
+
+#else
 	free(_data);
+#endif /* CONFIG_ORB_SHM */
+#ifdef CONFIG_ORB_LATENCY
+	free(_publish_time);
+#endif /* CONFIG_ORB_LATENCY */
 
 	const char *devname = get_devname();
 
@@ -148,55 +162,185 @@ uORB::DeviceNode::write(cdev::file_t *filp, const char *buffer, size_t buflen)
 	 *
 	 * Note that filp will usually be NULL.
 	 */
-	if (nullptr == _data) {
+	if (nullptr == _data && !allocate(_meta->o_queue)) {
+		/* failed or could not allocate */
+		return -ENOMEM;
+	}
 
-#ifdef __PX4_NUTTX
+	/* If write size does not match, that is an error */
+	if (_meta->o_size != buflen) {
+		return -EIO;
+	}
 
-		if (!up_interrupt_context()) {
-#endif /* __PX4_NUTTX */
+	/* Perform an atomic copy. */
+	ATOMIC_ENTER;
+	/* wrap-around happens after ~49 days, assuming a publisher rate of 1 kHz */
+	unsigned generation = _generation.fetch_add(1);
 
-			lock();
+#ifdef CONFIG_ORB_SHM
 
-			/* re-check size */
-			if (nullptr == _data) {
-				const size_t data_size = _meta->o_size * _meta->o_queue;
-				_data = (uint8_t *) px4_cache_aligned_alloc(data_size);
+	if (_shm) {
+		SharedMemory::write_begin(_shm, generation);
+	}
 
-				if (_data) {
-					memset(_data, 0, data_size);
-				}
-			}
+#endif /* CONFIG_ORB_SHM */
 
-			unlock();
+	memcpy(_data + (_meta->o_size * (generation % _slots)), buffer, _meta->o_size);
+
+#ifdef CONFIG_ORB_SHM
+
+	if (_shm) {
+		SharedMemory::write_end(_shm, generation);
+	}
+
+#endif /* CONFIG_ORB_SHM */
+
+#ifdef CONFIG_ORB_LATENCY
+
+	if (_publish_time) {
+		_publish_time[generation % _slots] = hrt_absolute_time();
+	}
+
+#endif /* CONFIG_ORB_LATENCY */
+
+#ifdef CONFIG_ORB_GRAPH
+	record_publisher();
+#endif /* CONFIG_ORB_GRAPH */
+
+	notify_callbacks();
+
+	/* Mark at least one data has been published */
+	_data_valid = true;
+
+	ATOMIC_LEAVE;
+
+	/* notify any poll waiters */
+	poll_notify(POLLIN);
+
+	return _meta->o_size;
+}
 
+bool
+uORB::DeviceNode::allocate(uint16_t slots)
+{
+	/* no allocation from interrupt context */
 #ifdef __PX4_NUTTX
-		}
+
+	if (up_interrupt_context()) {
+		return _data != nullptr;
+	}
 
 #endif /* __PX4_NUTTX */
 
-		/* failed or could not allocate */
-		if (nullptr == _data) {
-			return -ENOMEM;
+	lock();
+
+	/* re-check size */
+	if (nullptr == _data) {
+		const size_t data_size = _meta->o_size * slots;
+#ifdef CONFIG_ORB_SHM
+		// falls back to the heap, the topic is not shared then
+		uint8_t *data = SharedMemory::map_topic(_meta, _instance, slots, &_shm);
+
+		if (data == nullptr) {
+			data = (uint8_t *) px4_cache_aligned_alloc(data_size);
+		}
+
+#else
+		uint8_t *data = (uint8_t *) px4_cache_aligned_alloc(data_size);
+#endif /* CONFIG_ORB_SHM */
+
+		if (data) {
+			memset(data, 0, data_size);
+
+#ifdef CONFIG_ORB_LATENCY
+			// optional, no histograms without it
+			_publish_time = (hrt_abstime *)calloc(slots, sizeof(hrt_abstime));
+#endif /* CONFIG_ORB_LATENCY */
+
+			// readers check _data only, the slot count has to be in place first
+			_slots = slots;
+			__atomic_thread_fence(__ATOMIC_SEQ_CST);
+			_data = data;
 		}
 	}
 
-	/* If write size does not match, that is an error */
-	if (_meta->o_size != buflen) {
-		return -EIO;
+	unlock();
+
+	return _data != nullptr;
+}
+
+void *
+uORB::DeviceNode::loan()
+{
+	bool expected = false;
+
+	if (!_loaned.compare_exchange(&expected, true)) {
+		return nullptr;
 	}
 
-	/* Perform an atomic copy. */
+	// a node allocated by write() keeps the slots subscribers read in use, it can't lend
+	if ((nullptr == _data && !allocate(2 * _meta->o_queue)) || _slots == _meta->o_queue) {
+		_loaned.store(false);
+		return nullptr;
+	}
+
+	_loan_generation = _generation.load();
+
+#ifdef CONFIG_ORB_SHM
+
+	if (_shm) {
+		// the publisher writes the slot from now on
+		SharedMemory::write_begin(_shm, _loan_generation);
+	}
+
+#endif /* CONFIG_ORB_SHM */
+
+	return _data + (_meta->o_size * (_loan_generation % _slots));
+}
+
+void
+uORB::DeviceNode::return_loan(void *slot)
+{
+	if (slot == _data + (_meta->o_size * (_loan_generation % _slots))) {
+		_loaned.store(false);
+	}
+}
+
+ssize_t
+uORB::DeviceNode::commit_loan(void *slot)
+{
 	ATOMIC_ENTER;
-	/* wrap-around happens after ~49 days, assuming a publisher rate of 1 kHz */
-	unsigned generation = _generation.fetch_add(1);
 
-	memcpy(_data + (_meta->o_size * (generation % _meta->o_queue)), buffer, _meta->o_size);
+	if (_generation.load() != _loan_generation || slot != _data + (_meta->o_size * (_loan_generation % _slots))) {
+		// another publisher took the slot in the meantime, the loaned message is dropped
+		ATOMIC_LEAVE;
+		return -EAGAIN;
+	}
 
-	// callbacks
-	for (auto item : _callbacks) {
-		item->call();
+	_generation.fetch_add(1);
+
+#ifdef CONFIG_ORB_SHM
+
+	if (_shm) {
+		SharedMemory::write_end(_shm, _loan_generation);
+	}
+
+#endif /* CONFIG_ORB_SHM */
+
+#ifdef CONFIG_ORB_LATENCY
+
+	if (_publish_time) {
+		_publish_time[_loan_generation % _slots] = hrt_absolute_time();
 	}
 
+#endif /* CONFIG_ORB_LATENCY */
+
+#ifdef CONFIG_ORB_GRAPH
+	record_publisher();
+#endif /* CONFIG_ORB_GRAPH */
+
+	notify_callbacks();
+
 	/* Mark at least one data has been published */
 	_data_valid = true;
 
@@ -208,6 +352,54 @@ uORB::DeviceNode::write(cdev::file_t *filp, const char *buffer, size_t buflen)
 	return _meta->o_size;
 }
 
+ssize_t
+uORB::DeviceNode::publish_loaned(const orb_metadata *meta, orb_advert_t handle, void *slot)
+{
+	uORB::DeviceNode *devnode = (uORB::DeviceNode *)handle;
+
+	/* check if the device handle is initialized and the slot is lent */
+	if ((devnode == nullptr) || (meta == nullptr) || (slot == nullptr) || !devnode->_loaned.load()) {
+		errno = EFAULT;
+		return PX4_ERROR;
+	}
+
+	/* check if the orb meta data matches the publication */
+	if (devnode->_meta->o_id != meta->o_id) {
+		errno = EINVAL;
+		return PX4_ERROR;
+	}
+
+	/* publish the slot in place of a write */
+	ssize_t ret = devnode->commit_loan(slot);
+
+	if (ret < 0) {
+		devnode->_loaned.store(false);
+		errno = -ret;
+		return PX4_ERROR;
+	}
+
+	ret = PX4_OK;
+
+#ifdef CONFIG_ORB_COMMUNICATOR
+	/*
+	 * send the data over the Multi-ORB link, before the slot can be lent again
+	 */
+	uORBCommunicator::IChannel *ch = uORB::Manager::get_instance()->get_uorb_communicator();
+
+	if (ch != nullptr) {
+		if (ch->send_message(meta->o_name, meta->o_size, (uint8_t *)slot) != 0) {
+			PX4_ERR("Error Sending [%s] topic data over comm_channel", meta->o_name);
+			ret = PX4_ERROR;
+		}
+	}
+
+#endif /* CONFIG_ORB_COMMUNICATOR */
+
+	devnode->_loaned.store(false);
+
+	return ret;
+}
+
 int
 uORB::DeviceNode::ioctl(cdev::file_t *filp, int cmd, unsigned long arg)
 {
@@ -414,7 +606,7 @@ int16_t uORB::DeviceNode::process_add_subscription()
 	if (_data != nullptr && ch != nullptr) { // _data will not be null if there is a publisher.
 		// Only send the most recent data to initialize the remote end.
 		if (_data_valid) {
-			ch->send_message(_meta->o_name, _meta->o_size, _data + (_meta->o_size * ((_generation.load() - 1) % _meta->o_queue)));
+			ch->send_message(_meta->o_name, _meta->o_size, _data + (_meta->o_size * ((_generation.load() - 1) % _slots)));
 		}
 	}
 
@@ -451,6 +643,37 @@ int16_t uORB::DeviceNode::process_received_message(int32_t length, uint8_t *data
 }
 #endif /* CONFIG_ORB_COMMUNICATOR */
 
+#ifdef CONFIG_ORB_LATENCY
+void uORB::DeviceNode::get_latency(Latency &latency, bool reset)
+{
+	ATOMIC_ENTER;
+	latency = _latency;
+
+	if (reset) {
+		_latency = {};
+	}
+
+	ATOMIC_LEAVE;
+}
+#endif /* CONFIG_ORB_LATENCY */
+
+#ifdef CONFIG_ORB_GRAPH
+void uORB::DeviceNode::get_graph(uint8_t publishers[Graph::PUBLISHERS_PER_TOPIC],
+				 void (*callback)(const px4::WorkItem &work_item, void *arg), void *arg)
+{
+	ATOMIC_ENTER;
+	memcpy(publishers, _publishers, sizeof(_publishers));
+
+	for (auto callback_sub : _callbacks) {
+		if (callback_sub->work_item()) {
+			callback(*callback_sub->work_item(), arg);
+		}
+	}
+
+	ATOMIC_LEAVE;
+}
+#endif /* CONFIG_ORB_GRAPH */
+
 unsigned uORB::DeviceNode::get_initial_generation()
 {
 	ATOMIC_ENTER;
@@ -463,6 +686,14 @@ unsigned uORB::DeviceNode::get_initial_generation()
 	return generation;
 }
 
+void
+uORB::DeviceNode::notify_callbacks()
+{
+	for (auto item : _callbacks) {
+		item->call();
+	}
+}
+
 bool
 uORB::DeviceNode::register_callback(uORB::SubscriptionCallback *callback_sub)
 {
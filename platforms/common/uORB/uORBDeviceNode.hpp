@@ -43,6 +43,19 @@
 #include <px4_platform_common/atomic.h>
 #include <px4_platform_common/px4_config.h>
 
+#ifdef CONFIG_ORB_LATENCY
+#include <drivers/drv_hrt.h>
+#endif /* CONFIG_ORB_LATENCY */
+
+#ifdef CONFIG_ORB_SHM
+#include "uORBSharedMemory.hpp"
+#endif /* CONFIG_ORB_SHM */
+
+#ifdef CONFIG_ORB_GRAPH
+#include "uORBGraph.hpp"
+#include <px4_platform_common/px4_work_queue/WorkItem.hpp>
+#endif /* CONFIG_ORB_GRAPH */
+
 namespace uORB
 {
 class DeviceNode;
@@ -123,6 +136,29 @@ public:
 
 	static int        unadvertise(orb_advert_t handle);
 
+	/**
+	 * Lend the slot the next publication is written to, so that the publisher can fill the
+	 * message in place instead of copying it.
+	 *
+	 * A node lends only if it was allocated by a loan, in which case it holds twice the queue
+	 * length of slots and the lent slot is never one a subscriber can read. Only one loan can be
+	 * outstanding, and the topic must have a single publisher while loans are used.
+	 * The slot holds an old message: every field has to be written.
+	 *
+	 * @return the slot, or nullptr if the node can't lend
+	 */
+	void *loan();
+
+	/**
+	 * Publish a slot returned by loan().
+	 */
+	static ssize_t    publish_loaned(const orb_metadata *meta, orb_advert_t handle, void *slot);
+
+	/**
+	 * Give back a slot returned by loan() without publishing it.
+	 */
+	void return_loan(void *slot);
+
 #ifdef CONFIG_ORB_COMMUNICATOR
 	/**
 	 * processes a request for topic advertisement from remote
@@ -211,6 +247,33 @@ public:
 
 	uint8_t get_instance() const { return _instance; }
 
+#ifdef CONFIG_ORB_LATENCY
+	static constexpr int LATENCY_BINS = 16; /**< log2 bins of microseconds, the last one also holds all above */
+
+	struct Latency {
+		uint32_t callback[LATENCY_BINS]; /**< publication to the copy by a callback subscriber */
+		uint32_t copy[LATENCY_BINS];     /**< publication to the copy by any other subscriber */
+		uint32_t callback_max;           /**< microseconds */
+		uint32_t copy_max;               /**< microseconds */
+	};
+
+	/**
+	 * Get the latency histograms.
+	 * @param reset clear the histograms after reading them
+	 */
+	void get_latency(Latency &latency, bool reset);
+#endif /* CONFIG_ORB_LATENCY */
+
+#ifdef CONFIG_ORB_GRAPH
+	/**
+	 * Get the publishers and the WorkItems called back, for uorb graph.
+	 * @param publishers set to the publisher ids (see Graph::publisher()), 0 if unused
+	 * @param callback called for each WorkItem, with the node locked
+	 */
+	void get_graph(uint8_t publishers[Graph::PUBLISHERS_PER_TOPIC],
+		       void (*callback)(const px4::WorkItem &work_item, void *arg), void *arg);
+#endif /* CONFIG_ORB_GRAPH */
+
 	/**
 	 * Copies data and the corresponding generation
 	 * from a node to the buffer provided.
@@ -219,22 +282,38 @@ public:
 	 *   The buffer into which the data is copied.
 	 * @param generation
 	 *   The generation that was copied.
+	 * @param callback
+	 *   The subscriber is called back on publications, only used for the latency histograms.
 	 * @return bool
 	 *   Returns true if the data was copied.
 	 */
-	bool copy(void *dst, unsigned &generation)
+	bool copy(void *dst, unsigned &generation, bool callback = false)
 	{
 		if ((dst != nullptr) && (_data != nullptr)) {
 			if (_meta->o_queue == 1) {
 				ATOMIC_ENTER;
-				memcpy(dst, _data, _meta->o_size);
+#ifdef CONFIG_ORB_LATENCY
+				const bool unseen = (generation != _generation.load());
+#endif /* CONFIG_ORB_LATENCY */
 				generation = _generation.load();
+				const unsigned slot = (generation - 1) % _slots;
+				memcpy(dst, _data + (_meta->o_size * slot), _meta->o_size);
+#ifdef CONFIG_ORB_LATENCY
+
+				if (unseen) {
+					record_latency(slot, callback);
+				}
+
+#endif /* CONFIG_ORB_LATENCY */
 				ATOMIC_LEAVE;
 				return true;
 
 			} else {
 				ATOMIC_ENTER;
 				const unsigned current_generation = _generation.load();
+#ifdef CONFIG_ORB_LATENCY
+				const bool unseen = (current_generation != generation);
+#endif /* CONFIG_ORB_LATENCY */
 
 				if (current_generation == generation) {
 					/* The subscriber already read the latest message, but nothing new was published yet.
@@ -249,7 +328,14 @@ public:
 					generation = current_generation - _meta->o_queue;
 				}
 
-				memcpy(dst, _data + (_meta->o_size * (generation % _meta->o_queue)), _meta->o_size);
+				memcpy(dst, _data + (_meta->o_size * (generation % _slots)), _meta->o_size);
+#ifdef CONFIG_ORB_LATENCY
+
+				if (unseen) {
+					record_latency(generation % _slots, callback);
+				}
+
+#endif /* CONFIG_ORB_LATENCY */
 				ATOMIC_LEAVE;
 
 				++generation;
@@ -262,6 +348,59 @@ public:
 
 	}
 
+	/**
+	 * Borrow the next message of a subscriber without copying it, see copy().
+	 *
+	 * The message stays in the queue and a later publication can overwrite it while it is read.
+	 * borrow_valid() tells once done reading if it did.
+	 *
+	 * @param generation
+	 *   The generation of the subscriber, advanced past the borrowed message.
+	 * @param borrowed
+	 *   The generation of the borrowed message.
+	 * @return the message, or nullptr if nothing was published yet
+	 */
+	const void *borrow(unsigned &generation, unsigned &borrowed)
+	{
+		if (_data == nullptr) {
+			return nullptr;
+		}
+
+		ATOMIC_ENTER;
+		const unsigned current_generation = _generation.load();
+
+		if (current_generation == generation) {
+			--generation;
+		}
+
+		if (!is_in_range(current_generation - _meta->o_queue, generation, current_generation - 1)) {
+			generation = current_generation - _meta->o_queue;
+		}
+
+		borrowed = generation;
+		const void *message = _data + (_meta->o_size * (generation % _slots));
+		ATOMIC_LEAVE;
+
+		++generation;
+
+		return message;
+	}
+
+	/**
+	 * Check that a borrowed message was not overwritten, after it was read.
+	 * @param borrowed The generation returned by borrow().
+	 */
+	bool borrow_valid(unsigned borrowed) const
+	{
+		// order the reads of the message before the generation check
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+		// a write() counts its generation before it overwrites the oldest slot, a loan lends it
+		// right after the previous publication
+		const unsigned window = (_slots == _meta->o_queue) ? _slots : _slots - 1;
+		return _generation.load() - borrowed <= window;
+	}
+
 	// add item to list of work items to schedule on node update
 	bool register_callback(SubscriptionCallback *callback_sub);
 
@@ -277,9 +416,82 @@ protected:
 private:
 	friend uORBTest::UnitTest;
 
+	/**
+	 * Allocate the object buffer with the given number of slots, if not done yet.
+	 * @return true if the buffer is allocated
+	 */
+	bool allocate(uint16_t slots);
+
+	// called with ATOMIC held
+	void notify_callbacks();
+
+	/**
+	 * Publish the lent slot, as write() does with a copy.
+	 * @return the message size, or -EAGAIN if another publication took the slot
+	 */
+	ssize_t commit_loan(void *slot);
+
 	const orb_metadata *_meta; /**< object metadata information */
 
 	uint8_t *_data{nullptr};   /**< allocated object buffer */
+	uint16_t _slots{1};        /**< slots of the object buffer, the queue length or twice that if allocated by a loan */
+	px4::atomic<bool> _loaned{false}; /**< a slot is lent to the publisher */
+	unsigned _loan_generation{0}; /**< generation the lent slot will be published as */
+
+#ifdef CONFIG_ORB_SHM
+	shm::TopicHeader *_shm{nullptr}; /**< segment of the object buffer, if it is shared */
+#endif /* CONFIG_ORB_SHM */
+
+#ifdef CONFIG_ORB_LATENCY
+	hrt_abstime *_publish_time{nullptr}; /**< publication time of each slot */
+	Latency _latency{};
+
+	// called with ATOMIC held
+	void record_latency(unsigned slot, bool callback)
+	{
+		if (_publish_time == nullptr || _publish_time[slot] == 0) {
+			return;
+		}
+
+		const hrt_abstime elapsed = hrt_absolute_time() - _publish_time[slot];
+		const uint32_t latency = (elapsed < UINT32_MAX) ? elapsed : UINT32_MAX;
+		int bin = (latency < 2) ? 0 : (31 - __builtin_clz(latency));
+
+		if (bin >= LATENCY_BINS) {
+			bin = LATENCY_BINS - 1;
+		}
+
+		if (callback) {
+			_latency.callback[bin]++;
+			_latency.callback_max = (latency > _latency.callback_max) ? latency : _latency.callback_max;
+
+		} else {
+			_latency.copy[bin]++;
+			_latency.copy_max = (latency > _latency.copy_max) ? latency : _latency.copy_max;
+		}
+	}
+#endif /* CONFIG_ORB_LATENCY */
+
+#ifdef CONFIG_ORB_GRAPH
+	uint8_t _publishers[Graph::PUBLISHERS_PER_TOPIC] {}; /**< ids of the publishers seen so far */
+
+	// called with ATOMIC held
+	void record_publisher()
+	{
+		const uint8_t publisher = Graph::current_publisher();
+
+		for (uint8_t &p : _publishers) {
+			if (p == publisher) {
+				return;
+			}
+
+			if (p == 0) {
+				p = publisher;
+				return;
+			}
+		}
+	}
+#endif /* CONFIG_ORB_GRAPH */
 	bool _data_valid{false}; /**< At least one valid data */
 	px4::atomic<unsigned>  _generation{0};  /**< object generation count */
 	List<uORB::SubscriptionCallback *>	_callbacks;
@@ -293,7 +505,7 @@ private:
 // Determine the data range
 	static inline bool is_in_range(unsigned left, unsigned value, unsigned right)
 	{
-		if (right > left) {
+		if (right >= left) {
 			return (left <= value) && (value <= right);
 
 		} else {  // Maybe the data overflowed and a wraparound occurred
@@ -0,0 +1,501 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "uORBGraph.hpp"
+#include "uORBDeviceNode.hpp"
+
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/posix.h>
+#include <px4_platform_common/tasks.h>
+#include <px4_platform_common/px4_work_queue/WorkItem.hpp>
+#include <px4_platform_common/px4_work_queue/WorkQueueManager.hpp>
+
+#include <pthread.h>
+#include <string.h>
+
+using namespace uORB;
+
+static pthread_mutex_t publishers_mutex = PTHREAD_MUTEX_INITIALIZER;
+static Graph::Publisher publishers[Graph::MAX_PUBLISHERS] {};
+static int num_publishers = 0;
+
+uint8_t Graph::current_publisher()
+{
+	// the last publishers of this thread, a WorkQueue thread runs several
+	struct Cached {
+		const px4::WorkItem *item;
+		uint8_t id;
+	};
+
+	static constexpr int CACHE_SIZE = 8;
+	static thread_local Cached cache[CACHE_SIZE] {};
+	static thread_local int cache_next = 0;
+	static thread_local uint32_t cache_deleted_count = 0;
+
+	const px4::WorkItem *item = px4::WorkItem::Current();
+
+	// a new WorkItem can take the address of a deleted one
+	const uint32_t deleted_count = px4::WorkItem::DeletedCount();
+
+	if (deleted_count != cache_deleted_count) {
+		for (Cached &cached : cache) {
+			cached = Cached{};
+		}
+
+		cache_deleted_count = deleted_count;
+	}
+
+	for (const Cached &cached : cache) {
+		if (cached.id != 0 && cached.item == item) {
+			return cached.id;
+		}
+	}
+
+	const char *name = (item != nullptr) ? item->ItemName() : px4_get_taskname();
+	const char *work_queue = (item != nullptr) ? item->WorkQueueName() : nullptr;
+
+	if (work_queue == nullptr) {
+		work_queue = "";
+	}
+
+	uint8_t id = 0;
+
+	pthread_mutex_lock(&publishers_mutex);
+
+	for (int i = 0; i < num_publishers; i++) {
+		if (strncmp(publishers[i].name, name, NAME_LENGTH - 1) == 0
+		    && strncmp(publishers[i].work_queue, work_queue, NAME_LENGTH - 1) == 0) {
+			id = i + 1;
+			break;
+		}
+	}
+
+	if (id == 0 && num_publishers < MAX_PUBLISHERS) {
+		strncpy(publishers[num_publishers].name, name, NAME_LENGTH - 1);
+		strncpy(publishers[num_publishers].work_queue, work_queue, NAME_LENGTH - 1);
+		id = ++num_publishers;
+	}
+
+	pthread_mutex_unlock(&publishers_mutex);
+
+	if (id != 0) {
+		cache[cache_next] = Cached{item, id};
+		cache_next = (cache_next + 1) % CACHE_SIZE;
+	}
+
+	return id;
+}
+
+const Graph::Publisher *Graph::publisher(uint8_t id)
+{
+	pthread_mutex_lock(&publishers_mutex);
+	const Publisher *p = (id > 0 && id <= num_publishers) ? &publishers[id - 1] : nullptr;
+	pthread_mutex_unlock(&publishers_mutex);
+	return p;
+}
+
+namespace
+{
+
+struct Vertex {
+	char name[Graph::NAME_LENGTH];
+	char work_queue[Graph::NAME_LENGTH];
+	enum class Type : uint8_t { Topic, WorkItem, Task } type;
+	uint8_t instance;
+	bool timed;
+	bool reaches_sink;
+	bool on_path;
+	DeviceNode *node;
+	unsigned generation;
+	float rate;
+	px4::work_item_timing_t timing;
+};
+
+struct Edge {
+	uint16_t from;
+	uint16_t to;
+	// topic to WorkItem: the callback group of the topic on the WorkQueue, then the WorkItem
+	uint32_t group_lag_avg;
+	uint32_t group_lag_max;
+	bool critical;
+
+	uint32_t lag_avg(const Vertex *v) const { return (v[from].type == Vertex::Type::Topic) ? group_lag_avg + v[to].timing.lag_avg : 0; }
+	uint32_t lag_max(const Vertex *v) const { return (v[from].type == Vertex::Type::Topic) ? group_lag_max + v[to].timing.lag_max : 0; }
+};
+
+struct Builder {
+	Vertex *vertices;
+	int num_vertices;
+	int max_vertices;
+	Edge *edges;
+	int num_edges;
+	int max_edges;
+	int topic; // topic of the callbacks being added
+
+	int find_or_add(const char *name, const char *work_queue, Vertex::Type type)
+	{
+		for (int i = 0; i < num_vertices; i++) {
+			if (vertices[i].type == type && strncmp(vertices[i].name, name, Graph::NAME_LENGTH - 1) == 0
+			    && strncmp(vertices[i].work_queue, work_queue, Graph::NAME_LENGTH - 1) == 0) {
+				return i;
+			}
+		}
+
+		if (num_vertices >= max_vertices) {
+			return -1;
+		}
+
+		Vertex &v = vertices[num_vertices];
+		v = {};
+		strncpy(v.name, name, sizeof(v.name) - 1);
+		strncpy(v.work_queue, work_queue, sizeof(v.work_queue) - 1);
+		v.type = type;
+		return num_vertices++;
+	}
+
+	void add_edge(int from, int to)
+	{
+		if (from < 0 || to < 0 || num_edges >= max_edges) {
+			return;
+		}
+
+		for (int i = 0; i < num_edges; i++) {
+			if (edges[i].from == from && edges[i].to == to) {
+				return;
+			}
+		}
+
+		edges[num_edges++] = Edge{(uint16_t)from, (uint16_t)to, 0, 0, false};
+	}
+
+	// the longest path to a sink, by the average latency
+	struct Path {
+		uint16_t *vertices;
+		int length;
+		uint32_t latency_avg;
+		uint32_t latency_max;
+	};
+
+	Path current;
+	Path best;
+	int steps;
+
+	void search(int v, const char *sink)
+	{
+		if (++steps > 100000 || current.length >= 32) {
+			return;
+		}
+
+		current.vertices[current.length++] = v;
+		vertices[v].on_path = true;
+
+		if (vertices[v].type == Vertex::Type::Topic && strcmp(vertices[v].name, sink) == 0) {
+			if (best.length == 0 || current.latency_avg > best.latency_avg) {
+				memcpy(best.vertices, current.vertices, current.length * sizeof(uint16_t));
+				best.length = current.length;
+				best.latency_avg = current.latency_avg;
+				best.latency_max = current.latency_max;
+			}
+
+		} else {
+			for (int i = 0; i < num_edges; i++) {
+				const Edge &e = edges[i];
+
+				if (e.from == v && vertices[e.to].reaches_sink && !vertices[e.to].on_path) {
+					const uint32_t run_avg = vertices[e.to].timing.run_time_avg;
+					const uint32_t run_max = vertices[e.to].timing.run_time_max;
+					current.latency_avg += e.lag_avg(vertices) + run_avg;
+					current.latency_max += e.lag_max(vertices) + run_max;
+					search(e.to, sink);
+					current.latency_avg -= e.lag_avg(vertices) + run_avg;
+					current.latency_max -= e.lag_max(vertices) + run_max;
+				}
+			}
+		}
+
+		vertices[v].on_path = false;
+		current.length--;
+	}
+};
+
+void add_callback(const px4::WorkItem &work_item, void *arg)
+{
+	Builder *b = static_cast<Builder *>(arg);
+	const char *work_queue = work_item.WorkQueueName();
+	const int v = b->find_or_add(work_item.ItemName(), (work_queue != nullptr) ? work_queue : "", Vertex::Type::WorkItem);
+	b->add_edge(b->topic, v);
+}
+
+#if defined(CONFIG_WORK_QUEUE_TIMING)
+bool add_timing(const char *wq_name, const char *item_name, const px4::work_item_timing_t &timing, void *arg)
+{
+	Builder *b = static_cast<Builder *>(arg);
+
+	for (int i = 0; i < b->num_vertices; i++) {
+		Vertex &v = b->vertices[i];
+
+		// items with the same name on a WorkQueue are merged, the slowest counts
+		if (v.type == Vertex::Type::WorkItem && strcmp(v.work_queue, wq_name) == 0
+		    && strncmp(v.name, item_name, Graph::NAME_LENGTH - 1) == 0) {
+			if (!v.timed || timing.run_time_avg > v.timing.run_time_avg) {
+				v.timing = timing;
+			}
+
+			v.timed = true;
+		}
+	}
+
+	// the callback groups are named after their topic
+	for (int i = 0; i < b->num_edges; i++) {
+		Edge &e = b->edges[i];
+		const Vertex &from = b->vertices[e.from];
+		const Vertex &to = b->vertices[e.to];
+
+		if (from.type == Vertex::Type::Topic && strcmp(to.work_queue, wq_name) == 0 && strcmp(from.name, item_name) == 0) {
+			e.group_lag_avg = math::max(e.group_lag_avg, timing.lag_avg);
+			e.group_lag_max = math::max(e.group_lag_max, timing.lag_max);
+		}
+	}
+
+	// only peek, the window belongs to load_mon
+	return false;
+}
+#endif /* CONFIG_WORK_QUEUE_TIMING */
+
+} // namespace
+
+void Graph::show(DeviceNode *const *nodes, int num_nodes, const char *source, const char *sink, bool json,
+		 uint32_t interval_us)
+{
+	Builder b{};
+	b.max_vertices = num_nodes + MAX_PUBLISHERS + 64;
+	b.vertices = new Vertex[b.max_vertices];
+	b.max_edges = 4 * b.max_vertices;
+	b.edges = new Edge[b.max_edges];
+	b.current.vertices = new uint16_t[32];
+	b.best.vertices = new uint16_t[32];
+
+	if (b.vertices == nullptr || b.edges == nullptr || b.current.vertices == nullptr || b.best.vertices == nullptr) {
+		PX4_ERR("alloc failed");
+		delete[] b.vertices;
+		delete[] b.edges;
+		delete[] b.current.vertices;
+		delete[] b.best.vertices;
+		return;
+	}
+
+	for (int i = 0; i < num_nodes && b.num_vertices < b.max_vertices; i++) {
+		b.topic = b.num_vertices++;
+
+		Vertex &v = b.vertices[b.topic];
+		v = {};
+		strncpy(v.name, nodes[i]->get_name(), sizeof(v.name) - 1);
+		v.type = Vertex::Type::Topic;
+		v.node = nodes[i];
+		v.instance = nodes[i]->get_instance();
+		v.generation = nodes[i]->updates_available(0);
+
+		uint8_t publisher_ids[PUBLISHERS_PER_TOPIC];
+		nodes[i]->get_graph(publisher_ids, &add_callback, &b);
+
+		for (uint8_t id : publisher_ids) {
+			const Publisher *p = publisher(id);
+
+			if (p != nullptr) {
+				const Vertex::Type type = (p->work_queue[0] != '\0') ? Vertex::Type::WorkItem : Vertex::Type::Task;
+				b.add_edge(b.find_or_add(p->name, p->work_queue, type), b.topic);
+			}
+		}
+	}
+
+	px4_usleep(interval_us);
+
+	for (int i = 0; i < b.num_vertices; i++) {
+		Vertex &v = b.vertices[i];
+
+		if (v.node != nullptr) {
+			v.rate = (v.node->updates_available(0) - v.generation) * 1e6f / interval_us;
+		}
+	}
+
+#if defined(CONFIG_WORK_QUEUE_TIMING)
+	px4::WorkQueueManagerTimingStats(&add_timing, &b);
+#endif /* CONFIG_WORK_QUEUE_TIMING */
+
+	// only what leads to the sink is searched
+	for (int i = 0; i < b.num_vertices; i++) {
+		b.vertices[i].reaches_sink = (b.vertices[i].type == Vertex::Type::Topic) && (strcmp(b.vertices[i].name, sink) == 0);
+	}
+
+	for (bool changed = true; changed;) {
+		changed = false;
+
+		for (int i = 0; i < b.num_edges; i++) {
+			if (b.vertices[b.edges[i].to].reaches_sink && !b.vertices[b.edges[i].from].reaches_sink) {
+				b.vertices[b.edges[i].from].reaches_sink = true;
+				changed = true;
+			}
+		}
+	}
+
+	for (int i = 0; i < b.num_vertices; i++) {
+		if (b.vertices[i].type == Vertex::Type::Topic && b.vertices[i].reaches_sink && strcmp(b.vertices[i].name, source) == 0) {
+			b.search(i, sink);
+		}
+	}
+
+	for (int i = 0; i + 1 < b.best.length; i++) {
+		for (int j = 0; j < b.num_edges; j++) {
+			if (b.edges[j].from == b.best.vertices[i] && b.edges[j].to == b.best.vertices[i + 1]) {
+				b.edges[j].critical = true;
+			}
+		}
+	}
+
+	// topics that nobody publishes or calls back are left out
+	bool *connected = new bool[b.num_vertices] {};
+
+	for (int i = 0; i < b.num_edges; i++) {
+		connected[b.edges[i].from] = true;
+		connected[b.edges[i].to] = true;
+	}
+
+	static const char *const type_names[] = {"topic", "work_item", "task"};
+
+	if (json) {
+		PX4_INFO_RAW("{\"interval_us\": %u,\n\"vertices\": [", (unsigned)interval_us);
+
+		bool first = true;
+
+		for (int i = 0; i < b.num_vertices; i++) {
+			const Vertex &v = b.vertices[i];
+
+			if (!connected[i]) {
+				continue;
+			}
+
+			PX4_INFO_RAW("%s\n{\"id\": %i, \"type\": \"%s\", \"name\": \"%s\"", first ? "" : ",", i, type_names[(int)v.type], v.name);
+			first = false;
+
+			if (v.type == Vertex::Type::Topic) {
+				PX4_INFO_RAW(", \"instance\": %u, \"rate_hz\": %.1f}", v.instance, (double)v.rate);
+
+			} else if (v.type == Vertex::Type::WorkItem) {
+				PX4_INFO_RAW(", \"work_queue\": \"%s\", \"runs\": %u, \"lag_avg_us\": %u, \"lag_max_us\": %u, "
+					     "\"run_time_avg_us\": %u, \"run_time_max_us\": %u}", v.work_queue, (unsigned)v.timing.runs,
+					     (unsigned)v.timing.lag_avg, (unsigned)v.timing.lag_max, (unsigned)v.timing.run_time_avg, (unsigned)v.timing.run_time_max);
+
+			} else {
+				PX4_INFO_RAW("}");
+			}
+		}
+
+		PX4_INFO_RAW("\n],\n\"edges\": [");
+
+		for (int i = 0; i < b.num_edges; i++) {
+			const Edge &e = b.edges[i];
+			const Vertex &topic = b.vertices[(b.vertices[e.from].type == Vertex::Type::Topic) ? e.from : e.to];
+			PX4_INFO_RAW("%s\n{\"from\": %u, \"to\": %u, \"rate_hz\": %.1f, \"lag_avg_us\": %u, \"lag_max_us\": %u, \"critical\": %s}",
+				     (i == 0) ? "" : ",", e.from, e.to, (double)topic.rate, (unsigned)e.lag_avg(b.vertices),
+				     (unsigned)e.lag_max(b.vertices), e.critical ? "true" : "false");
+		}
+
+		PX4_INFO_RAW("\n],\n\"critical_path\": ");
+
+		if (b.best.length > 0) {
+			PX4_INFO_RAW("{\"source\": \"%s\", \"sink\": \"%s\", \"latency_avg_us\": %u, \"latency_max_us\": %u, \"vertices\": [",
+				     source, sink, (unsigned)b.best.latency_avg, (unsigned)b.best.latency_max);
+
+			for (int i = 0; i < b.best.length; i++) {
+				PX4_INFO_RAW("%s%u", (i == 0) ? "" : ", ", b.best.vertices[i]);
+			}
+
+			PX4_INFO_RAW("]}\n}\n");
+
+		} else {
+			PX4_INFO_RAW("null\n}\n");
+		}
+
+	} else {
+		PX4_INFO_RAW("digraph uorb {\n\trankdir=LR;\n\tnode [fontsize=10];\n\tedge [fontsize=9];\n");
+
+		for (int i = 0; i < b.num_vertices; i++) {
+			const Vertex &v = b.vertices[i];
+
+			if (!connected[i]) {
+				continue;
+			}
+
+			if (v.type == Vertex::Type::Topic) {
+				PX4_INFO_RAW("\tv%i [shape=box, label=\"%s %u\\n%.1f Hz\"];\n", i, v.name, v.instance, (double)v.rate);
+
+			} else if (v.type == Vertex::Type::WorkItem) {
+				PX4_INFO_RAW("\tv%i [label=\"%s\\n%s\\nrun %u/%u us\"];\n", i, v.name, v.work_queue,
+					     (unsigned)v.timing.run_time_avg, (unsigned)v.timing.run_time_max);
+
+			} else {
+				PX4_INFO_RAW("\tv%i [style=dashed, label=\"%s\\ntask\"];\n", i, v.name);
+			}
+		}
+
+		for (int i = 0; i < b.num_edges; i++) {
+			const Edge &e = b.edges[i];
+			const char *style = e.critical ? ", color=red, penwidth=2" : "";
+
+			if (b.vertices[e.from].type == Vertex::Type::Topic) {
+				PX4_INFO_RAW("\tv%u -> v%u [label=\"lag %u/%u us\"%s];\n", e.from, e.to, (unsigned)e.lag_avg(b.vertices),
+					     (unsigned)e.lag_max(b.vertices), style);
+
+			} else {
+				PX4_INFO_RAW("\tv%u -> v%u [label=\"%.1f Hz\"%s];\n", e.from, e.to, (double)b.vertices[e.to].rate, style);
+			}
+		}
+
+		if (b.best.length > 0) {
+			PX4_INFO_RAW("\tlabel=\"%s -> %s: %u us avg, %u us max\";\n", source, sink,
+				     (unsigned)b.best.latency_avg, (unsigned)b.best.latency_max);
+
+		} else {
+			PX4_INFO_RAW("\tlabel=\"no path from %s to %s\";\n", source, sink);
+		}
+
+		PX4_INFO_RAW("}\n");
+	}
+
+	delete[] connected;
+	delete[] b.vertices;
+	delete[] b.edges;
+	delete[] b.current.vertices;
+	delete[] b.best.vertices;
+}
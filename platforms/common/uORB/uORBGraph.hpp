@@ -0,0 +1,80 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#pragma once
+
+#include <stdint.h>
+
+namespace uORB
+{
+class DeviceNode;
+
+/**
+ * The graph of publishers, topics and callback subscribers shown by uorb graph (ORB_GRAPH).
+ *
+ * Nodes record who publishes them: the WorkItem that is running, or the task outside of a
+ * WorkQueue. Subscribers are the WorkItems of the topic callbacks. Publishers and
+ * subscribers are identified by their name and WorkQueue.
+ */
+class Graph
+{
+public:
+	static constexpr int NAME_LENGTH = 32;
+	static constexpr int MAX_PUBLISHERS = 128;
+	static constexpr int PUBLISHERS_PER_TOPIC = 4; ///< per topic instance, further ones are not recorded
+
+	struct Publisher {
+		char name[NAME_LENGTH];
+		char work_queue[NAME_LENGTH]; ///< empty for a task
+	};
+
+	/**
+	 * @return the id of the publisher on the calling thread, 0 if too many were seen
+	 */
+	static uint8_t current_publisher();
+
+	/**
+	 * Print the graph as DOT or JSON, with the publication rates of the topics and the
+	 * scheduling statistics of the WorkItems, and the longest chain from a source topic
+	 * to a sink topic.
+	 * Blocks for interval_us to measure the rates.
+	 */
+	static void show(DeviceNode *const *nodes, int num_nodes, const char *source, const char *sink, bool json,
+			 uint32_t interval_us);
+
+private:
+	static const Publisher *publisher(uint8_t id);
+};
+
+} // namespace uORB
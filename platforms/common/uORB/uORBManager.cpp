@@ -181,7 +181,8 @@ int	uORB::Manager::orb_ioctl(unsigned int cmd, unsigned long arg)
 
 	case ORBIOCDEVDATACOPY: {
 			orbiocdevdatacopy_t *data = (orbiocdevdatacopy_t *)arg;
-			data->ret = uORB::Manager::orb_data_copy(data->handle, data->dst, data->generation, data->only_if_updated);
+			data->ret = uORB::Manager::orb_data_copy(data->handle, data->dst, data->generation, data->only_if_updated,
+								   data->callback);
 		}
 		break;
 
@@ -210,6 +211,12 @@ int	uORB::Manager::orb_ioctl(unsigned int cmd, unsigned long arg)
 				if (arg == ORB_DEVMASTER_TOP) {
 					dev->showTop(nullptr, 0);
 
+#ifdef CONFIG_ORB_LATENCY
+
+				} else if (arg == ORB_DEVMASTER_LATENCY) {
+					dev->showLatency(nullptr, 0, false);
+#endif /* CONFIG_ORB_LATENCY */
+
 				} else {
 					dev->printStatistics();
 				}
@@ -375,6 +382,35 @@ int uORB::Manager::orb_publish(const struct orb_metadata *meta, orb_advert_t han
 	return uORB::DeviceNode::publish(meta, handle, data);
 }
 
+void *uORB::Manager::orb_loan(orb_advert_t handle)
+{
+#ifdef ORB_USE_PUBLISHER_RULES
+
+	if (handle == _Instance) {
+		return nullptr; // publish() pretends success
+	}
+
+#endif /* ORB_USE_PUBLISHER_RULES */
+
+	if (handle == nullptr) {
+		return nullptr;
+	}
+
+	return static_cast<DeviceNode *>(handle)->loan();
+}
+
+int uORB::Manager::orb_publish_loaned(const struct orb_metadata *meta, orb_advert_t handle, void *slot)
+{
+	return uORB::DeviceNode::publish_loaned(meta, handle, slot);
+}
+
+void uORB::Manager::orb_return_loan(orb_advert_t handle, void *slot)
+{
+	if (handle != nullptr) {
+		static_cast<DeviceNode *>(handle)->return_loan(slot);
+	}
+}
+
 int uORB::Manager::orb_copy(const struct orb_metadata *meta, int handle, void *buffer)
 {
 	int ret;
@@ -445,7 +481,8 @@ void uORB::Manager::orb_remove_internal_subscriber(void *node_handle)
 
 uint8_t uORB::Manager::orb_get_queue_size(const void *node_handle) { return static_cast<const DeviceNode *>(node_handle)->get_queue_size(); }
 
-bool uORB::Manager::orb_data_copy(void *node_handle, void *dst, unsigned &generation, bool only_if_updated)
+bool uORB::Manager::orb_data_copy(void *node_handle, void *dst, unsigned &generation, bool only_if_updated,
+				  bool callback)
 {
 	if (!is_advertised(node_handle)) {
 		return false;
@@ -455,7 +492,21 @@ bool uORB::Manager::orb_data_copy(void *node_handle, void *dst, unsigned &genera
 		return false;
 	}
 
-	return static_cast<DeviceNode *>(node_handle)->copy(dst, generation);
+	return static_cast<DeviceNode *>(node_handle)->copy(dst, generation, callback);
+}
+
+const void *uORB::Manager::orb_data_borrow(void *node_handle, unsigned &generation, unsigned &borrowed)
+{
+	if (!is_advertised(node_handle) || !static_cast<const uORB::DeviceNode *>(node_handle)->updates_available(generation)) {
+		return nullptr;
+	}
+
+	return static_cast<DeviceNode *>(node_handle)->borrow(generation, borrowed);
+}
+
+bool uORB::Manager::orb_borrow_valid(const void *node_handle, unsigned borrowed)
+{
+	return static_cast<const DeviceNode *>(node_handle)->borrow_valid(borrowed);
 }
 
 // add item to list of work items to schedule on node update
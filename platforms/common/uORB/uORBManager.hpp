@@ -112,6 +112,7 @@ typedef struct {
 	void *dst;
 	unsigned generation;
 	bool only_if_updated;
+	bool callback;
 	bool ret;
 } orbiocdevdatacopy_t;
 
@@ -149,7 +150,8 @@ typedef struct {
 
 typedef enum {
 	ORB_DEVMASTER_STATUS = 0,
-	ORB_DEVMASTER_TOP = 1
+	ORB_DEVMASTER_TOP = 1,
+	ORB_DEVMASTER_LATENCY = 2
 } orbiocdevmastercmd_t;
 #define ORBIOCDEVMASTERCMD	_ORBIOCDEV(45)
 
@@ -279,6 +281,30 @@ public:
 	 */
 	static int  orb_publish(const struct orb_metadata *meta, orb_advert_t handle, const void *data);
 
+	/**
+	 * Lend the slot of the next publication to fill it in place, see DeviceNode::loan().
+	 *
+	 * @handle    The handle returned from orb_advertise.
+	 * @return    The slot, or nullptr if the topic can't lend and the publisher has to copy.
+	 */
+	static void *orb_loan(orb_advert_t handle);
+
+	/**
+	 * Publish a slot returned by orb_loan().
+	 *
+	 * @param meta    The uORB metadata (usually from the ORB_ID() macro)
+	 *      for the topic.
+	 * @handle    The handle returned from orb_advertise.
+	 * @param slot    The slot returned by orb_loan().
+	 * @return    OK on success, PX4_ERROR otherwise with errno set accordingly.
+	 */
+	static int  orb_publish_loaned(const struct orb_metadata *meta, orb_advert_t handle, void *slot);
+
+	/**
+	 * Give back a slot returned by orb_loan() without publishing it.
+	 */
+	static void orb_return_loan(orb_advert_t handle, void *slot);
+
 	/**
 	 * Subscribe to a topic.
 	 *
@@ -440,7 +466,12 @@ public:
 
 	static uint8_t orb_get_queue_size(const void *node_handle);
 
-	static bool orb_data_copy(void *node_handle, void *dst, unsigned &generation, bool only_if_updated);
+	static bool orb_data_copy(void *node_handle, void *dst, unsigned &generation, bool only_if_updated,
+				  bool callback = false);
+
+	static const void *orb_data_borrow(void *node_handle, unsigned &generation, unsigned &borrowed);
+
+	static bool orb_borrow_valid(const void *node_handle, unsigned borrowed);
 
 	static bool register_callback(void *node_handle, SubscriptionCallback *callback_sub);
 
@@ -293,15 +293,42 @@ uint8_t uORB::Manager::orb_get_queue_size(const void *node_handle)
 	return data.size;
 }
 
-bool uORB::Manager::orb_data_copy(void *node_handle, void *dst, unsigned &generation, bool only_if_updated)
+bool uORB::Manager::orb_data_copy(void *node_handle, void *dst, unsigned &generation, bool only_if_updated,
+				  bool callback)
 {
-	orbiocdevdatacopy_t data = {node_handle, dst, generation, only_if_updated, false};
+	orbiocdevdatacopy_t data = {node_handle, dst, generation, only_if_updated, callback, false};
 	boardctl(ORBIOCDEVDATACOPY, reinterpret_cast<unsigned long>(&data));
 	generation = data.generation;
 
 	return data.ret;
 }
 
+// kernel memory can't be lent to user space, publishers and subscribers copy instead
+void *uORB::Manager::orb_loan(orb_advert_t handle)
+{
+	return nullptr;
+}
+
+int uORB::Manager::orb_publish_loaned(const struct orb_metadata *meta, orb_advert_t handle, void *slot)
+{
+	errno = EFAULT;
+	return PX4_ERROR;
+}
+
+void uORB::Manager::orb_return_loan(orb_advert_t handle, void *slot)
+{
+}
+
+const void *uORB::Manager::orb_data_borrow(void *node_handle, unsigned &generation, unsigned &borrowed)
+{
+	return nullptr;
+}
+
+bool uORB::Manager::orb_borrow_valid(const void *node_handle, unsigned borrowed)
+{
+	return false;
+}
+
 bool uORB::Manager::register_callback(void *node_handle, SubscriptionCallback *callback_sub)
 {
 	orbiocdevregcallback_t data = {node_handle, callback_sub, false};
@@ -0,0 +1,377 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "uORBSharedMemory.hpp"
+#include "uORB.h"
+
+#include <uORB/topics/uORBTopics.hpp>
+
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/posix.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/tasks.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+using namespace uORB;
+
+static constexpr mode_t READ_MODE = 0644;  // other users can read only
+static constexpr mode_t WRITE_MODE = 0666;
+
+static constexpr unsigned MAX_WRITABLE = 16;
+
+struct Writable {
+	const orb_metadata *meta;
+	shm::InboxSlot *slot;
+	uint32_t sequence;
+	orb_advert_t handle;
+};
+
+static pthread_mutex_t shm_mutex = PTHREAD_MUTEX_INITIALIZER;
+static int shm_instance = -1;
+static shm::Directory *shm_directory = nullptr;
+static shm::InboxHeader *shm_inbox = nullptr;
+static Writable shm_writable[MAX_WRITABLE] {};
+static unsigned shm_writable_count = 0;
+
+static void *create_segment(const char *name, size_t length, mode_t mode)
+{
+	const int fd = shm_open(name, O_CREAT | O_RDWR | O_TRUNC, mode);
+
+	if (fd < 0) {
+		PX4_ERR("shm_open %s failed (%i)", name, errno);
+		return nullptr;
+	}
+
+	void *addr = MAP_FAILED;
+
+	// the umask must not restrict the mode
+	if (fchmod(fd, mode) == 0 && ftruncate(fd, length) == 0) {
+		addr = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	}
+
+	close(fd);
+
+	if (addr == MAP_FAILED) {
+		PX4_ERR("mapping %s failed (%i)", name, errno);
+		shm_unlink(name);
+		return nullptr;
+	}
+
+	return addr;
+}
+
+// remove the segments listed in a directory
+static void remove_segments(int px4_instance)
+{
+	char name[shm::NAME_LENGTH + 32];
+	shm::directory_name(name, sizeof(name), px4_instance);
+
+	size_t length = 0;
+	const shm::Directory *directory = (const shm::Directory *)shm::map(name, false, &length);
+
+	if (directory != nullptr) {
+		if (length >= sizeof(shm::Directory) && directory->magic == shm::MAGIC) {
+			for (uint32_t i = 0; i < directory->count && i < shm::MAX_ENTRIES; i++) {
+				char topic[shm::NAME_LENGTH + 32];
+				shm::topic_name(topic, sizeof(topic), px4_instance, directory->entries[i].name, directory->entries[i].instance);
+				shm_unlink(topic);
+			}
+		}
+
+		munmap((void *)directory, length);
+	}
+
+	shm_unlink(name);
+	shm::inbox_name(name, sizeof(name), px4_instance);
+	shm_unlink(name);
+}
+
+static void remove_all()
+{
+	remove_segments(shm_instance);
+}
+
+// called with shm_mutex held
+static bool init_locked(int px4_instance)
+{
+	if (shm_directory != nullptr) {
+		return true;
+	}
+
+	shm_instance = px4_instance;
+	remove_segments(px4_instance);
+
+	char name[shm::NAME_LENGTH + 32];
+	shm::directory_name(name, sizeof(name), px4_instance);
+	shm_directory = (shm::Directory *)create_segment(name, sizeof(shm::Directory), READ_MODE);
+
+	if (shm_directory == nullptr) {
+		return false;
+	}
+
+	shm_directory->version = shm::VERSION;
+	__atomic_store_n(&shm_directory->magic, shm::MAGIC, __ATOMIC_RELEASE);
+
+	atexit(remove_all);
+	return true;
+}
+
+// called with shm_mutex held
+static shm::DirectoryEntry *add_entry(const orb_metadata *meta, uint8_t instance)
+{
+	shm::DirectoryEntry *entry = const_cast<shm::DirectoryEntry *>(shm::find(shm_directory, meta->o_name, instance));
+
+	if (entry != nullptr) {
+		return entry;
+	}
+
+	const uint32_t count = shm_directory->count;
+
+	if (count >= shm::MAX_ENTRIES) {
+		PX4_ERR("shm directory full");
+		return nullptr;
+	}
+
+	entry = &shm_directory->entries[count];
+	strncpy(entry->name, meta->o_name, sizeof(entry->name) - 1);
+	entry->message_hash = meta->message_hash;
+	entry->size = meta->o_size;
+	entry->instance = instance;
+
+	__atomic_store_n(&shm_directory->count, count + 1, __ATOMIC_RELEASE);
+	return entry;
+}
+
+void SharedMemory::init(int px4_instance)
+{
+	pthread_mutex_lock(&shm_mutex);
+	init_locked(px4_instance);
+	pthread_mutex_unlock(&shm_mutex);
+}
+
+uint8_t *SharedMemory::map_topic(const orb_metadata *meta, uint8_t instance, uint16_t slots, shm::TopicHeader **header)
+{
+	pthread_mutex_lock(&shm_mutex);
+
+	uint8_t *data = nullptr;
+
+	if (init_locked((shm_instance < 0) ? 0 : shm_instance)) {
+		char name[shm::NAME_LENGTH + 32];
+		shm::topic_name(name, sizeof(name), shm_instance, meta->o_name, instance);
+
+		const size_t data_offset = shm::align(sizeof(shm::TopicHeader));
+		shm::TopicHeader *h = (shm::TopicHeader *)create_segment(name, data_offset + meta->o_size * slots, READ_MODE);
+
+		if (h != nullptr) {
+			h->version = shm::VERSION;
+			h->message_hash = meta->message_hash;
+			h->size = meta->o_size;
+			h->slots = slots;
+			h->data_offset = data_offset;
+			__atomic_store_n(&h->magic, shm::MAGIC, __ATOMIC_RELEASE);
+
+			if (add_entry(meta, instance) != nullptr) {
+				*header = h;
+				data = (uint8_t *)h + data_offset;
+
+			} else {
+				munmap(h, data_offset + meta->o_size * slots);
+				shm_unlink(name);
+			}
+		}
+	}
+
+	pthread_mutex_unlock(&shm_mutex);
+
+	return data;
+}
+
+void SharedMemory::unmap_topic(const orb_metadata *meta, uint8_t instance, shm::TopicHeader *header)
+{
+	char name[shm::NAME_LENGTH + 32];
+	shm::topic_name(name, sizeof(name), shm_instance, meta->o_name, instance);
+
+	munmap(header, header->data_offset + meta->o_size * header->slots);
+	shm_unlink(name);
+}
+
+static int inbox_run(int argc, char *argv[])
+{
+	size_t buffer_size = 0;
+
+	for (unsigned i = 0; i < shm_writable_count; i++) {
+		if (shm_writable[i].meta->o_size > buffer_size) {
+			buffer_size = shm_writable[i].meta->o_size;
+		}
+	}
+
+	// messages are 8 byte aligned
+	uint64_t *buffer = (uint64_t *)malloc(buffer_size + sizeof(uint64_t));
+
+	if (buffer == nullptr) {
+		return PX4_ERROR;
+	}
+
+	while (true) {
+		// the doorbell is shared with other processes, it's a plain POSIX semaphore
+		if (sem_wait(&shm_inbox->doorbell) != 0) {
+			continue;
+		}
+
+		for (unsigned i = 0; i < shm_writable_count; i++) {
+			Writable &writable = shm_writable[i];
+			const uint32_t sequence = __atomic_load_n(&writable.slot->sequence, __ATOMIC_ACQUIRE);
+
+			// a writer that is still busy rings again once done
+			if ((sequence & 1) || sequence == writable.sequence) {
+				continue;
+			}
+
+			memcpy(buffer, writable.slot + 1, writable.meta->o_size);
+
+			// order the reads of the message before the check
+			__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+			if (__atomic_load_n(&writable.slot->sequence, __ATOMIC_RELAXED) != sequence) {
+				continue;
+			}
+
+			writable.sequence = sequence;
+
+			if (writable.handle == nullptr) {
+				writable.handle = orb_advertise(writable.meta, buffer);
+
+			} else {
+				orb_publish(writable.meta, writable.handle, buffer);
+			}
+		}
+	}
+
+	return PX4_OK;
+}
+
+static const orb_metadata *find_topic(const char *name, size_t length)
+{
+	const orb_metadata *const *topics = orb_get_topics();
+
+	for (size_t i = 0; i < orb_topics_count(); i++) {
+		if (strlen(topics[i]->o_name) == length && strncmp(topics[i]->o_name, name, length) == 0) {
+			return topics[i];
+		}
+	}
+
+	return nullptr;
+}
+
+int SharedMemory::start()
+{
+	pthread_mutex_lock(&shm_mutex);
+
+	if (shm_inbox != nullptr || !init_locked((shm_instance < 0) ? 0 : shm_instance)) {
+		pthread_mutex_unlock(&shm_mutex);
+		return (shm_inbox != nullptr) ? PX4_OK : PX4_ERROR;
+	}
+
+	// space or comma separated topic names
+	const char *writable = CONFIG_ORB_SHM_WRITABLE;
+	size_t inbox_length = shm::align(sizeof(shm::InboxHeader));
+
+	while (*writable != '\0') {
+		const size_t length = strcspn(writable, " ,");
+
+		if (length > 0) {
+			const orb_metadata *meta = find_topic(writable, length);
+
+			if (meta == nullptr) {
+				PX4_ERR("ORB_SHM_WRITABLE: unknown topic %.*s", (int)length, writable);
+
+			} else if (shm_writable_count >= MAX_WRITABLE) {
+				PX4_ERR("ORB_SHM_WRITABLE: more than %u topics", MAX_WRITABLE);
+
+			} else {
+				shm_writable[shm_writable_count++].meta = meta;
+				inbox_length += shm::align(sizeof(shm::InboxSlot) + meta->o_size);
+			}
+		}
+
+		writable += length;
+		writable += strspn(writable, " ,");
+	}
+
+	if (shm_writable_count == 0) {
+		pthread_mutex_unlock(&shm_mutex);
+		return PX4_OK;
+	}
+
+	char name[shm::NAME_LENGTH + 32];
+	shm::inbox_name(name, sizeof(name), shm_instance);
+	shm::InboxHeader *inbox = (shm::InboxHeader *)create_segment(name, inbox_length, WRITE_MODE);
+
+	if (inbox == nullptr || sem_init(&inbox->doorbell, 1, 0) != 0) {
+		pthread_mutex_unlock(&shm_mutex);
+		return PX4_ERROR;
+	}
+
+	inbox->version = shm::VERSION;
+	__atomic_store_n(&inbox->magic, shm::MAGIC, __ATOMIC_RELEASE);
+
+	size_t offset = shm::align(sizeof(shm::InboxHeader));
+
+	for (unsigned i = 0; i < shm_writable_count; i++) {
+		const orb_metadata *meta = shm_writable[i].meta;
+		shm_writable[i].slot = (shm::InboxSlot *)((uint8_t *)inbox + offset);
+		shm_writable[i].slot->size = meta->o_size;
+
+		shm::DirectoryEntry *entry = add_entry(meta, 0);
+
+		if (entry != nullptr) {
+			entry->inbox_offset = offset;
+			__atomic_store_n(&entry->writable, 1, __ATOMIC_RELEASE);
+		}
+
+		offset += shm::align(sizeof(shm::InboxSlot) + meta->o_size);
+	}
+
+	shm_inbox = inbox;
+
+	pthread_mutex_unlock(&shm_mutex);
+
+	int task = px4_task_spawn_cmd("orb_shm", SCHED_DEFAULT, SCHED_PRIORITY_DEFAULT, PX4_STACK_ADJUSTED(1500),
+				      (px4_main_t)&inbox_run, nullptr);
+
+	return (task < 0) ? PX4_ERROR : PX4_OK;
+}
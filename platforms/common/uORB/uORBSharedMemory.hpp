@@ -0,0 +1,94 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#pragma once
+
+#include "uORBSharedMemoryClient.hpp"
+
+struct orb_metadata;
+
+namespace uORB
+{
+
+/**
+ * Topic queues in POSIX shared memory (ORB_SHM), so that companion processes can read them
+ * at full rate without copies, see uORBSharedMemoryClient.hpp.
+ *
+ * A node maps its buffer into a segment instead of the heap, and mirrors its generation
+ * in the segment header when it publishes.
+ */
+class SharedMemory
+{
+public:
+	/**
+	 * Name the segments after the PX4 instance, and remove the ones left by a previous run.
+	 * Called before uORB starts, instance 0 is used otherwise.
+	 */
+	static void init(int px4_instance);
+
+	/**
+	 * Create the inbox of the topics in ORB_SHM_WRITABLE, and start the task that
+	 * publishes what other processes write to it.
+	 */
+	static int start();
+
+	/**
+	 * Map the buffer of a topic instance into its segment.
+	 * @param header set to the segment header
+	 * @return the zeroed slots, or nullptr if the segment could not be created
+	 */
+	static uint8_t *map_topic(const orb_metadata *meta, uint8_t instance, uint16_t slots, shm::TopicHeader **header);
+
+	static void unmap_topic(const orb_metadata *meta, uint8_t instance, shm::TopicHeader *header);
+
+	/**
+	 * The publication of the given generation starts to overwrite its slot.
+	 */
+	static void write_begin(shm::TopicHeader *header, unsigned generation)
+	{
+		__atomic_store_n(&header->begin, generation + 1, __ATOMIC_RELAXED);
+		// order the counter before the writes to the slot
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	}
+
+	/**
+	 * The publication of the given generation is complete.
+	 */
+	static void write_end(shm::TopicHeader *header, unsigned generation)
+	{
+		__atomic_store_n(&header->end, generation + 1, __ATOMIC_RELEASE);
+	}
+};
+
+} // namespace uORB
@@ -0,0 +1,424 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file uORBSharedMemoryClient.hpp
+ *
+ * Layout of the uORB shared memory segments (ORB_SHM), and a reader and a writer for
+ * companion processes. This header only depends on the C library, it can be copied
+ * into a project that is built outside of PX4.
+ *
+ * Segments of the PX4 instance i:
+ * - /px4_<i>_orb: the directory, one entry per topic instance that is shared
+ * - /px4_<i>_orb_<topic><instance>: the queue of a topic instance, mapped as the node buffer
+ * - /px4_<i>_orb_inbox: one slot per writable topic, which PX4 publishes from
+ *
+ * Only PX4 can write to the directory and the topic segments. Other processes publish
+ * through the inbox, which holds slots for the topics listed in ORB_SHM_WRITABLE only.
+ */
+
+#pragma once
+
+#include <fcntl.h>
+#include <semaphore.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace uORB
+{
+namespace shm
+{
+
+static constexpr uint32_t MAGIC = 0x4d48534f; // "OSHM"
+static constexpr uint32_t VERSION = 1;
+
+static constexpr unsigned NAME_LENGTH = 64;
+static constexpr unsigned MAX_ENTRIES = 1024;
+static constexpr unsigned ALIGNMENT = 64; // cache line
+
+/**
+ * Header of a topic segment, followed by the slots at data_offset.
+ *
+ * begin and end count the publications, like the generation of the node: begin when a
+ * publication starts writing its slot, end once it is complete. The latest message is
+ * in slot (end - 1) % slots, and it is intact as long as begin - (end - 1) <= slots.
+ */
+struct TopicHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t message_hash;
+	uint16_t size;        ///< message size
+	uint16_t slots;       ///< slots of the queue
+	uint32_t data_offset; ///< offset of slot 0 from the start of the segment
+	uint32_t begin;       ///< publications started
+	uint32_t end;         ///< publications completed
+};
+
+/**
+ * Slot of a writable topic in the inbox, followed by one message.
+ *
+ * sequence is odd while a writer fills the slot, writers take it with a compare and
+ * exchange from the even value. PX4 publishes each new even sequence, a writer that
+ * publishes faster than PX4 reads the inbox overwrites the previous message.
+ */
+struct InboxSlot {
+	uint32_t sequence;
+	uint32_t size;
+};
+
+struct InboxHeader {
+	uint32_t magic;
+	uint32_t version;
+	sem_t doorbell;       ///< process shared, posted by the writers after each message
+};
+
+struct DirectoryEntry {
+	char name[NAME_LENGTH];
+	uint32_t message_hash;
+	uint16_t size;
+	uint8_t instance;
+	uint8_t writable;
+	uint32_t inbox_offset; ///< offset of the InboxSlot in the inbox segment, 0 if not writable
+};
+
+/**
+ * The directory only grows, entries below count are complete.
+ */
+struct Directory {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t count;
+	uint32_t reserved;
+	DirectoryEntry entries[MAX_ENTRIES];
+};
+
+static inline void directory_name(char *buf, size_t len, int px4_instance)
+{
+	snprintf(buf, len, "/px4_%i_orb", px4_instance);
+}
+
+static inline void inbox_name(char *buf, size_t len, int px4_instance)
+{
+	snprintf(buf, len, "/px4_%i_orb_inbox", px4_instance);
+}
+
+static inline void topic_name(char *buf, size_t len, int px4_instance, const char *topic, unsigned instance)
+{
+	snprintf(buf, len, "/px4_%i_orb_%s%u", px4_instance, topic, instance);
+}
+
+static inline size_t align(size_t size)
+{
+	return (size + ALIGNMENT - 1) & ~(size_t)(ALIGNMENT - 1);
+}
+
+static inline void *map(const char *name, bool writable, size_t *size)
+{
+	const int fd = shm_open(name, writable ? O_RDWR : O_RDONLY, 0);
+
+	if (fd < 0) {
+		return nullptr;
+	}
+
+	struct stat st {};
+
+	void *addr = MAP_FAILED;
+
+	if (fstat(fd, &st) == 0 && st.st_size > 0) {
+		addr = mmap(nullptr, st.st_size, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+	}
+
+	close(fd);
+
+	if (addr == MAP_FAILED) {
+		return nullptr;
+	}
+
+	*size = st.st_size;
+	return addr;
+}
+
+/**
+ * Find a topic instance in the directory of a PX4 instance.
+ * @return the entry, or nullptr
+ */
+static inline const DirectoryEntry *find(const Directory *directory, const char *topic, unsigned instance)
+{
+	const uint32_t count = __atomic_load_n(&directory->count, __ATOMIC_ACQUIRE);
+
+	for (uint32_t i = 0; i < count && i < MAX_ENTRIES; i++) {
+		const DirectoryEntry &entry = directory->entries[i];
+
+		if (entry.instance == instance && strncmp(entry.name, topic, NAME_LENGTH) == 0) {
+			return &entry;
+		}
+	}
+
+	return nullptr;
+}
+
+/**
+ * Read the latest message of a topic instance, without copies if needed.
+ *
+ * The topic segment exists once the topic was published, open() fails before.
+ */
+class TopicReader
+{
+public:
+	TopicReader() = default;
+	~TopicReader() { close(); }
+
+	TopicReader(const TopicReader &) = delete;
+	TopicReader &operator=(const TopicReader &) = delete;
+
+	/**
+	 * @param message_hash the message_hash of the orb metadata the reader was built with, 0 to skip the check
+	 */
+	bool open(const char *topic, unsigned instance = 0, uint32_t message_hash = 0, int px4_instance = 0)
+	{
+		close();
+
+		char name[NAME_LENGTH + 32];
+		topic_name(name, sizeof(name), px4_instance, topic, instance);
+
+		_header = (const TopicHeader *)map(name, false, &_length);
+
+		if (_header == nullptr) {
+			return false;
+		}
+
+		if (_header->magic != MAGIC || _header->version != VERSION
+		    || (message_hash != 0 && _header->message_hash != message_hash)
+		    || _header->data_offset + (size_t)_header->size * _header->slots > _length) {
+			close();
+			return false;
+		}
+
+		_data = (const uint8_t *)_header + _header->data_offset;
+		return true;
+	}
+
+	void close()
+	{
+		if (_header != nullptr) {
+			munmap((void *)_header, _length);
+			_header = nullptr;
+			_data = nullptr;
+		}
+	}
+
+	bool is_open() const { return _header != nullptr; }
+
+	size_t size() const { return _header->size; }
+
+	/** publications so far */
+	uint32_t generation() const { return __atomic_load_n(&_header->end, __ATOMIC_ACQUIRE); }
+
+	bool updated() const { return generation() != _last; }
+
+	/**
+	 * Borrow the latest message in place.
+	 * The message can be overwritten while it is read, check valid() once done with it.
+	 *
+	 * @param generation set to the generation of the message
+	 * @return the message, or nullptr if nothing was published yet
+	 */
+	const void *borrow(uint32_t &generation) const
+	{
+		const uint32_t end = __atomic_load_n(&_header->end, __ATOMIC_ACQUIRE);
+
+		if (end == 0) {
+			return nullptr;
+		}
+
+		generation = end - 1;
+		return _data + (size_t)_header->size * (generation % _header->slots);
+	}
+
+	/**
+	 * Check that a borrowed message was not overwritten, after it was read.
+	 */
+	bool valid(uint32_t generation) const
+	{
+		// order the reads of the message before the check
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+		return __atomic_load_n(&_header->begin, __ATOMIC_RELAXED) - generation <= _header->slots;
+	}
+
+	/**
+	 * Copy the latest message.
+	 * @return true if a message was copied
+	 */
+	bool copy(void *dst)
+	{
+		for (int retry = 0; retry < 100; retry++) {
+			uint32_t generation;
+			const void *message = borrow(generation);
+
+			if (message == nullptr) {
+				return false;
+			}
+
+			memcpy(dst, message, _header->size);
+
+			if (valid(generation)) {
+				_last = generation + 1;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+private:
+	const TopicHeader *_header{nullptr};
+	const uint8_t *_data{nullptr};
+	size_t _length{0};
+	uint32_t _last{0};
+};
+
+/**
+ * Publish to a writable topic (ORB_SHM_WRITABLE), instance 0.
+ *
+ * Writers of the same topic take turns on its inbox slot, a writer that dies while it
+ * holds the slot blocks the topic until PX4 restarts.
+ */
+class TopicWriter
+{
+public:
+	TopicWriter() = default;
+	~TopicWriter() { close(); }
+
+	TopicWriter(const TopicWriter &) = delete;
+	TopicWriter &operator=(const TopicWriter &) = delete;
+
+	bool open(const char *topic, uint32_t message_hash = 0, int px4_instance = 0)
+	{
+		close();
+
+		char name[NAME_LENGTH + 32];
+		directory_name(name, sizeof(name), px4_instance);
+
+		size_t directory_length = 0;
+		const Directory *directory = (const Directory *)map(name, false, &directory_length);
+
+		if (directory == nullptr) {
+			return false;
+		}
+
+		const DirectoryEntry *entry = nullptr;
+
+		if (directory_length >= sizeof(Directory) && directory->magic == MAGIC && directory->version == VERSION) {
+			entry = find(directory, topic, 0);
+		}
+
+		uint32_t inbox_offset = 0;
+
+		if (entry != nullptr && entry->writable && (message_hash == 0 || entry->message_hash == message_hash)) {
+			inbox_offset = entry->inbox_offset;
+			_size = entry->size;
+		}
+
+		munmap((void *)directory, directory_length);
+
+		if (inbox_offset == 0) {
+			return false;
+		}
+
+		inbox_name(name, sizeof(name), px4_instance);
+		_inbox = (InboxHeader *)map(name, true, &_length);
+
+		if (_inbox == nullptr) {
+			return false;
+		}
+
+		if (_inbox->magic != MAGIC || inbox_offset + sizeof(InboxSlot) + _size > _length) {
+			close();
+			return false;
+		}
+
+		_slot = (InboxSlot *)((uint8_t *)_inbox + inbox_offset);
+		return true;
+	}
+
+	void close()
+	{
+		if (_inbox != nullptr) {
+			munmap(_inbox, _length);
+			_inbox = nullptr;
+			_slot = nullptr;
+		}
+	}
+
+	bool is_open() const { return _inbox != nullptr; }
+
+	size_t size() const { return _size; }
+
+	bool publish(const void *message, size_t size)
+	{
+		if (_slot == nullptr || size != _size) {
+			return false;
+		}
+
+		uint32_t sequence = __atomic_load_n(&_slot->sequence, __ATOMIC_RELAXED);
+
+		do {
+			sequence &= ~1u;
+
+		} while (!__atomic_compare_exchange_n(&_slot->sequence, &sequence, sequence + 1, true,
+						      __ATOMIC_SEQ_CST, __ATOMIC_RELAXED));
+
+		// order the odd sequence before the message
+		__atomic_thread_fence(__ATOMIC_RELEASE);
+		memcpy((uint8_t *)(_slot + 1), message, size);
+		__atomic_store_n(&_slot->sequence, sequence + 2, __ATOMIC_RELEASE);
+
+		sem_post(&_inbox->doorbell);
+		return true;
+	}
+
+private:
+	InboxHeader *_inbox{nullptr};
+	InboxSlot *_slot{nullptr};
+	size_t _length{0};
+	size_t _size{0};
+};
+
+} // namespace shm
+} // namespace uORB
@@ -524,9 +524,9 @@ int px4_pthread_cond_timedwait(pthread_cond_t *cond,
 	return lockstep_scheduler.cond_timedwait(cond, mutex, scheduled);
 }
 
-int px4_lockstep_register_component()
+int px4_lockstep_register_component(const char *name)
 {
-	return lockstep_scheduler.components().register_component();
+	return lockstep_scheduler.components().register_component(name);
 }
 
 void px4_lockstep_unregister_component(int component)
@@ -543,4 +543,9 @@ void px4_lockstep_wait_for_components()
 {
 	lockstep_scheduler.components().wait_for_components();
 }
+
+void px4_lockstep_print_status()
+{
+	lockstep_scheduler.components().print_status();
+}
 #endif
@@ -35,6 +35,8 @@
 
 #include <cstdint>
 #include <atomic>
+#include <climits>
+#include <pthread.h>
 
 #include <px4_platform_common/sem.h>
 
@@ -51,9 +53,10 @@ public:
 
 	/**
 	 * Register a component
+	 * @param name name used in the statistics, defaults to the name of the calling task
 	 * @return a valid component ID > 0 or 0 on error (or unsupported)
 	 */
-	int register_component();
+	int register_component(const char *name = nullptr);
 	void unregister_component(int component);
 
 	/**
@@ -68,11 +71,42 @@ public:
 	 */
 	void wait_for_components();
 
+	/**
+	 * Print which components held up wait_for_components() and how much of that wall time they spent
+	 * off-CPU. A component that is mostly off-CPU while the others are done sleeps on wall-clock time
+	 * (or blocks on I/O) and limits how fast the simulation can run.
+	 */
+	void print_status();
+
 private:
+	static constexpr int MAX_COMPONENTS = sizeof(int) * CHAR_BIT - 1;
+	static constexpr int NAME_LENGTH = 24;
+
+	struct ComponentStats {
+		char name[NAME_LENGTH];
+		std::atomic<uint64_t> waited_us{0};  ///< wall time wait_for_components() spent on this component
+		std::atomic<uint64_t> blocked_us{0}; ///< part of waited_us where the component was not on the CPU
+		std::atomic<uint32_t> cycles{0};     ///< cycles where this component finished last
+	};
+
+	void component_done(int component, uint64_t cpu_delta_us);
+
+	int stats_index(const char *name);
+
+
 	const bool _no_cleanup_on_destroy;
 
 	px4_sem_t _components_sem;
 
 	std::atomic_int _components_used_bitset{0};
 	std::atomic_int _components_progress_bitset{0};
+
+	pthread_mutex_t _stats_mutex = PTHREAD_MUTEX_INITIALIZER;
+	ComponentStats _stats[MAX_COMPONENTS] {};
+	int _num_stats{0};
+	std::atomic_int _component_stats[MAX_COMPONENTS] {}; ///< stats index + 1 for each component bit, 0 if none
+
+	std::atomic<uint64_t> _wait_start_us{0}; ///< wall time wait_for_components() started blocking, 0 if not waiting
+	std::atomic<uint64_t> _wait_total_us{0};
+	std::atomic<uint32_t> _wait_cycles{0};
 };
@@ -41,6 +41,31 @@
 #include <px4_platform_common/log.h>
 #include <px4_platform_common/tasks.h>
 #include <limits.h>
+#include <string.h>
+#include <time.h>
+
+namespace
+{
+
+uint64_t clock_us(clockid_t clk_id)
+{
+	// the real clocks, not the lockstep time
+	struct timespec ts;
+	clock_gettime(clk_id, &ts);
+	return ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+// CPU time used by the calling thread since its previous call
+uint64_t thread_cpu_delta_us()
+{
+	static thread_local uint64_t last_cpu_us = 0;
+	const uint64_t cpu_us = clock_us(CLOCK_THREAD_CPUTIME_ID);
+	const uint64_t delta_us = cpu_us - last_cpu_us;
+	last_cpu_us = cpu_us;
+	return delta_us;
+}
+
+} // namespace
 
 LockstepComponents::LockstepComponents(bool no_cleanup_on_destroy)
 	: _no_cleanup_on_destroy(no_cleanup_on_destroy)
@@ -57,7 +82,7 @@ LockstepComponents::~LockstepComponents()
 	}
 }
 
-int LockstepComponents::register_component()
+int LockstepComponents::register_component(const char *name)
 {
 	for (int component = 0; component < (int)sizeof(int) * CHAR_BIT - 1; ++component) {
 		while (true) {
@@ -69,6 +94,7 @@ int LockstepComponents::register_component()
 
 			if (_components_used_bitset.compare_exchange_weak(expected, expected | (1 << component))) {
 				PX4_DEBUG("%s: got lockstep component %i", px4_get_taskname(), component);
+				_component_stats[component] = stats_index(name ? name : px4_get_taskname()) + 1;
 				return 1 << component;
 			}
 		}
@@ -84,12 +110,15 @@ void LockstepComponents::unregister_component(int component)
 		return;
 	}
 
+	const uint64_t cpu_delta_us = thread_cpu_delta_us();
+
 	_components_progress_bitset.fetch_and(~component);
 	_components_used_bitset.fetch_and(~component);
 
 	int components_used_bitset = _components_used_bitset;
 
 	if (_components_progress_bitset == components_used_bitset) {
+		component_done(component, cpu_delta_us);
 		_components_progress_bitset = 0;
 		px4_sem_post(&_components_sem);
 	}
@@ -101,6 +130,8 @@ void LockstepComponents::lockstep_progress(int component)
 		return;
 	}
 
+	const uint64_t cpu_delta_us = thread_cpu_delta_us();
+
 	// Use a bitset to mark progress of each component. We could also use a simple counter,
 	// but this is more robust (e.g. if a component calls this multiple times per cycle).
 	int prev_value = _components_progress_bitset.fetch_or(component);
@@ -110,6 +141,7 @@ void LockstepComponents::lockstep_progress(int component)
 		// Note: there's a minimal race condtion here during startup: if a thread is here, and another calls
 		// register_component and is fast enough it can land here as well, thus leading to 2 unlocks in a cycle.
 		// That is acceptable though.
+		component_done(component, cpu_delta_us);
 		_components_progress_bitset = 0;
 
 		// during startup it can happen that wait_for_components() is not called yet, so avoid increasing the
@@ -128,5 +160,96 @@ void LockstepComponents::wait_for_components()
 		return;
 	}
 
+	const uint64_t wait_start_us = clock_us(CLOCK_MONOTONIC);
+	_wait_start_us = wait_start_us;
+
 	while (px4_sem_wait(&_components_sem) != 0) {}
+
+	_wait_start_us = 0;
+	_wait_total_us += clock_us(CLOCK_MONOTONIC) - wait_start_us;
+	_wait_cycles++;
+}
+
+void LockstepComponents::component_done(int component, uint64_t cpu_delta_us)
+{
+	const uint64_t wait_start_us = _wait_start_us;
+
+	if (wait_start_us == 0) {
+		// wait_for_components() is not blocking, so this component did not hold anything up
+		return;
+	}
+
+	const int index = _component_stats[__builtin_ctz(component)] - 1;
+
+	if (index < 0) {
+		return;
+	}
+
+	// The component finished last while the loop was waiting. Whatever part of the wait it did not spend
+	// on the CPU it was sleeping or blocked, which does not get faster with the simulation.
+	const uint64_t now_us = clock_us(CLOCK_MONOTONIC);
+	const uint64_t waited_us = now_us > wait_start_us ? now_us - wait_start_us : 0;
+
+	ComponentStats &stats = _stats[index];
+	stats.waited_us += waited_us;
+	stats.blocked_us += waited_us > cpu_delta_us ? waited_us - cpu_delta_us : 0;
+	stats.cycles++;
+}
+
+int LockstepComponents::stats_index(const char *name)
+{
+	if (name == nullptr) {
+		return -1;
+	}
+
+	int index = -1;
+
+	pthread_mutex_lock(&_stats_mutex);
+
+	for (int i = 0; i < _num_stats; ++i) {
+		if (strncmp(_stats[i].name, name, NAME_LENGTH - 1) == 0) {
+			index = i;
+			break;
+		}
+	}
+
+	if (index < 0 && _num_stats < MAX_COMPONENTS) {
+		index = _num_stats++;
+		strncpy(_stats[index].name, name, NAME_LENGTH - 1);
+		_stats[index].name[NAME_LENGTH - 1] = '\0';
+	}
+
+	pthread_mutex_unlock(&_stats_mutex);
+
+	return index;
+}
+
+void LockstepComponents::print_status()
+{
+	const uint32_t wait_cycles = _wait_cycles;
+
+	PX4_INFO_RAW("lockstep: %u cycles, waited %.1f ms for components\n", (unsigned)wait_cycles,
+		     (double)(_wait_total_us / 1e3));
+
+	PX4_INFO_RAW("%-*s %10s %12s %12s\n", NAME_LENGTH, "component", "last", "waited [ms]", "blocked [ms]");
+
+	pthread_mutex_lock(&_stats_mutex);
+
+	for (int i = 0; i < _num_stats; ++i) {
+		const ComponentStats &stats = _stats[i];
+		const uint64_t waited_us = stats.waited_us;
+		const uint64_t blocked_us = stats.blocked_us;
+
+		if (stats.cycles == 0) {
+			continue;
+		}
+
+		// mostly off-CPU while everyone else was done: sleeping on wall-clock time or blocking I/O
+		const bool wall_clock = blocked_us > waited_us / 2 && blocked_us > 1000;
+
+		PX4_INFO_RAW("%-*s %10u %12.1f %12.1f%s\n", NAME_LENGTH, stats.name, (unsigned)stats.cycles,
+			     (double)(waited_us / 1e3), (double)(blocked_us / 1e3), wall_clock ? "  <- blocks on wall-clock time" : "");
+	}
+
+	pthread_mutex_unlock(&_stats_mutex);
 }
@@ -73,6 +73,11 @@
 #include <px4_platform_common/getopt.h>
 #include <px4_platform_common/tasks.h>
 #include <px4_platform_common/posix.h>
+#include <px4_platform_common/px4_config.h>
+
+#if defined(CONFIG_ORB_SHM)
+#include <uORB/uORBSharedMemory.hpp>
+#endif
 
 #include "apps.h"
 #include "px4_daemon/client.h"
@@ -350,6 +355,11 @@ int main(int argc, char **argv)
 			return ret;
 		}
 
+#if defined(CONFIG_ORB_SHM)
+		// name the shared topics after the instance, before any is published
+		uORB::SharedMemory::init(instance);
+#endif
+
 		px4::init_once();
 		px4::init(argc, argv, "px4");
 
@@ -251,16 +251,21 @@ __EXPORT extern void	hrt_ioctl_init(void);
 
 #if defined(ENABLE_LOCKSTEP_SCHEDULER)
 
-__EXPORT extern int px4_lockstep_register_component(void);
+/*
+ * Register a lockstep component, name defaults to the calling task (nullptr)
+ */
+__EXPORT extern int px4_lockstep_register_component(const char *name);
 __EXPORT extern void px4_lockstep_unregister_component(int component);
 __EXPORT extern void px4_lockstep_progress(int component);
 __EXPORT extern void px4_lockstep_wait_for_components(void);
+__EXPORT extern void px4_lockstep_print_status(void);
 
 #else
-static inline int px4_lockstep_register_component(void) { return 0; }
+static inline int px4_lockstep_register_component(const char *name) { (void)name; return 0; }
 static inline void px4_lockstep_unregister_component(int component) { (void)component; }
 static inline void px4_lockstep_progress(int component) {(void)component; }
 static inline void px4_lockstep_wait_for_components(void) { }
+static inline void px4_lockstep_print_status(void) { }
 #endif /* defined(ENABLE_LOCKSTEP_SCHEDULER) */
 
 
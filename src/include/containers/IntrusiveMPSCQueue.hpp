@@ -0,0 +1,107 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#pragma once
+
+#include <px4_platform_common/atomic.h>
+
+#include "IntrusiveQueue.hpp"
+
+/**
+ * Lock-free multiple producer, single consumer queue of IntrusiveQueueNodes.
+ *
+ * Producers push onto a lock-free stack. The consumer takes the whole stack at
+ * once and appends it, oldest first, to an IntrusiveQueue only it touches.
+ * Nodes are linked through IntrusiveQueueNode, so a node must not be pushed
+ * again before it was drained (or while it is in any other IntrusiveQueue).
+ */
+template<class T>
+class IntrusiveMPSCQueue
+{
+public:
+
+	bool empty() const { return _top.load() == nullptr; }
+
+	/**
+	 * Push a node, from any thread.
+	 * @return true if the queue was empty, the consumer may have to be woken up
+	 */
+	bool push(T newNode)
+	{
+		T top = _top.load();
+
+		do {
+			newNode->set_next_intrusive_queue_node(top);
+		} while (!_top.compare_exchange(&top, newNode));
+
+		return top == nullptr;
+	}
+
+	/**
+	 * Move all pushed nodes to the back of queue, in push order.
+	 * Only one thread at a time may drain.
+	 */
+	void drain(IntrusiveQueue<T> &queue)
+	{
+		T top = _top.load();
+
+		if (top == nullptr) {
+			return;
+		}
+
+		while (!_top.compare_exchange(&top, nullptr)) {}
+
+		// the stack is newest first
+		T oldest = nullptr;
+
+		while (top != nullptr) {
+			T next = top->next_intrusive_queue_node();
+			top->set_next_intrusive_queue_node(oldest);
+			oldest = top;
+			top = next;
+		}
+
+		while (oldest != nullptr) {
+			T next = oldest->next_intrusive_queue_node();
+			oldest->set_next_intrusive_queue_node(nullptr);
+			queue.push(oldest);
+			oldest = next;
+		}
+	}
+
+private:
+
+	px4::atomic<T> _top{nullptr};
+
+};
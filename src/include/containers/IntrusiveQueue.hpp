@@ -155,11 +155,15 @@ private:
 
 };
 
+template<class T>
+class IntrusiveMPSCQueue;
+
 template<class T>
 class IntrusiveQueueNode
 {
 private:
 	friend IntrusiveQueue<T>;
+	friend IntrusiveMPSCQueue<T>;
 
 	T next_intrusive_queue_node() const { return _next_intrusive_queue_node; }
 	void set_next_intrusive_queue_node(T new_next) { _next_intrusive_queue_node = new_next; }
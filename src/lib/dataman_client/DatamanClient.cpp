@@ -219,6 +219,58 @@ bool DatamanClient::writeSync(dm_item_t item, uint32_t index, uint8_t *buffer, u
 	return success;
 }
 
+bool DatamanClient::writeBatchSync(dm_item_t item, uint32_t index, uint8_t *buffer, uint32_t length, uint32_t count,
+				   hrt_abstime timeout)
+{
+	if (length > g_per_item_size[item]) {
+		PX4_ERR("Length  %" PRIu32 " can't fit in data size for item  %" PRIi8, length, static_cast<uint8_t>(item));
+		return false;
+	}
+
+	// the writes of a window are queued back to back and acknowledged by the DM_SYNC that closes it
+	static constexpr uint32_t window_size = dataman_request_s::ORB_QUEUE_LENGTH - 1;
+
+	dataman_request_s request;
+	request.client_id = _client_id;
+	request.item = static_cast<uint8_t>(item);
+
+	dataman_response_s response{};
+
+	for (uint32_t first = 0; first < count; first += window_size) {
+		const uint32_t window = (count - first < window_size) ? (count - first) : window_size;
+		bool success = false;
+
+		for (int attempt = 0; (attempt < 3) && !success; ++attempt) {
+			request.request_type = DM_WRITE_BATCH;
+			request.data_length = length;
+
+			for (uint32_t i = first; i < first + window; ++i) {
+				request.timestamp = hrt_absolute_time();
+				request.index = index + i;
+				memcpy(request.data, buffer + i * length, length);
+				_dataman_request_pub.publish(request);
+			}
+
+			hrt_abstime timestamp = hrt_absolute_time();
+			request.timestamp = timestamp;
+			request.index = index + first;
+			request.data_length = window;
+			request.request_type = DM_SYNC;
+
+			success = syncHandler(request, response, timestamp, timeout)
+				  && (response.status == dataman_response_s::STATUS_SUCCESS);
+		}
+
+		if (!success) {
+			PX4_ERR("writeBatchSync failed! status=%" PRIu8 ", item=%" PRIu8 ", index=%" PRIu32 ", count=%" PRIu32,
+				response.status, static_cast<uint8_t>(item), index + first, window);
+			return false;
+		}
+	}
+
+	return true;
+}
+
 bool DatamanClient::clearSync(dm_item_t item, hrt_abstime timeout)
 {
 	bool success = false;
@@ -77,6 +77,25 @@ public:
 	 */
 	bool writeSync(dm_item_t item, uint32_t index, uint8_t *buffer, uint32_t length, hrt_abstime timeout = 5000_ms);
 
+	/**
+	 * @brief Write consecutive indexes of an item to the dataman synchronously, in batches.
+	 *
+	 * The writes are published in windows of up to dataman_request ORB_QUEUE_LENGTH - 1 items without waiting
+	 * for a response per item. The DM_SYNC closing each window flushes the storage once and acknowledges the
+	 * whole window; a window with a lost or failed write is sent again.
+	 *
+	 * @param[in] item The data item type to write.
+	 * @param[in] index The first index to write.
+	 * @param[in] buffer The buffer that contains count data items of the given length.
+	 * @param[in] length The length of each data item.
+	 * @param[in] count The number of data items to write.
+	 * @param[in] timeout The maximum time in microseconds to wait for each window to be acknowledged.
+	 *
+	 * @return True if all items were written and flushed, false otherwise.
+	 */
+	bool writeBatchSync(dm_item_t item, uint32_t index, uint8_t *buffer, uint32_t length, uint32_t count,
+			    hrt_abstime timeout = 5000_ms);
+
 	/**
 	 * @brief Clears the data in the specified dataman item.
 	 *
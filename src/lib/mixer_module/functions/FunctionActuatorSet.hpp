@@ -35,22 +35,32 @@
 
 #include "FunctionProviderBase.hpp"
 
+#include <drivers/drv_hrt.h>
+#include <mathlib/mathlib.h>
+#include <uORB/Publication.hpp>
+#include <uORB/topics/timed_actuator_set.h>
+#include <uORB/topics/timed_actuator_set_ack.h>
 #include <uORB/topics/vehicle_command.h>
 
 /**
  * Functions: Peripheral_via_Actuator_Set1 ... Peripheral_via_Actuator_Set6
+ *
+ * Values set through timed_actuator_set are held back until the output cycle closest to the requested time.
+ * Only the output module that has the addressed function assigned handles (and acknowledges) a timed request.
  */
 class FunctionActuatorSet : public FunctionProviderBase
 {
 public:
-	FunctionActuatorSet()
+	FunctionActuatorSet(const Context &context)
+		: _function_assignments(context.function_assignments),
+		  _num_outputs(context.num_outputs)
 	{
 		for (int i = 0; i < max_num_actuators; ++i) {
 			_data[i] = NAN;
 		}
 	}
 
-	static FunctionProviderBase *allocate(const Context &context) { return new FunctionActuatorSet(); }
+	static FunctionProviderBase *allocate(const Context &context) { return new FunctionActuatorSet(context); }
 
 	void update() override
 	{
@@ -75,6 +85,43 @@ public:
 				}
 			}
 		}
+
+		timed_actuator_set_s timed_set;
+
+		while (_timed_topic.update(&timed_set)) {
+			if (timed_set.index < max_num_actuators && assigned(timed_set.index)) {
+				// a newer request replaces a pending one
+				_pending[timed_set.index] = timed_set;
+				_pending_valid[timed_set.index] = true;
+			}
+		}
+
+		const hrt_abstime now = hrt_absolute_time();
+
+		if (_last_update != 0) {
+			const float dt = math::constrain((float)(now - _last_update), 100.f, 100000.f);
+			_update_interval_us = 0.9f * _update_interval_us + 0.1f * dt;
+		}
+
+		_last_update = now;
+
+		for (int i = 0; i < max_num_actuators; ++i) {
+			// apply on this cycle if the next one would be further away from the requested time
+			if (_pending_valid[i] && _pending[i].apply_at <= now + (hrt_abstime)(0.5f * _update_interval_us)) {
+				if (PX4_ISFINITE(_pending[i].value)) {
+					_data[i] = _pending[i].value;
+				}
+
+				_pending_valid[i] = false;
+
+				timed_actuator_set_ack_s ack{};
+				ack.apply_at = _pending[i].apply_at;
+				ack.applied = now;
+				ack.index = i;
+				ack.timestamp = hrt_absolute_time();
+				_ack_pub.publish(ack);
+			}
+		}
 	}
 
 	float value(OutputFunction func) override { return _data[(int)func - (int)OutputFunction::Peripheral_via_Actuator_Set1]; }
@@ -82,6 +129,29 @@ public:
 private:
 	static constexpr int max_num_actuators = 6;
 
+	bool assigned(int index) const
+	{
+		const OutputFunction function = (OutputFunction)((int)OutputFunction::Peripheral_via_Actuator_Set1 + index);
+
+		for (int i = 0; i < _num_outputs; ++i) {
+			if (_function_assignments[i] == function) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	const OutputFunction *_function_assignments;
+	const int _num_outputs;
+
 	uORB::Subscription _topic{ORB_ID(vehicle_command)};
+	uORB::Subscription _timed_topic{ORB_ID(timed_actuator_set)};
+	uORB::Publication<timed_actuator_set_ack_s> _ack_pub{ORB_ID(timed_actuator_set_ack)};
 	float _data[max_num_actuators] {};
+
+	timed_actuator_set_s _pending[max_num_actuators] {};
+	bool _pending_valid[max_num_actuators] {};
+	hrt_abstime _last_update{0};
+	float _update_interval_us{4000.f}; ///< filtered interval between output cycles
 };
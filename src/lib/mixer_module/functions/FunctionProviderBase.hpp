@@ -48,6 +48,8 @@ public:
 	struct Context {
 		px4::WorkItem &work_item;
 		const float &thrust_factor;
+		const OutputFunction *function_assignments; ///< function of each output of the module
+		int num_outputs;
 	};
 
 	FunctionProviderBase() = default;
@@ -68,6 +68,8 @@ static constexpr int TASK_STACK_SIZE = 1420;
 #ifdef CONFIG_DATAMAN_PERSISTENT_STORAGE
 /* Private File based Operations */
 static ssize_t _file_write(dm_item_t item, unsigned index, const void *buf, size_t count);
+static ssize_t _file_write_batch(dm_item_t item, unsigned index, const void *buf, size_t count);
+static int _file_sync();
 static ssize_t _file_read(dm_item_t item, unsigned index, void *buf, size_t count);
 static int  _file_clear(dm_item_t item);
 static int _file_initialize(unsigned max_offset);
@@ -76,6 +78,7 @@ static void _file_shutdown();
 
 /* Private Ram based Operations */
 static ssize_t _ram_write(dm_item_t item, unsigned index, const void *buf, size_t count);
+static int _ram_sync();
 static ssize_t _ram_read(dm_item_t item, unsigned index, void *buf, size_t count);
 static int  _ram_clear(dm_item_t item);
 static int _ram_initialize(unsigned max_offset);
@@ -83,6 +86,8 @@ static void _ram_shutdown();
 
 typedef struct dm_operations_t {
 	ssize_t (*write)(dm_item_t item, unsigned index, const void *buf, size_t count);
+	ssize_t (*write_batch)(dm_item_t item, unsigned index, const void *buf, size_t count);
+	int (*sync)();
 	ssize_t (*read)(dm_item_t item, unsigned index, void *buf, size_t count);
 	int (*clear)(dm_item_t item);
 	int (*initialize)(unsigned max_offset);
@@ -93,6 +98,8 @@ typedef struct dm_operations_t {
 #ifdef CONFIG_DATAMAN_PERSISTENT_STORAGE
 static constexpr dm_operations_t dm_file_operations = {
 	.write   = _file_write,
+	.write_batch = _file_write_batch,
+	.sync    = _file_sync,
 	.read    = _file_read,
 	.clear   = _file_clear,
 	.initialize = _file_initialize,
@@ -103,6 +110,8 @@ static constexpr dm_operations_t dm_file_operations = {
 
 static constexpr dm_operations_t dm_ram_operations = {
 	.write   = _ram_write,
+	.write_batch = _ram_write,
+	.sync    = _ram_sync,
 	.read    = _ram_read,
 	.clear   = _ram_clear,
 	.initialize = _ram_initialize,
@@ -170,6 +179,15 @@ static px4_sem_t g_init_sema;
 
 static bool g_task_should_exit;	/**< if true, dataman task should exit */
 
+/* Batched writes since the last DM_SYNC, acknowledged together by the DM_SYNC response */
+static struct {
+	uint8_t client_id;
+	uint32_t count;
+	bool failed;
+	hrt_abstime sync_timestamp;	/**< timestamp of the last DM_SYNC, a resent one gets the same answer */
+	uint8_t sync_status;
+} g_batch;
+
 /* Work queue management functions */
 
 static bool is_running()
@@ -247,10 +265,16 @@ static ssize_t _ram_write(dm_item_t item, unsigned index, const void *buf, size_
 	return count;
 }
 
+/* RAM writes are visible immediately, nothing to flush */
+static int _ram_sync()
+{
+	return 0;
+}
+
 #ifdef CONFIG_DATAMAN_PERSISTENT_STORAGE
-/* write to the data manager file */
+/* write to the data manager file, optionally flushing it to physical media */
 static ssize_t
-_file_write(dm_item_t item, unsigned index, const void *buf, size_t count)
+_file_write_item(dm_item_t item, unsigned index, const void *buf, size_t count, bool flush)
 {
 	if (item >= DM_KEY_NUM_KEYS) {
 		return -1;
@@ -320,11 +344,34 @@ _file_write(dm_item_t item, unsigned index, const void *buf, size_t count)
 	}
 
 	/* Make sure data is written to physical media */
-	fsync(dm_operations_data.file.fd);
+	if (flush) {
+		fsync(dm_operations_data.file.fd);
+	}
 
 	/* All is well... return the number of user data written */
 	return count - DM_SECTOR_HDR_SIZE;
 }
+
+/* write to the data manager file */
+static ssize_t
+_file_write(dm_item_t item, unsigned index, const void *buf, size_t count)
+{
+	return _file_write_item(item, index, buf, count, true);
+}
+
+/* write to the data manager file, the caller flushes the batch with _file_sync() */
+static ssize_t
+_file_write_batch(dm_item_t item, unsigned index, const void *buf, size_t count)
+{
+	return _file_write_item(item, index, buf, count, false);
+}
+
+/* flush batched writes to physical media */
+static int
+_file_sync()
+{
+	return fsync(dm_operations_data.file.fd);
+}
 #endif
 
 /* Retrieve from the data manager RAM buffer*/
@@ -745,6 +792,7 @@ task_main(int argc, char *argv[])
 				response.status = dataman_response_s::STATUS_FAILURE_NO_DATA;
 
 				ssize_t result;
+				bool respond = true;
 
 				switch (request.request_type) {
 
@@ -778,6 +826,57 @@ task_main(int argc, char *argv[])
 
 					break;
 
+				case DM_WRITE_BATCH:
+
+					g_func_counts[DM_WRITE_BATCH]++;
+
+					/* another client started a batch, the previous one fails its count check and is resent */
+					if (request.client_id != g_batch.client_id) {
+						g_batch.client_id = request.client_id;
+						g_batch.count = 0;
+						g_batch.failed = false;
+					}
+
+					perf_begin(_dm_write_perf);
+					result = g_dm_ops->write_batch(static_cast<dm_item_t>(request.item), request.index,
+								       &(request.data), request.data_length);
+					perf_end(_dm_write_perf);
+
+					g_batch.count++;
+					g_batch.failed |= (result <= 0);
+
+					/* no response, the writes are acknowledged by DM_SYNC */
+					respond = false;
+					break;
+
+				case DM_SYNC:
+
+					g_func_counts[DM_SYNC]++;
+
+					if ((request.client_id == g_batch.client_id) && (request.timestamp == g_batch.sync_timestamp)) {
+						response.status = g_batch.sync_status;
+						break;
+					}
+
+					result = g_dm_ops->sync();
+
+					/* data_length carries the number of batched writes the client sent */
+					if ((result == 0) && (request.client_id == g_batch.client_id) && (request.data_length == g_batch.count)
+					    && !g_batch.failed) {
+						response.status = dataman_response_s::STATUS_SUCCESS;
+
+					} else {
+						response.status = dataman_response_s::STATUS_FAILURE_WRITE_FAILED;
+					}
+
+					g_batch.client_id = request.client_id;
+					g_batch.count = 0;
+					g_batch.failed = false;
+					g_batch.sync_timestamp = request.timestamp;
+					g_batch.sync_status = response.status;
+
+					break;
+
 				case DM_READ:
 
 					g_func_counts[DM_READ]++;
@@ -815,8 +914,10 @@ task_main(int argc, char *argv[])
 
 				}
 
-				response.timestamp = hrt_absolute_time();
-				dataman_response_pub.publish(response);
+				if (respond) {
+					response.timestamp = hrt_absolute_time();
+					dataman_response_pub.publish(response);
+				}
 			}
 		}
 
@@ -874,6 +975,7 @@ status()
 	PX4_INFO("Writes   %u", g_func_counts[DM_WRITE]);
 	PX4_INFO("Reads    %u", g_func_counts[DM_READ]);
 	PX4_INFO("Clears   %u", g_func_counts[DM_CLEAR]);
+	PX4_INFO("Batched  %u writes, %u syncs", g_func_counts[DM_WRITE_BATCH], g_func_counts[DM_SYNC]);
 
 	perf_print_counter(_dm_read_perf);
 	perf_print_counter(_dm_write_perf);
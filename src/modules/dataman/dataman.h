@@ -63,6 +63,8 @@ typedef enum {
 	DM_WRITE,			///< Write index for given item
 	DM_READ,			///< Read index for given item
 	DM_CLEAR,			///< Clear all index for given item
+	DM_WRITE_BATCH,		///< Write index for given item, deferring the flush to DM_SYNC
+	DM_SYNC,			///< Flush batched writes to storage
 	DM_NUMBER_OF_FUNCS
 } dm_function_t;
 
@@ -109,6 +109,10 @@ void LoadMon::Run()
 
 #endif
 
+#if defined(CONFIG_WORK_QUEUE_TIMING)
+	work_item_status();
+#endif /* CONFIG_WORK_QUEUE_TIMING */
+
 	if (should_exit()) {
 		ScheduleClear();
 #if defined (__PX4_LINUX)
@@ -247,6 +251,93 @@ void LoadMon::cpuload()
 #endif
 }
 
+#if defined(CONFIG_WORK_QUEUE_TIMING)
+void LoadMon::work_item_status()
+{
+	_work_item_count = 0;
+	_work_item_reported = 0;
+	_work_item_late = -1;
+
+	px4::WorkQueueManagerTimingStats(&LoadMon::work_item_timing, this);
+
+	// one work item per cycle is published regardless, continue with the next one
+	if (_work_item_count > 0) {
+		_work_item_index = (_work_item_index + 1) % _work_item_count;
+	}
+
+	const hrt_abstime now = hrt_absolute_time();
+
+	for (unsigned i = 0; i < _work_item_reported; i++) {
+		_work_item_reports[i].timestamp = now;
+		_work_item_status_pub.publish(_work_item_reports[i]);
+	}
+
+	if ((_work_item_late >= 0) && (hrt_elapsed_time(&_work_item_warning_time) > 10_s)) {
+		const work_item_status_s &late = _work_item_reports[_work_item_late];
+
+		PX4_WARN("%s (%s) late: lag %" PRIu32 " us, run %" PRIu32 " us, %" PRIu32 " deadline misses",
+			 late.name, late.work_queue, late.lag_max, late.run_time_max, late.deadline_misses);
+
+		/* EVENT
+		 * @description
+		 * A work item started late, ran too long or did not finish before its next scheduled run.
+		 * The work_item_status topic in the log has the details.
+		 *
+		 * <profile name="dev">
+		 * The thresholds are configured with <param>SYS_WQ_LAG_MAX</param> and <param>SYS_WQ_RUN_MAX</param>.
+		 * </profile>
+		 */
+		events::send<uint32_t, uint32_t, uint32_t>(events::ID("load_mon_work_item_late"), events::Log::Warning,
+				"Work item late: lag {1} us, run time {2} us, {3} deadline misses",
+				late.lag_max, late.run_time_max, late.deadline_misses);
+
+		_work_item_warning_time = now;
+	}
+}
+
+bool LoadMon::work_item_timing(const char *wq_name, const char *item_name, const px4::work_item_timing_t &timing,
+			       void *arg)
+{
+	LoadMon *load_mon = static_cast<LoadMon *>(arg);
+
+	const uint32_t lag_max = load_mon->_param_sys_wq_lag_max.get();
+	const uint32_t run_time_max = load_mon->_param_sys_wq_run_max.get();
+
+	const bool late = (timing.deadline_misses > 0)
+			  || ((lag_max > 0) && (timing.lag_max > lag_max))
+			  || ((run_time_max > 0) && (timing.run_time_max > run_time_max));
+
+	const bool next = (load_mon->_work_item_count++ == load_mon->_work_item_index);
+
+	// don't overrun the queue, the logger has to see all of them
+	const bool report = (late || next) && (load_mon->_work_item_reported < work_item_status_s::ORB_QUEUE_LENGTH);
+
+	if (report) {
+		// called with the WorkQueue lists locked, only copy
+		work_item_status_s &work_item_status = load_mon->_work_item_reports[load_mon->_work_item_reported];
+		work_item_status = {};
+		work_item_status.interval = timing.interval;
+		work_item_status.runs = timing.runs;
+		work_item_status.lag_avg = timing.lag_avg;
+		work_item_status.lag_max = timing.lag_max;
+		work_item_status.run_time_avg = timing.run_time_avg;
+		work_item_status.run_time_max = timing.run_time_max;
+		work_item_status.deadline_misses = timing.deadline_misses;
+		strncpy(work_item_status.name, item_name, sizeof(work_item_status.name) - 1);
+		strncpy(work_item_status.work_queue, wq_name, sizeof(work_item_status.work_queue) - 1);
+
+		if (late && (load_mon->_work_item_late < 0)) {
+			load_mon->_work_item_late = load_mon->_work_item_reported;
+		}
+
+		load_mon->_work_item_reported++;
+	}
+
+	// the items that were not reported keep accumulating until their turn
+	return report;
+}
+#endif /* CONFIG_WORK_QUEUE_TIMING */
+
 #if defined(__PX4_NUTTX)
 void LoadMon::stack_usage()
 {
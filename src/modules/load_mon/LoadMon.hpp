@@ -41,12 +41,14 @@
 #include <px4_platform_common/px4_config.h>
 #include <px4_platform_common/defines.h>
 #include <px4_platform_common/module.h>
+#include <px4_platform_common/events.h>
 #include <px4_platform_common/module_params.h>
 #include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
 #include <px4_platform/cpuload.h>
 #include <uORB/Publication.hpp>
 #include <uORB/topics/cpuload.h>
 #include <uORB/topics/task_stack_info.h>
+#include <uORB/topics/work_item_status.h>
 
 #if defined(__PX4_LINUX)
 #include <sys/times.h>
@@ -90,6 +92,24 @@ private:
 
 	uORB::Publication<task_stack_info_s> _task_stack_info_pub{ORB_ID(task_stack_info)};
 #endif
+#if defined(CONFIG_WORK_QUEUE_TIMING)
+	/* Publish the scheduling statistics of the work items, report late ones */
+	void work_item_status();
+
+	static bool work_item_timing(const char *wq_name, const char *item_name, const px4::work_item_timing_t &timing,
+				     void *arg);
+
+	unsigned _work_item_index{0};
+	unsigned _work_item_count{0};
+	unsigned _work_item_reported{0};
+	int _work_item_late{-1}; // first late one of the reports
+	hrt_abstime _work_item_warning_time{0};
+
+	// collected with the WorkQueue lists locked, published after
+	work_item_status_s _work_item_reports[work_item_status_s::ORB_QUEUE_LENGTH] {};
+
+	uORB::Publication<work_item_status_s> _work_item_status_pub{ORB_ID(work_item_status)};
+#endif /* CONFIG_WORK_QUEUE_TIMING */
 	uORB::Publication<cpuload_s> _cpuload_pub {ORB_ID(cpuload)};
 
 #if defined(__PX4_LINUX)
@@ -105,7 +125,9 @@ private:
 	perf_counter_t _cycle_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": cycle")};
 
 	DEFINE_PARAMETERS(
-		(ParamBool<px4::params::SYS_STCK_EN>) _param_sys_stck_en
+		(ParamBool<px4::params::SYS_STCK_EN>) _param_sys_stck_en,
+		(ParamInt<px4::params::SYS_WQ_LAG_MAX>) _param_sys_wq_lag_max,
+		(ParamInt<px4::params::SYS_WQ_RUN_MAX>) _param_sys_wq_run_max
 	)
 };
 
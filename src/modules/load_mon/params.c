@@ -38,3 +38,34 @@
  * @group System
  */
 PARAM_DEFINE_INT32(SYS_STCK_EN, 1);
+
+/**
+ * Work item scheduling lag threshold
+ *
+ * A warning is raised if a work item starts later than this after its release
+ * (its scheduled time or ScheduleNow()). Deadline misses of periodic work items
+ * are always reported. Needs a build with CONFIG_WORK_QUEUE_TIMING.
+ *
+ * Set to 0 to disable.
+ *
+ * @unit us
+ * @min 0
+ * @max 100000
+ * @group System
+ */
+PARAM_DEFINE_INT32(SYS_WQ_LAG_MAX, 0);
+
+/**
+ * Work item run time threshold
+ *
+ * A warning is raised if a single run of a work item takes longer than this.
+ * Needs a build with CONFIG_WORK_QUEUE_TIMING.
+ *
+ * Set to 0 to disable.
+ *
+ * @unit us
+ * @min 0
+ * @max 100000
+ * @group System
+ */
+PARAM_DEFINE_INT32(SYS_WQ_RUN_MAX, 0);
@@ -0,0 +1,236 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "log_compressor.h"
+
+#include <string.h>
+
+namespace px4
+{
+namespace logger
+{
+
+namespace
+{
+
+constexpr size_t MIN_MATCH = 4;
+constexpr size_t LAST_LITERALS = 5; ///< the last bytes of a block are always literals
+constexpr size_t MF_LIMIT = 12; ///< a match has to start at least this far from the end of the block
+constexpr size_t MAX_OFFSET = 65535;
+
+inline uint32_t read32(const uint8_t *p)
+{
+	uint32_t value;
+	memcpy(&value, p, sizeof(value));
+	return value;
+}
+
+inline uint32_t hash(uint32_t sequence, int bits)
+{
+	return (sequence * 2654435761u) >> (32 - bits);
+}
+
+/** write the part of a length that does not fit into the 4 bit token field */
+inline uint8_t *write_length(uint8_t *op, size_t length)
+{
+	while (length >= 255) {
+		*op++ = 255;
+		length -= 255;
+	}
+
+	*op++ = (uint8_t)length;
+	return op;
+}
+
+inline uint8_t *write_literals(uint8_t *op, uint8_t *token, const uint8_t *literals, size_t length)
+{
+	*token = (uint8_t)((length >= 15 ? 15 : length) << 4);
+
+	if (length >= 15) {
+		op = write_length(op, length - 15);
+	}
+
+	memcpy(op, literals, length);
+	return op + length;
+}
+
+inline bool read_length(const uint8_t *src, size_t size, size_t &ip, size_t &length)
+{
+	uint8_t b;
+
+	do {
+		if (ip >= size) {
+			return false;
+		}
+
+		b = src[ip++];
+		length += b;
+	} while (b == 255);
+
+	return true;
+}
+
+} // namespace
+
+size_t LogCompressor::compress(const uint8_t *src, size_t size, uint8_t *dst, size_t dst_size)
+{
+	static_assert(BLOCK_SIZE <= MAX_OFFSET + 1, "hash table stores 16 bit positions");
+
+	if (size > BLOCK_SIZE || dst_size < compress_bound(size)) {
+		return 0;
+	}
+
+	uint8_t *op = dst;
+	size_t anchor = 0;
+
+	if (size > MF_LIMIT) {
+		const size_t match_limit = size - LAST_LITERALS;
+		const size_t mf_limit = size - MF_LIMIT;
+
+		// stale entries are harmless (every candidate is verified), but would make the output depend on
+		// previous blocks
+		memset(_hash_table, 0, sizeof(_hash_table));
+
+		size_t ip = 1;
+
+		while (ip <= mf_limit) {
+			const uint32_t sequence = read32(src + ip);
+			const uint32_t h = hash(sequence, HASH_BITS);
+			size_t ref = _hash_table[h];
+			_hash_table[h] = (uint16_t)ip;
+
+			if (ref >= ip || read32(src + ref) != sequence) {
+				// step faster the longer nothing matched (incompressible data)
+				ip += 1 + ((ip - anchor) >> 6);
+				continue;
+			}
+
+			// extend the match backwards into the pending literals, then forwards
+			while (ip > anchor && ref > 0 && src[ip - 1] == src[ref - 1]) {
+				--ip;
+				--ref;
+			}
+
+			size_t match_length = MIN_MATCH;
+
+			while (ip + match_length < match_limit && src[ip + match_length] == src[ref + match_length]) {
+				++match_length;
+			}
+
+			// sequence: token, literals, offset, match length
+			uint8_t *token = op++;
+			op = write_literals(op, token, src + anchor, ip - anchor);
+
+			const size_t offset = ip - ref;
+			*op++ = (uint8_t)(offset & 0xff);
+			*op++ = (uint8_t)(offset >> 8);
+
+			const size_t length_code = match_length - MIN_MATCH;
+			*token |= (uint8_t)(length_code >= 15 ? 15 : length_code);
+
+			if (length_code >= 15) {
+				op = write_length(op, length_code - 15);
+			}
+
+			ip += match_length;
+			anchor = ip;
+
+			// the position right before the next search is a cheap extra candidate
+			_hash_table[hash(read32(src + ip - 2), HASH_BITS)] = (uint16_t)(ip - 2);
+		}
+	}
+
+	// the last sequence only has literals
+	uint8_t *token = op++;
+	op = write_literals(op, token, src + anchor, size - anchor);
+
+	return op - dst;
+}
+
+int LogCompressor::decompress(const uint8_t *src, size_t size, uint8_t *dst, size_t dst_size)
+{
+	size_t ip = 0;
+	size_t op = 0;
+
+	while (ip < size) {
+		const uint8_t token = src[ip++];
+
+		size_t literal_length = token >> 4;
+
+		if (literal_length == 15 && !read_length(src, size, ip, literal_length)) {
+			return -1;
+		}
+
+		if (literal_length > size - ip || literal_length > dst_size - op) {
+			return -1;
+		}
+
+		memcpy(dst + op, src + ip, literal_length);
+		ip += literal_length;
+		op += literal_length;
+
+		if (ip == size) {
+			break; // last sequence
+		}
+
+		if (size - ip < 2) {
+			return -1;
+		}
+
+		const size_t offset = src[ip] | (src[ip + 1] << 8);
+		ip += 2;
+
+		size_t match_length = token & 0xf;
+
+		if (match_length == 15 && !read_length(src, size, ip, match_length)) {
+			return -1;
+		}
+
+		match_length += MIN_MATCH;
+
+		if (offset == 0 || offset > op || match_length > dst_size - op) {
+			return -1;
+		}
+
+		// byte by byte: the match can overlap with its own output
+		for (size_t i = 0; i < match_length; ++i, ++op) {
+			dst[op] = dst[op - offset];
+		}
+	}
+
+	return (int)op;
+}
+
+} // namespace logger
+} // namespace px4
@@ -1,6 +1,6 @@
 /****************************************************************************
  *
- *   Copyright (c) 2022 PX4 Development Team. All rights reserved.
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted provided that the following conditions
@@ -31,6 +31,48 @@
  *
  ****************************************************************************/
 
-float newton_leibniz_solve(void) {
-	return 0;
-}
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace px4
+{
+namespace logger
+{
+
+/**
+ * @class LogCompressor
+ * Block compressor for the log writer, producing the LZ4 block format.
+ * Blocks are independent (no dictionary carried over), which keeps compressed logs seekable.
+ */
+class LogCompressor
+{
+public:
+	/** maximum number of uncompressed bytes per block (offsets are limited to 16 bits) */
+	static constexpr size_t BLOCK_SIZE = 8192;
+
+	/** worst case output size for a block of size bytes */
+	static constexpr size_t compress_bound(size_t size) { return size + size / 255 + 16; }
+
+	/**
+	 * Compress a block of at most BLOCK_SIZE bytes
+	 * @return number of bytes written to dst, 0 if the result does not fit into dst_size
+	 */
+	size_t compress(const uint8_t *src, size_t size, uint8_t *dst, size_t dst_size);
+
+	/**
+	 * Decompress a block
+	 * @return number of bytes written to dst, or -1 if the block is malformed or does not fit into dst_size
+	 */
+	static int decompress(const uint8_t *src, size_t size, uint8_t *dst, size_t dst_size);
+
+private:
+	static constexpr int HASH_BITS = 12;
+
+	uint16_t _hash_table[1 << HASH_BITS];
+};
+
+} // namespace logger
+} // namespace px4
@@ -0,0 +1,144 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * Test code for the log compressor
+ * Run this test only using make tests TESTFILTER=log_compressor
+ */
+
+#include <gtest/gtest.h>
+#include <string.h>
+
+#include "log_compressor.h"
+
+using namespace px4::logger;
+
+class LogCompressorTest : public ::testing::Test
+{
+public:
+	// compress, decompress and compare, returns the compressed size
+	size_t roundtrip(const uint8_t *data, size_t size)
+	{
+		uint8_t compressed[LogCompressor::compress_bound(LogCompressor::BLOCK_SIZE)];
+		uint8_t decompressed[LogCompressor::BLOCK_SIZE];
+
+		const size_t compressed_size = _compressor.compress(data, size, compressed, sizeof(compressed));
+		EXPECT_GT(compressed_size, 0u);
+		EXPECT_LE(compressed_size, LogCompressor::compress_bound(size));
+
+		const int decompressed_size = LogCompressor::decompress(compressed, compressed_size, decompressed,
+					      sizeof(decompressed));
+		EXPECT_EQ(decompressed_size, (int)size);
+		EXPECT_EQ(memcmp(data, decompressed, size), 0);
+
+		return compressed_size;
+	}
+
+	LogCompressor _compressor;
+	uint8_t _data[LogCompressor::BLOCK_SIZE];
+};
+
+TEST_F(LogCompressorTest, SmallBlocks)
+{
+	for (size_t size = 0; size < 40; ++size) {
+		memset(_data, 'a', size);
+		roundtrip(_data, size);
+	}
+}
+
+TEST_F(LogCompressorTest, Repetitive)
+{
+	// ULog-like data: fixed message headers with slowly changing payload
+	for (size_t i = 0; i < sizeof(_data); ++i) {
+		_data[i] = (i % 48 < 8) ? (uint8_t)(i % 48) : (uint8_t)((i / 48) * (i % 7));
+	}
+
+	const size_t compressed_size = roundtrip(_data, sizeof(_data));
+	EXPECT_LT(compressed_size, sizeof(_data) / 2);
+
+	memset(_data, 0, sizeof(_data));
+	EXPECT_LT(roundtrip(_data, sizeof(_data)), 64u);
+}
+
+TEST_F(LogCompressorTest, Incompressible)
+{
+	uint32_t state = 0x12345678;
+
+	for (size_t i = 0; i < sizeof(_data); ++i) {
+		state = state * 1664525u + 1013904223u;
+		_data[i] = (uint8_t)(state >> 24);
+	}
+
+	roundtrip(_data, sizeof(_data));
+}
+
+TEST_F(LogCompressorTest, IndependentBlocks)
+{
+	// the same input has to give the same output, regardless of what was compressed before
+	uint8_t first[LogCompressor::compress_bound(LogCompressor::BLOCK_SIZE)];
+	uint8_t second[LogCompressor::compress_bound(LogCompressor::BLOCK_SIZE)];
+
+	for (size_t i = 0; i < sizeof(_data); ++i) {
+		_data[i] = (uint8_t)(i * i);
+	}
+
+	const size_t first_size = _compressor.compress(_data, 1000, first, sizeof(first));
+	_compressor.compress(_data + 1000, 5000, second, sizeof(second));
+	const size_t second_size = _compressor.compress(_data, 1000, second, sizeof(second));
+
+	ASSERT_EQ(first_size, second_size);
+	EXPECT_EQ(memcmp(first, second, first_size), 0);
+}
+
+TEST_F(LogCompressorTest, Malformed)
+{
+	uint8_t decompressed[64];
+
+	// match offset before the start of the output
+	const uint8_t bad_offset[] = {0x10, 'a', 0x05, 0x00, 0x10, 'b'};
+	EXPECT_EQ(LogCompressor::decompress(bad_offset, sizeof(bad_offset), decompressed, sizeof(decompressed)), -1);
+
+	// truncated literals
+	const uint8_t truncated[] = {0x50, 'a', 'b'};
+	EXPECT_EQ(LogCompressor::decompress(truncated, sizeof(truncated), decompressed, sizeof(decompressed)), -1);
+
+	// output does not fit
+	uint8_t compressed[LogCompressor::compress_bound(LogCompressor::BLOCK_SIZE)];
+	memset(_data, 'x', 200);
+	const size_t compressed_size = _compressor.compress(_data, 200, compressed, sizeof(compressed));
+	EXPECT_EQ(LogCompressor::decompress(compressed, compressed_size, decompressed, sizeof(decompressed)), -1);
+
+	// too small output buffer for the compressor
+	EXPECT_EQ(_compressor.compress(_data, 200, compressed, 100), 0u);
+}
@@ -0,0 +1,141 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "log_index.h"
+
+#include <string.h>
+
+namespace px4
+{
+namespace logger
+{
+
+void LogIndex::start(uint64_t now, uint64_t offset)
+{
+	_bucket_count = 0;
+	_dir_stride = 1;
+	_previous = 0;
+
+	ulog_index_dir_header_s &dir = directory_header();
+	dir.version = 1;
+	dir.interval_ms = INTERVAL_MS;
+	dir.num_entries = 0;
+
+	_bucket_start = now;
+	ulog_index_bucket_s &bucket = bucket_header();
+	bucket.timestamp = now;
+	bucket.offset = offset;
+	bucket.previous = 0;
+	bucket.num_entries = 0;
+	memset(_seen, 0, sizeof(_seen));
+}
+
+void LogIndex::add(uint16_t msg_id, uint64_t offset)
+{
+	if (msg_id >= MAX_MSG_IDS || (_seen[msg_id / 32] & (1u << (msg_id % 32)))) {
+		return;
+	}
+
+	_seen[msg_id / 32] |= 1u << (msg_id % 32);
+
+	ulog_index_bucket_s &bucket = bucket_header();
+	ulog_index_entry_s entry;
+	entry.msg_id = msg_id;
+	entry.offset = offset - bucket.offset;
+	memcpy(_bucket + sizeof(ulog_index_bucket_s) + bucket.num_entries * sizeof(ulog_index_entry_s), &entry,
+	       sizeof(entry));
+	++bucket.num_entries;
+}
+
+void LogIndex::add_message(const uint8_t *msg, uint64_t offset)
+{
+	if (msg[2] == static_cast<uint8_t>(ULogMessageType::DATA)) {
+		add(msg[3] | (msg[4] << 8), offset);
+	}
+}
+
+size_t LogIndex::bucket_size() const
+{
+	return sizeof(ulog_index_bucket_s) + bucket_header().num_entries * sizeof(ulog_index_entry_s);
+}
+
+void LogIndex::next_bucket(uint64_t now, uint64_t bucket_offset, uint64_t offset)
+{
+	ulog_index_dir_header_s &dir = directory_header();
+	ulog_index_dir_entry_s *entries = reinterpret_cast<ulog_index_dir_entry_s *>(_directory +
+					  sizeof(ulog_index_dir_header_s));
+
+	if (bucket_offset != 0 && _bucket_count % _dir_stride == 0) {
+		if (dir.num_entries == MAX_DIR_ENTRIES) {
+			// full: keep every other entry
+			for (uint32_t i = 0; i < dir.num_entries / 2; ++i) {
+				memmove(&entries[i], &entries[2 * i], sizeof(ulog_index_dir_entry_s));
+			}
+
+			dir.num_entries /= 2;
+			_dir_stride *= 2;
+			dir.interval_ms = INTERVAL_MS * _dir_stride;
+		}
+
+		if (_bucket_count % _dir_stride == 0) {
+			ulog_index_dir_entry_s entry;
+			entry.timestamp = bucket_header().timestamp;
+			entry.offset = bucket_offset;
+			memcpy(&entries[dir.num_entries], &entry, sizeof(entry));
+			++dir.num_entries;
+		}
+	}
+
+	++_bucket_count;
+
+	if (bucket_offset != 0) {
+		_previous = bucket_offset;
+	}
+
+	_bucket_start = now;
+	ulog_index_bucket_s &bucket = bucket_header();
+	bucket.timestamp = now;
+	bucket.offset = offset;
+	bucket.previous = _previous;
+	bucket.num_entries = 0;
+	memset(_seen, 0, sizeof(_seen));
+}
+
+size_t LogIndex::directory_size() const
+{
+	return sizeof(ulog_index_dir_header_s) + directory_header().num_entries * sizeof(ulog_index_dir_entry_s);
+}
+
+} // namespace logger
+} // namespace px4
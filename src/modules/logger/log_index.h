@@ -0,0 +1,114 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "messages.h"
+
+namespace px4
+{
+namespace logger
+{
+
+/**
+ * @class LogIndex
+ * Collects the log index (@see ulog_index_bucket_s): for every interval the file offset of the first message of each
+ * topic. The bucket of an interval is written to the log at the end of the interval, and the directory of all
+ * buckets on close. The directory has a fixed capacity: when it is full, every other entry is dropped and the
+ * directory interval doubles. Each bucket links to the previous one, so the dropped ones can still be found.
+ */
+class LogIndex
+{
+public:
+	static constexpr uint32_t INTERVAL_MS = 1000;
+	static constexpr int MAX_MSG_IDS = 256;
+	static constexpr int MAX_DIR_ENTRIES = 512;
+
+	/**
+	 * Start a new log
+	 * @param now current time [us]
+	 * @param offset current file offset
+	 */
+	void start(uint64_t now, uint64_t offset);
+
+	/** record a data message */
+	void add(uint16_t msg_id, uint64_t offset);
+
+	/**
+	 * Record a message written to the file, only data messages are indexed
+	 * @param msg ulog message, including the header
+	 * @param offset file offset of the message
+	 */
+	void add_message(const uint8_t *msg, uint64_t offset);
+
+	bool interval_elapsed(uint64_t now) const { return now >= _bucket_start + INTERVAL_MS * 1000; }
+
+	/** the serialized bucket of the current interval */
+	const uint8_t *bucket() const { return _bucket; }
+	size_t bucket_size() const;
+
+	/**
+	 * Add the current bucket to the directory and start the next interval
+	 * @param now current time [us]
+	 * @param bucket_offset file offset of the written bucket message, 0 if it could not be written
+	 * @param offset current file offset (after the bucket)
+	 */
+	void next_bucket(uint64_t now, uint64_t bucket_offset, uint64_t offset);
+
+	/** the serialized directory */
+	const uint8_t *directory() const { return _directory; }
+	size_t directory_size() const;
+
+private:
+	ulog_index_bucket_s &bucket_header() { return *reinterpret_cast<ulog_index_bucket_s *>(_bucket); }
+	const ulog_index_bucket_s &bucket_header() const { return *reinterpret_cast<const ulog_index_bucket_s *>(_bucket); }
+	ulog_index_dir_header_s &directory_header() { return *reinterpret_cast<ulog_index_dir_header_s *>(_directory); }
+	const ulog_index_dir_header_s &directory_header() const { return *reinterpret_cast<const ulog_index_dir_header_s *>(_directory); }
+
+	uint64_t _bucket_start{0};
+	uint32_t _bucket_count{0}; ///< number of buckets since the start of the log
+	uint32_t _dir_stride{1}; ///< every _dir_stride'th bucket is in the directory
+	uint64_t _previous{0}; ///< file offset of the last written bucket message
+
+	uint32_t _seen[MAX_MSG_IDS / 32] {}; ///< msg ids in the current bucket
+
+	uint8_t _bucket[sizeof(ulog_index_bucket_s) + MAX_MSG_IDS * sizeof(ulog_index_entry_s)];
+	uint8_t _directory[sizeof(ulog_index_dir_header_s) + MAX_DIR_ENTRIES * sizeof(ulog_index_dir_entry_s)];
+};
+
+} // namespace logger
+} // namespace px4
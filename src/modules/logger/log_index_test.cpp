@@ -0,0 +1,207 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * Test code for the log index
+ * Run this test only using make tests TESTFILTER=log_index
+ */
+
+#include <gtest/gtest.h>
+#include <string.h>
+
+#include "log_index.h"
+
+using namespace px4::logger;
+
+static constexpr uint64_t S = 1000000;
+
+static ulog_index_bucket_s bucket_header(const LogIndex &index)
+{
+	ulog_index_bucket_s header;
+	memcpy(&header, index.bucket(), sizeof(header));
+	return header;
+}
+
+static ulog_index_entry_s bucket_entry(const LogIndex &index, int i)
+{
+	ulog_index_entry_s entry;
+	memcpy(&entry, index.bucket() + sizeof(ulog_index_bucket_s) + i * sizeof(entry), sizeof(entry));
+	return entry;
+}
+
+static ulog_index_dir_header_s dir_header(const LogIndex &index)
+{
+	ulog_index_dir_header_s header;
+	memcpy(&header, index.directory(), sizeof(header));
+	return header;
+}
+
+static ulog_index_dir_entry_s dir_entry(const LogIndex &index, int i)
+{
+	ulog_index_dir_entry_s entry;
+	memcpy(&entry, index.directory() + sizeof(ulog_index_dir_header_s) + i * sizeof(entry), sizeof(entry));
+	return entry;
+}
+
+TEST(LogIndexTest, FirstOffsetPerTopic)
+{
+	LogIndex index;
+	index.start(10 * S, 5000);
+
+	index.add(3, 5100);
+	index.add(7, 5200);
+	index.add(3, 5300); // not the first
+	index.add(0, 5400);
+
+	ulog_index_bucket_s header = bucket_header(index);
+	EXPECT_EQ(header.timestamp, 10 * S);
+	EXPECT_EQ(header.offset, 5000u);
+	EXPECT_EQ(header.previous, 0u);
+	ASSERT_EQ(header.num_entries, 3);
+	EXPECT_EQ(index.bucket_size(), sizeof(ulog_index_bucket_s) + 3 * sizeof(ulog_index_entry_s));
+
+	EXPECT_EQ(bucket_entry(index, 0).msg_id, 3);
+	EXPECT_EQ(bucket_entry(index, 0).offset, 100u);
+	EXPECT_EQ(bucket_entry(index, 1).msg_id, 7);
+	EXPECT_EQ(bucket_entry(index, 1).offset, 200u);
+	EXPECT_EQ(bucket_entry(index, 2).msg_id, 0);
+	EXPECT_EQ(bucket_entry(index, 2).offset, 400u);
+}
+
+TEST(LogIndexTest, DataMessagesOnly)
+{
+	LogIndex index;
+	index.start(10 * S, 5000);
+
+	// msg_size, msg_type, msg_id
+	const uint8_t data[] = {2, 0, static_cast<uint8_t>(ULogMessageType::DATA), 0x05, 0x00};
+	const uint8_t logging[] = {2, 0, static_cast<uint8_t>(ULogMessageType::LOGGING), 0x05, 0x00};
+	const uint8_t info[] = {2, 0, static_cast<uint8_t>(ULogMessageType::INFO_MULTIPLE), 0x05, 0x00};
+
+	index.add_message(logging, 5100);
+	index.add_message(info, 5200);
+	index.add_message(data, 5300);
+
+	ASSERT_EQ(bucket_header(index).num_entries, 1);
+	EXPECT_EQ(bucket_entry(index, 0).msg_id, 5);
+	EXPECT_EQ(bucket_entry(index, 0).offset, 300u);
+}
+
+TEST(LogIndexTest, Intervals)
+{
+	LogIndex index;
+	index.start(10 * S, 5000);
+	index.add(3, 5100);
+
+	EXPECT_FALSE(index.interval_elapsed(10 * S + LogIndex::INTERVAL_MS * 1000 - 1));
+	EXPECT_TRUE(index.interval_elapsed(10 * S + LogIndex::INTERVAL_MS * 1000));
+
+	index.next_bucket(11 * S, 6000, 6100);
+
+	// new bucket, msg id 3 is recorded again
+	index.add(3, 6300);
+	ulog_index_bucket_s header = bucket_header(index);
+	EXPECT_EQ(header.timestamp, 11 * S);
+	EXPECT_EQ(header.offset, 6100u);
+	EXPECT_EQ(header.previous, 6000u);
+	ASSERT_EQ(header.num_entries, 1);
+	EXPECT_EQ(bucket_entry(index, 0).offset, 200u);
+
+	ulog_index_dir_header_s dir = dir_header(index);
+	EXPECT_EQ(dir.version, 1);
+	EXPECT_EQ(dir.interval_ms, LogIndex::INTERVAL_MS);
+	ASSERT_EQ(dir.num_entries, 1u);
+	EXPECT_EQ(dir_entry(index, 0).timestamp, 10 * S);
+	EXPECT_EQ(dir_entry(index, 0).offset, 6000u);
+	EXPECT_EQ(index.directory_size(), sizeof(ulog_index_dir_header_s) + sizeof(ulog_index_dir_entry_s));
+}
+
+TEST(LogIndexTest, DirectoryCoarsening)
+{
+	LogIndex index;
+	index.start(0, 0);
+
+	const int num_buckets = LogIndex::MAX_DIR_ENTRIES * 2 + 3;
+
+	for (int i = 0; i < num_buckets; ++i) {
+		index.next_bucket((i + 1) * S, i * 1000 + 900, (i + 1) * 1000);
+	}
+
+	ulog_index_dir_header_s dir = dir_header(index);
+	EXPECT_EQ(dir.interval_ms, LogIndex::INTERVAL_MS * 4);
+	ASSERT_LE(dir.num_entries, (uint32_t)LogIndex::MAX_DIR_ENTRIES);
+
+	// every 4th bucket, in order
+	for (uint32_t i = 0; i < dir.num_entries; ++i) {
+		EXPECT_EQ(dir_entry(index, i).timestamp, i * 4 * S);
+		EXPECT_EQ(dir_entry(index, i).offset, i * 4 * 1000 + 900);
+	}
+
+	EXPECT_EQ(dir.num_entries, (uint32_t)(num_buckets + 3) / 4);
+}
+
+TEST(LogIndexTest, DroppedBucket)
+{
+	LogIndex index;
+	index.start(0, 0);
+	index.next_bucket(1 * S, 900, 1000);
+	index.next_bucket(2 * S, 0, 2000);
+	index.next_bucket(3 * S, 2900, 3000);
+
+	ulog_index_dir_header_s dir = dir_header(index);
+	ASSERT_EQ(dir.num_entries, 2u);
+	EXPECT_EQ(dir_entry(index, 0).offset, 900u);
+	EXPECT_EQ(dir_entry(index, 1).timestamp, 2 * S);
+	EXPECT_EQ(dir_entry(index, 1).offset, 2900u);
+
+	// the chain of buckets skips the dropped one
+	EXPECT_EQ(bucket_header(index).previous, 2900u);
+	index.next_bucket(4 * S, 0, 4000);
+	EXPECT_EQ(bucket_header(index).previous, 2900u);
+}
+
+TEST(LogIndexTest, Restart)
+{
+	LogIndex index;
+	index.start(0, 0);
+	index.add(1, 10);
+	index.next_bucket(1 * S, 100, 200);
+
+	index.start(50 * S, 0);
+	EXPECT_EQ(bucket_header(index).num_entries, 0);
+	EXPECT_EQ(bucket_header(index).previous, 0u);
+	EXPECT_EQ(dir_header(index).num_entries, 0u);
+	index.add(1, 10);
+	EXPECT_EQ(bucket_header(index).num_entries, 1);
+}
@@ -0,0 +1,125 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "log_rate_governor.h"
+
+namespace px4
+{
+namespace logger
+{
+
+void LogRateGovernor::reset()
+{
+	_level = 0;
+	_last_change = 0;
+	_low_fill_start = 0;
+	_throughput_start = 0;
+	_throughput_start_written = 0;
+	_throughput_start_fill = 0;
+	_throughput_saturated = false;
+	_throughput = 0.f;
+	_incoming_rate = 0.f;
+	_capacity = 0.f;
+}
+
+bool LogRateGovernor::update(uint64_t now, size_t fill_count, size_t buffer_size, size_t total_written)
+{
+	if (buffer_size == 0) {
+		return false;
+	}
+
+	const float fill = (float)fill_count / buffer_size;
+
+	if (_throughput_start == 0 || total_written < _throughput_start_written) {
+		_throughput_start = now;
+		_throughput_start_written = total_written;
+		_throughput_start_fill = fill_count;
+		_throughput_saturated = false;
+
+	} else if (now - _throughput_start >= 1000000) {
+		const float dt = (now - _throughput_start) * 1e-6f;
+		const size_t written = total_written - _throughput_start_written;
+		_throughput = written / dt;
+
+		// everything added to the buffer was either written or is still in the buffer
+		const float incoming = ((float)written + (float)fill_count - (float)_throughput_start_fill) / dt;
+		_incoming_rate = incoming > 0.f ? incoming : 0.f;
+
+		if (_throughput_saturated) {
+			_capacity = _throughput;
+		}
+
+		_throughput_start = now;
+		_throughput_start_written = total_written;
+		_throughput_start_fill = fill_count;
+		_throughput_saturated = false;
+	}
+
+	if (fill >= HIGH_FILL) {
+		_throughput_saturated = true;
+	}
+
+	if (fill > LOW_FILL) {
+		_low_fill_start = 0;
+
+	} else if (_low_fill_start == 0) {
+		_low_fill_start = now;
+	}
+
+	if (fill >= HIGH_FILL) {
+		// the storage does not keep up: reduce, but give each step time to show an effect
+		if (_level < MAX_LEVEL && (_last_change == 0 || now - _last_change >= THROTTLE_HOLD_US)) {
+			++_level;
+			_last_change = now;
+			return true;
+		}
+
+	} else if (_level > 0 && _low_fill_start != 0 && now - _low_fill_start >= RECOVERY_TIME_US
+		   && now - _last_change >= RECOVERY_TIME_US) {
+		// the restored rates must fit into the capacity, otherwise the buffer fills up again right away.
+		// Without a measured capacity, only the fill level decides.
+		if (_capacity > 0.f && 2.f * _incoming_rate > _capacity) {
+			return false;
+		}
+
+		--_level;
+		_last_change = now;
+		return true;
+	}
+
+	return false;
+}
+
+} // namespace logger
+} // namespace px4
@@ -0,0 +1,106 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace px4
+{
+namespace logger
+{
+
+/**
+ * @class LogRateGovernor
+ * Decides how much the logging rates of low-priority topics are reduced, based on the fill level of the
+ * write buffer: the rates are halved step by step while the buffer fills up (i.e. the storage does not keep up),
+ * and restored step by step once the buffer stayed drained for a while.
+ *
+ * The write throughput measured while the buffer was full is the capacity of the storage. A restore step at most
+ * doubles the incoming data rate, so it is only taken if twice the current incoming rate fits into that capacity.
+ */
+class LogRateGovernor
+{
+public:
+	static constexpr int MAX_LEVEL = 3; ///< intervals are scaled by up to 2^MAX_LEVEL
+
+	static constexpr float HIGH_FILL = 0.5f; ///< buffer fill ratio above which the rates are reduced
+	static constexpr float LOW_FILL = 0.1f; ///< buffer fill ratio below which the rates can be restored
+
+	static constexpr uint64_t THROTTLE_HOLD_US = 1000000; ///< minimum time between two reductions
+	static constexpr uint64_t RECOVERY_TIME_US = 5000000; ///< time below LOW_FILL before a restore step
+
+	void reset();
+
+	/**
+	 * Call periodically while logging
+	 * @param now current time [us]
+	 * @param fill_count bytes in the write buffer
+	 * @param buffer_size size of the write buffer
+	 * @param total_written bytes written to the file so far
+	 * @return true if the level changed
+	 */
+	bool update(uint64_t now, size_t fill_count, size_t buffer_size, size_t total_written);
+
+	int level() const { return _level; }
+
+	/** factor for the logging intervals of low-priority topics */
+	uint32_t interval_factor() const { return 1u << _level; }
+
+	/** measured write throughput [bytes/s] */
+	float throughput() const { return _throughput; }
+
+	/** measured rate of data added to the write buffer [bytes/s] */
+	float incoming_rate() const { return _incoming_rate; }
+
+	/** write throughput measured while the buffer was full [bytes/s] (0 = not measured yet) */
+	float capacity() const { return _capacity; }
+
+private:
+	int _level{0};
+	uint64_t _last_change{0};
+	uint64_t _low_fill_start{0}; ///< start of the current low fill period (0 = fill is not low)
+
+	uint64_t _throughput_start{0};
+	size_t _throughput_start_written{0};
+	size_t _throughput_start_fill{0};
+	bool _throughput_saturated{false}; ///< the buffer was full during the current measurement window
+	float _throughput{0.f};
+	float _incoming_rate{0.f};
+	float _capacity{0.f};
+};
+
+} // namespace logger
+} // namespace px4
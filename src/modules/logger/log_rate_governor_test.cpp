@@ -0,0 +1,165 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * Test code for the log rate governor
+ * Run this test only using make tests TESTFILTER=log_rate_governor
+ */
+
+#include <gtest/gtest.h>
+
+#include "log_rate_governor.h"
+
+using namespace px4::logger;
+
+static constexpr size_t BUFFER_SIZE = 10000;
+static constexpr uint64_t MS = 1000;
+
+TEST(LogRateGovernorTest, NoChangeWithLowFill)
+{
+	LogRateGovernor governor;
+
+	for (uint64_t t = 1; t < 20000; t += 100) {
+		EXPECT_FALSE(governor.update(t * MS, BUFFER_SIZE / 4, BUFFER_SIZE, t * 100));
+	}
+
+	EXPECT_EQ(governor.level(), 0);
+	EXPECT_EQ(governor.interval_factor(), 1u);
+}
+
+TEST(LogRateGovernorTest, ReducesStepwise)
+{
+	LogRateGovernor governor;
+
+	EXPECT_TRUE(governor.update(1000 * MS, BUFFER_SIZE * 6 / 10, BUFFER_SIZE, 0));
+	EXPECT_EQ(governor.interval_factor(), 2u);
+
+	// held until the previous step had time to take effect
+	EXPECT_FALSE(governor.update(1500 * MS, BUFFER_SIZE * 9 / 10, BUFFER_SIZE, 0));
+	EXPECT_EQ(governor.level(), 1);
+
+	EXPECT_TRUE(governor.update(2000 * MS, BUFFER_SIZE * 9 / 10, BUFFER_SIZE, 0));
+	EXPECT_TRUE(governor.update(3000 * MS, BUFFER_SIZE * 9 / 10, BUFFER_SIZE, 0));
+	EXPECT_EQ(governor.interval_factor(), 8u);
+
+	// limited
+	EXPECT_FALSE(governor.update(4000 * MS, BUFFER_SIZE, BUFFER_SIZE, 0));
+	EXPECT_EQ(governor.level(), LogRateGovernor::MAX_LEVEL);
+}
+
+TEST(LogRateGovernorTest, RestoresAfterRecovery)
+{
+	LogRateGovernor governor;
+
+	EXPECT_TRUE(governor.update(1000 * MS, BUFFER_SIZE, BUFFER_SIZE, 0));
+	EXPECT_TRUE(governor.update(2000 * MS, BUFFER_SIZE, BUFFER_SIZE, 0));
+	EXPECT_EQ(governor.level(), 2);
+
+	// in between the thresholds: keep the level
+	EXPECT_FALSE(governor.update(10000 * MS, BUFFER_SIZE * 3 / 10, BUFFER_SIZE, 0));
+
+	// drained, but not for long enough
+	EXPECT_FALSE(governor.update(11000 * MS, 0, BUFFER_SIZE, 0));
+	EXPECT_FALSE(governor.update(15000 * MS, 0, BUFFER_SIZE, 0));
+	EXPECT_TRUE(governor.update(16000 * MS, 0, BUFFER_SIZE, 0));
+	EXPECT_EQ(governor.level(), 1);
+
+	// one step at a time
+	EXPECT_FALSE(governor.update(17000 * MS, 0, BUFFER_SIZE, 0));
+	EXPECT_TRUE(governor.update(21000 * MS, 0, BUFFER_SIZE, 0));
+	EXPECT_EQ(governor.level(), 0);
+	EXPECT_FALSE(governor.update(30000 * MS, 0, BUFFER_SIZE, 0));
+}
+
+TEST(LogRateGovernorTest, FillInterruptsRecovery)
+{
+	LogRateGovernor governor;
+
+	EXPECT_TRUE(governor.update(1000 * MS, BUFFER_SIZE, BUFFER_SIZE, 0));
+	EXPECT_FALSE(governor.update(7000 * MS, 0, BUFFER_SIZE, 0));
+	EXPECT_FALSE(governor.update(10000 * MS, BUFFER_SIZE * 2 / 10, BUFFER_SIZE, 0));
+	EXPECT_FALSE(governor.update(11000 * MS, 0, BUFFER_SIZE, 0));
+	EXPECT_FALSE(governor.update(15000 * MS, 0, BUFFER_SIZE, 0));
+	EXPECT_TRUE(governor.update(16000 * MS, 0, BUFFER_SIZE, 0));
+	EXPECT_EQ(governor.level(), 0);
+}
+
+TEST(LogRateGovernorTest, CapacityLimitsRestore)
+{
+	LogRateGovernor governor;
+
+	// the storage writes 100 KB/s while the buffer is full
+	EXPECT_TRUE(governor.update(1000 * MS, BUFFER_SIZE, BUFFER_SIZE, 0));
+	EXPECT_TRUE(governor.update(2000 * MS, BUFFER_SIZE, BUFFER_SIZE, 100000));
+	EXPECT_FLOAT_EQ(governor.capacity(), 100000.f);
+
+	EXPECT_FALSE(governor.update(3000 * MS, 0, BUFFER_SIZE, 200000));
+	EXPECT_FLOAT_EQ(governor.capacity(), 100000.f);
+
+	// drained, but doubling 60 KB/s would not fit
+	size_t written = 200000;
+
+	for (uint64_t t = 4000; t <= 10000; t += 1000) {
+		written += 60000;
+		EXPECT_FALSE(governor.update(t * MS, 0, BUFFER_SIZE, written));
+	}
+
+	EXPECT_FLOAT_EQ(governor.incoming_rate(), 60000.f);
+	EXPECT_EQ(governor.level(), 2);
+
+	// doubling 40 KB/s does
+	written += 40000;
+	EXPECT_TRUE(governor.update(11000 * MS, 0, BUFFER_SIZE, written));
+	EXPECT_EQ(governor.level(), 1);
+}
+
+TEST(LogRateGovernorTest, Throughput)
+{
+	LogRateGovernor governor;
+
+	governor.update(1000 * MS, 0, BUFFER_SIZE, 0);
+	governor.update(1500 * MS, 0, BUFFER_SIZE, 50000);
+	EXPECT_FLOAT_EQ(governor.throughput(), 0.f);
+	governor.update(3000 * MS, 0, BUFFER_SIZE, 200000);
+	EXPECT_FLOAT_EQ(governor.throughput(), 100000.f);
+
+	EXPECT_FLOAT_EQ(governor.incoming_rate(), 100000.f);
+
+	// not measured while the buffer was full
+	EXPECT_FLOAT_EQ(governor.capacity(), 0.f);
+
+	governor.reset();
+	EXPECT_EQ(governor.level(), 0);
+	EXPECT_FLOAT_EQ(governor.throughput(), 0.f);
+}
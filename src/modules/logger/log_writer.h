@@ -126,6 +126,25 @@ public:
 		return 0;
 	}
 
+	size_t get_write_offset_file(LogType type) const
+	{
+		if (_log_writer_file) { return _log_writer_file->get_write_offset(type); }
+
+		return 0;
+	}
+
+	size_t get_total_written_compressed_file(LogType type) const
+	{
+		if (_log_writer_file) { return _log_writer_file->get_total_written_compressed(type); }
+
+		return 0;
+	}
+
+	void set_compression_file(LogType type, bool compress)
+	{
+		if (_log_writer_file) { _log_writer_file->set_compression(type, compress); }
+	}
+
 	size_t get_buffer_size_file(LogType type) const
 	{
 		if (_log_writer_file) { return _log_writer_file->get_buffer_size(type); }
@@ -171,8 +171,8 @@ bool LogWriterFile::init_logfile_encryption(const LogType type)
 		.initdata_size = (uint16_t)nonce_size
 	};
 
-	size_t written = ::write(key_fd, (uint8_t *)&keyfile_header, sizeof(keyfile_header));
-	written += ::write(key_fd, key, key_size + nonce_size);
+	size_t written = _buffers[(int)type].write_to_file((uint8_t *)&keyfile_header, sizeof(keyfile_header), false);
+	written += _buffers[(int)type].write_to_file(key, key_size + nonce_size, false);
 
 	// Free temporary memory allocations
 	free(key);
@@ -207,7 +207,8 @@ bool LogWriterFile::start_log(LogType type, const char *filename)
 		// the hardfault handler will append the crash log to that file on the next reboot.
 		// Note that we don't deregister it when closing the log, so that crashes after disarming
 		// are appended as well (the same holds for crashes before arming, which can be a bit misleading)
-		int ret = hardfault_store_filename(filename);
+		// A compressed log cannot be patched, so the previous file is deregistered instead.
+		int ret = hardfault_store_filename(_buffers[(int)type].compressed() ? "" : filename);
 
 		if (ret) {
 			PX4_ERR("Failed to register ULog file to the hardfault handler (%i)", ret);
@@ -410,13 +411,13 @@ void LogWriterFile::run()
 
 #endif
 
-					int written = buffer.write_to_file(read_ptr, available, call_fsync);
+					int written = buffer.write_data(read_ptr, available, call_fsync);
 
 					if (written < 0) {
 						// retry once
 						PX4_ERR("write failed errno:%i (%s), retrying", errno, strerror(errno));
 						px4_usleep(10000); // 10 milliseconds
-						written = buffer.write_to_file(read_ptr, available, call_fsync);
+						written = buffer.write_data(read_ptr, available, call_fsync);
 					}
 
 					/* buffer.mark_read() requires _mtx to be locked */
@@ -446,6 +447,11 @@ void LogWriterFile::run()
 
 				} else if (call_fsync && buffer._should_run) {
 					pthread_mutex_unlock(&_mtx);
+
+					if (buffer.compressed()) {
+						buffer.flush_compressed(true);
+					}
+
 					buffer.fsync();
 					pthread_mutex_lock(&_mtx);
 
@@ -587,6 +593,11 @@ LogWriterFile::LogFileBuffer::~LogFileBuffer()
 	}
 
 	free(_buffer);
+	free(_compressed_buffer);
+	delete _compressor;
+#if defined(LOGGER_DIRECT_IO)
+	free(_direct_buffer);
+#endif // LOGGER_DIRECT_IO
 
 	perf_free(_perf_write);
 	perf_free(_perf_fsync);
@@ -635,7 +646,33 @@ size_t LogWriterFile::LogFileBuffer::get_read_ptr(void **ptr, bool *is_part)
 
 bool LogWriterFile::LogFileBuffer::start_log(const char *filename)
 {
+#if defined(LOGGER_DIRECT_IO)
+
+	if (_direct_buffer == nullptr && posix_memalign((void **)&_direct_buffer, _direct_block_size, _direct_buffer_size) != 0) {
+		_direct_buffer = nullptr;
+	}
+
+	_direct = false;
+	_direct_count = 0;
+	_direct_offset = 0;
+
+	if (_direct_buffer) {
+		_fd = ::open(filename, O_CREAT | O_WRONLY | O_DIRECT, PX4_O_MODE_666);
+		_direct = _fd >= 0;
+
+		if (!_direct) {
+			// not supported by the file system (e.g. tmpfs): use the page cache
+			PX4_WARN("O_DIRECT not available for %s (%i)", filename, errno);
+		}
+	}
+
+	if (!_direct) {
+		_fd = ::open(filename, O_CREAT | O_WRONLY, PX4_O_MODE_666);
+	}
+
+#else
 	_fd = ::open(filename, O_CREAT | O_WRONLY, PX4_O_MODE_666);
+#endif // LOGGER_DIRECT_IO
 	_had_write_error.store(false);
 
 	if (_fd < 0) {
@@ -673,6 +710,31 @@ bool LogWriterFile::LogFileBuffer::start_log(const char *filename)
 		}
 	}
 
+	if (_compress) {
+		if (_compressor == nullptr) {
+			_compressor = new LogCompressor();
+			_compressed_buffer = (uint8_t *)malloc(_compressed_buffer_size);
+		}
+
+		if (_compressor == nullptr || _compressed_buffer == nullptr) {
+			PX4_ERR("Can't create log compression buffer");
+			::close(_fd);
+			_fd = -1;
+			return false;
+		}
+
+		// the container header goes out with the first chunk
+		ulog_compressed_header_s header{};
+		memcpy(header.magic, "ULogLZ4", sizeof(header.magic));
+		header.hdr_ver = 1;
+		header.timestamp = hrt_absolute_time();
+		header.block_size = LogCompressor::BLOCK_SIZE;
+		memcpy(_compressed_buffer, &header, sizeof(header));
+		_compressed_count = sizeof(header);
+		_compressed_offset = 0;
+		_total_written_compressed = 0;
+	}
+
 	// Clear buffer and counters
 	_head = 0;
 	_count = 0;
@@ -683,17 +745,28 @@ bool LogWriterFile::LogFileBuffer::start_log(const char *filename)
 	return true;
 }
 
-void LogWriterFile::LogFileBuffer::fsync() const
+void LogWriterFile::LogFileBuffer::fsync()
 {
 	perf_begin(_perf_fsync);
+#if defined(LOGGER_DIRECT_IO)
+
+	if (_direct) {
+		flush_direct_tail();
+	}
+
+#endif // LOGGER_DIRECT_IO
 	::fsync(_fd);
 	perf_end(_perf_fsync);
 }
 
-ssize_t LogWriterFile::LogFileBuffer::write_to_file(const void *buffer, size_t size, bool call_fsync) const
+ssize_t LogWriterFile::LogFileBuffer::write_to_file(const void *buffer, size_t size, bool call_fsync)
 {
 	perf_begin(_perf_write);
+#if defined(LOGGER_DIRECT_IO)
+	ssize_t ret = _direct ? write_direct(buffer, size) : ::write(_fd, buffer, size);
+#else
 	ssize_t ret = ::write(_fd, buffer, size);
+#endif // LOGGER_DIRECT_IO
 	perf_end(_perf_write);
 
 	if (call_fsync) {
@@ -703,14 +776,180 @@ ssize_t LogWriterFile::LogFileBuffer::write_to_file(const void *buffer, size_t s
 	return ret;
 }
 
+ssize_t LogWriterFile::LogFileBuffer::write_data(const void *buffer, size_t size, bool call_fsync)
+{
+	return _compress ? write_compressed(buffer, size, call_fsync) : write_to_file(buffer, size, call_fsync);
+}
+
+ssize_t LogWriterFile::LogFileBuffer::write_compressed(const void *buffer, size_t size, bool call_fsync)
+{
+	const uint8_t *data = static_cast<const uint8_t *>(buffer);
+	size_t consumed = 0;
+
+	while (consumed < size) {
+		const size_t block_size = math::min(size - consumed, LogCompressor::BLOCK_SIZE);
+		const size_t block_bound = sizeof(ulog_compressed_block_s) + LogCompressor::compress_bound(block_size);
+
+		if (_compressed_count + block_bound > _compressed_buffer_size) {
+			if (flush_compressed(false) < 0) {
+				return consumed > 0 ? (ssize_t)consumed : -1;
+			}
+
+			if (_compressed_count + block_bound > _compressed_buffer_size) {
+				// short write, continue with the next call
+				break;
+			}
+		}
+
+		uint8_t *out = _compressed_buffer + _compressed_count + sizeof(ulog_compressed_block_s);
+		size_t compressed_size = _compressor->compress(data + consumed, block_size, out,
+					 _compressed_buffer_size - _compressed_count - sizeof(ulog_compressed_block_s));
+
+		ulog_compressed_block_s header{};
+		header.sync = ULOG_COMPRESSED_BLOCK_SYNC;
+		header.offset = _compressed_offset;
+		header.size = block_size;
+
+		if (compressed_size == 0 || compressed_size >= block_size) {
+			memcpy(out, data + consumed, block_size);
+			compressed_size = block_size;
+			header.compressed_size = block_size | ULOG_COMPRESSED_BLOCK_STORED;
+
+		} else {
+			header.compressed_size = compressed_size;
+		}
+
+		memcpy(_compressed_buffer + _compressed_count, &header, sizeof(header));
+		_compressed_count += sizeof(header) + compressed_size;
+		_compressed_offset += block_size;
+		consumed += block_size;
+	}
+
+	// Full chunks go out right away, the rest waits for more data unless we need it on the card now.
+	// On failure the data stays in the compression buffer and the next call reports the error.
+	flush_compressed(call_fsync);
+
+	if (call_fsync) {
+		fsync();
+	}
+
+	return consumed;
+}
+
+ssize_t LogWriterFile::LogFileBuffer::flush_compressed(bool all)
+{
+	const size_t size = all ? _compressed_count : _compressed_count / _min_write_chunk * _min_write_chunk;
+
+	if (size == 0) {
+		return 0;
+	}
+
+	ssize_t ret = write_to_file(_compressed_buffer, size, false);
+
+	if (ret > 0) {
+		_compressed_count -= ret;
+		_total_written_compressed += ret;
+		memmove(_compressed_buffer, _compressed_buffer + ret, _compressed_count);
+	}
+
+	return ret;
+}
+
+#if defined(LOGGER_DIRECT_IO)
+ssize_t LogWriterFile::LogFileBuffer::write_direct(const void *buffer, size_t size)
+{
+	const uint8_t *data = static_cast<const uint8_t *>(buffer);
+	size_t consumed = 0;
+
+	while (consumed < size) {
+		if (_direct_count == _direct_buffer_size) {
+			if (flush_direct() < 0) {
+				return consumed > 0 ? (ssize_t)consumed : -1;
+			}
+
+			if (_direct_count == _direct_buffer_size) {
+				// short write, continue with the next call
+				break;
+			}
+		}
+
+		const size_t n = math::min(size - consumed, _direct_buffer_size - _direct_count);
+		memcpy(_direct_buffer + _direct_count, data + consumed, n);
+		_direct_count += n;
+		consumed += n;
+	}
+
+	// On failure the data stays in the buffer and the next call reports the error
+	flush_direct();
+
+	return consumed;
+}
+
+ssize_t LogWriterFile::LogFileBuffer::flush_direct()
+{
+	const size_t size = _direct_count / _direct_block_size * _direct_block_size;
+
+	if (size == 0) {
+		return 0;
+	}
+
+	ssize_t ret = ::pwrite(_fd, _direct_buffer, size, _direct_offset);
+
+	if (ret > 0) {
+		// the file offset must stay block aligned
+		ret = ret / _direct_block_size * _direct_block_size;
+		_direct_count -= ret;
+		_direct_offset += ret;
+		memmove(_direct_buffer, _direct_buffer + ret, _direct_count);
+	}
+
+	return ret;
+}
+
+int LogWriterFile::LogFileBuffer::flush_direct_tail()
+{
+	if (flush_direct() < 0 || _direct_count >= _direct_block_size) {
+		return -1;
+	}
+
+	if (_direct_count == 0) {
+		return 0;
+	}
+
+	// the padding is overwritten by the next data and cut off by the truncate
+	memset(_direct_buffer + _direct_count, 0, _direct_block_size - _direct_count);
+
+	if (::pwrite(_fd, _direct_buffer, _direct_block_size, _direct_offset) != (ssize_t)_direct_block_size) {
+		return -1;
+	}
+
+	return ::ftruncate(_fd, _direct_offset + _direct_count);
+}
+#endif // LOGGER_DIRECT_IO
+
 void LogWriterFile::LogFileBuffer::close_file()
 {
 	if (_fd >= 0) {
+		if (_compress && flush_compressed(true) < 0) {
+			PX4_ERR("write failed (%i)", errno);
+		}
+
+#if defined(LOGGER_DIRECT_IO)
+
+		if (_direct && flush_direct_tail() < 0) {
+			PX4_ERR("write failed (%i)", errno);
+		}
+
+#endif // LOGGER_DIRECT_IO
+
 		int res = close(_fd);
 
 		if (res) {
 			PX4_WARN("closing log file failed (%i)", errno);
 
+		} else if (_compress) {
+			PX4_INFO("closed logfile, bytes written: %zu (compressed %zu)", _total_written, _total_written_compressed);
+
 		} else {
 			PX4_INFO("closed logfile, bytes written: %zu", _total_written);
 		}
@@ -721,6 +960,7 @@ void LogWriterFile::LogFileBuffer::reset()
 {
 	_head = 0;
 	_count = 0;
+	_compressed_count = 0;
 	_fd = -1;
 }
 
@@ -41,6 +41,13 @@
 #include <perf/perf_counter.h>
 #include <px4_platform_common/crypto.h>
 
+#include "log_compressor.h"
+#include "messages.h"
+
+#if defined(CONFIG_LOGGER_DIRECT_IO) && defined(__PX4_LINUX)
+#define LOGGER_DIRECT_IO
+#endif
+
 namespace px4
 {
 namespace logger
@@ -108,6 +115,28 @@ public:
 		return _buffers[(int)type].total_written();
 	}
 
+	/**
+	 * file offset of the next message written (before compression). Requires the lock.
+	 */
+	size_t get_write_offset(LogType type) const
+	{
+		return _buffers[(int)type].total_written() + _buffers[(int)type].count();
+	}
+
+	/** bytes written to the file if the log is compressed, 0 otherwise */
+	size_t get_total_written_compressed(LogType type) const
+	{
+		return _buffers[(int)type].total_written_compressed();
+	}
+
+	/**
+	 * Write the next log file of the given type compressed (.ulgz). Must be set before start_log().
+	 */
+	void set_compression(LogType type, bool compress)
+	{
+		_buffers[(int)type].set_compression(compress);
+	}
+
 	size_t get_buffer_size(LogType type) const
 	{
 		return _buffers[(int)type].buffer_size();
@@ -191,13 +220,33 @@ private:
 
 		int fd() const { return _fd; }
 
-		inline ssize_t write_to_file(const void *buffer, size_t size, bool call_fsync) const;
+		inline ssize_t write_to_file(const void *buffer, size_t size, bool call_fsync);
 
-		inline void fsync() const;
+		/**
+		 * Compress data into blocks and write them out in multiples of _min_write_chunk.
+		 * The remainder is kept until more data arrives or flush_compressed() is called.
+		 * @return number of (uncompressed) bytes consumed, <0 on error
+		 */
+		ssize_t write_compressed(const void *buffer, size_t size, bool call_fsync);
+
+		/**
+		 * Write pending compressed data
+		 * @param all also write the last partial chunk
+		 */
+		ssize_t flush_compressed(bool all);
+
+		/** write data to the file, compressed or not */
+		ssize_t write_data(const void *buffer, size_t size, bool call_fsync);
+
+		inline void fsync();
+
+		void set_compression(bool compress) { _compress = compress; }
+		bool compressed() const { return _compress; }
 
 		void mark_read(size_t n) { _count -= n; _total_written += n; }
 
 		size_t total_written() const { return _total_written; }
+		size_t total_written_compressed() const { return _compress ? _total_written_compressed : 0; }
 		size_t buffer_size() const { return _buffer_size; }
 		size_t count() const { return _count; }
 
@@ -213,6 +262,40 @@ private:
 		size_t _total_written = 0;
 		perf_counter_t _perf_write;
 		perf_counter_t _perf_fsync;
+
+		bool _compress{false};
+		LogCompressor *_compressor{nullptr};
+		uint8_t *_compressed_buffer{nullptr}; ///< compressed blocks waiting to be written
+		size_t _compressed_count{0};
+		size_t _compressed_offset{0}; ///< uncompressed offset of the next block
+		size_t _total_written_compressed{0};
+
+		static constexpr size_t _compressed_buffer_size = _min_write_chunk + sizeof(ulog_compressed_block_s) +
+				LogCompressor::compress_bound(LogCompressor::BLOCK_SIZE);
+
+#if defined(LOGGER_DIRECT_IO)
+		/**
+		 * O_DIRECT: bypass the page cache. Data is collected in an aligned buffer and written in whole
+		 * blocks at explicit file offsets. The last partial block is written zero-padded (and the file
+		 * truncated to the real size) on fsync and close, and written again once it is complete.
+		 * @return number of bytes consumed, <0 on error
+		 */
+		ssize_t write_direct(const void *buffer, size_t size);
+
+		/** write the whole blocks of the direct buffer */
+		ssize_t flush_direct();
+
+		/** write the last partial block and set the file size */
+		int flush_direct_tail();
+
+		static constexpr size_t _direct_block_size = _min_write_chunk;
+		static constexpr size_t _direct_buffer_size = 16 * _direct_block_size;
+
+		bool _direct{false}; ///< file is opened with O_DIRECT
+		uint8_t *_direct_buffer{nullptr};
+		size_t _direct_count{0};
+		off_t _direct_offset{0}; ///< file offset of _direct_buffer[0]
+#endif // LOGGER_DIRECT_IO
 	};
 
 	LogFileBuffer _buffers[(int)LogType::Count];
@@ -242,8 +242,19 @@ void Logger::print_statistics(LogType type)
 		PX4_INFO("Wrote %4.2f MiB (avg %5.2f KiB/s)", (double)mebibytes, (double)(kibibytes / seconds));
 	}
 
+	const size_t compressed = _writer.get_total_written_compressed_file(type);
+
+	if (compressed > 0) {
+		PX4_INFO("Compressed to %4.2f KiB (ratio %.2f)", (double)(compressed / 1024.0f),
+			 (double)(_writer.get_total_written_file(type) / (float)compressed));
+	}
+
 	PX4_INFO("Since last status: dropouts: %zu (max len: %.3f s), max used buffer: %zu / %zu B",
 		 stats.write_dropouts, (double)stats.max_dropout_duration, stats.high_water, _writer.get_buffer_size_file(type));
+
+	if (type == LogType::Full && _rate_governor.level() > 0) {
+		PX4_INFO("Logging rates of low-priority topics reduced by %" PRIu32, _rate_governor.interval_factor());
+	}
 	stats.high_water = 0;
 	stats.write_dropouts = 0;
 	stats.max_dropout_duration = 0.f;
@@ -416,6 +427,7 @@ Logger::~Logger()
 
 	delete[](_msg_buffer);
 	delete[](_subscriptions);
+	delete _log_index;
 }
 
 void Logger::update_params()
@@ -463,7 +475,7 @@ bool Logger::copy_if_updated(int sub_idx, void *buffer, bool try_to_subscribe)
 		}
 
 	} else if (try_to_subscribe) {
-		if (sub.subscribe()) {
+		if (subscribe(sub_idx)) {
 			write_add_logged_msg(LogType::Full, sub);
 
 			if (sub_idx < _num_mission_subs) {
@@ -478,6 +490,32 @@ bool Logger::copy_if_updated(int sub_idx, void *buffer, bool try_to_subscribe)
 	return updated;
 }
 
+bool Logger::subscribe(int sub_idx)
+{
+	LoggerSubscription &sub = _subscriptions[sub_idx];
+
+	if (!sub.subscribe()) {
+		return false;
+	}
+
+	if (!sub.registered()) {
+		sub.ready_set = &_ready_set;
+		sub.ready_index = sub_idx;
+
+		if (sub.registerCallback()) {
+			_polled_subscriptions[sub_idx / 32] &= ~(1u << (sub_idx % 32));
+
+		} else {
+			_polled_subscriptions[sub_idx / 32] |= 1u << (sub_idx % 32);
+		}
+
+		// check for data that was published before the callback was there
+		_ready_set.set(sub_idx);
+	}
+
+	return true;
+}
+
 const char *Logger::configured_backend_mode() const
 {
 	switch (_writer.backend()) {
@@ -550,6 +588,11 @@ bool Logger::initialize_topics()
 	delete[](_subscriptions);
 	_subscriptions = nullptr;
 
+	for (int i = 0; i < ReadySet::NUM_WORDS; ++i) {
+		_ready_set.take_word(i);
+		_polled_subscriptions[i] = 0;
+	}
+
 	if (logged_topics.subscriptions().count > 0) {
 		_subscriptions = new LoggerSubscription[logged_topics.subscriptions().count];
 
@@ -561,7 +604,7 @@ bool Logger::initialize_topics()
 		for (int i = 0; i < logged_topics.subscriptions().count; ++i) {
 			const LoggedTopics::RequestedSubscription &sub = logged_topics.subscriptions().sub[i];
 			_subscriptions[i] = LoggerSubscription(sub.id, sub.interval_ms, sub.instance);
-			_subscriptions[i].subscribe();
+			subscribe(i);
 		}
 	}
 
@@ -690,7 +733,7 @@ void Logger::run()
 	int next_subscribe_topic_index = -1; // this is used to distribute the checks over time
 
 	if (polling_topic_sub >= 0) {
-		_lockstep_component = px4_lockstep_register_component();
+		_lockstep_component = px4_lockstep_register_component(nullptr);
 	}
 
 	bool was_started = false;
@@ -749,50 +792,79 @@ void Logger::run()
 			/* wait for lock on log buffer */
 			_writer.lock();
 
-			for (int sub_idx = 0; sub_idx < _num_subscriptions; ++sub_idx) {
-				LoggerSubscription &sub = _subscriptions[sub_idx];
-				/* if this topic has been updated, copy the new data into the message buffer
-				 * and write a message to the log
-				 */
-				const bool try_to_subscribe = (sub_idx == next_subscribe_topic_index);
+			// the subscription that is due for a subscribe attempt is checked in any case
+			if (next_subscribe_topic_index != -1) {
+				_ready_set.set(next_subscribe_topic_index);
+			}
+
+			// only go through subscriptions with new data (set from the publication callbacks)
+			for (int word = 0; word * 32 < _num_subscriptions; ++word) {
+				uint32_t ready = _ready_set.take_word(word) | _polled_subscriptions[word];
+				uint32_t pending = 0;
 
-				if (copy_if_updated(sub_idx, _msg_buffer + sizeof(ulog_message_data_s), try_to_subscribe)) {
-					// each message consists of a header followed by an orb data object
-					const size_t msg_size = sizeof(ulog_message_data_s) + sub.get_topic()->o_size_no_padding;
-					const uint16_t write_msg_size = static_cast<uint16_t>(msg_size - ULOG_MSG_HEADER_LEN);
-					const uint16_t write_msg_id = sub.msg_id;
+				while (ready != 0) {
+					const int bit = __builtin_ctz(ready);
+					ready &= ready - 1;
 
-					//write one byte after another (necessary because of alignment)
-					_msg_buffer[0] = (uint8_t)write_msg_size;
-					_msg_buffer[1] = (uint8_t)(write_msg_size >> 8);
-					_msg_buffer[2] = static_cast<uint8_t>(ULogMessageType::DATA);
-					_msg_buffer[3] = (uint8_t)write_msg_id;
-					_msg_buffer[4] = (uint8_t)(write_msg_id >> 8);
+					const int sub_idx = word * 32 + bit;
+
+					if (sub_idx >= _num_subscriptions) {
+						break;
+					}
+
+					LoggerSubscription &sub = _subscriptions[sub_idx];
+					/* if this topic has been updated, copy the new data into the message buffer
+					 * and write a message to the log
+					 */
+					const bool try_to_subscribe = (sub_idx == next_subscribe_topic_index);
+
+					if (copy_if_updated(sub_idx, _msg_buffer + sizeof(ulog_message_data_s), try_to_subscribe)) {
+						// each message consists of a header followed by an orb data object
+						const size_t msg_size = sizeof(ulog_message_data_s) + sub.get_topic()->o_size_no_padding;
+						const uint16_t write_msg_size = static_cast<uint16_t>(msg_size - ULOG_MSG_HEADER_LEN);
+						const uint16_t write_msg_id = sub.msg_id;
 
-					// PX4_INFO("topic: %s, size = %zu, out_size = %zu", sub.get_topic()->o_name, sub.get_topic()->o_size, msg_size);
+						//write one byte after another (necessary because of alignment)
+						_msg_buffer[0] = (uint8_t)write_msg_size;
+						_msg_buffer[1] = (uint8_t)(write_msg_size >> 8);
+						_msg_buffer[2] = static_cast<uint8_t>(ULogMessageType::DATA);
+						_msg_buffer[3] = (uint8_t)write_msg_id;
+						_msg_buffer[4] = (uint8_t)(write_msg_id >> 8);
 
-					// full log
-					if (write_message(LogType::Full, _msg_buffer, msg_size)) {
+						// PX4_INFO("topic: %s, size = %zu, out_size = %zu", sub.get_topic()->o_name, sub.get_topic()->o_size, msg_size);
+
+						// full log
+						if (write_message(LogType::Full, _msg_buffer, msg_size)) {
 
 #ifdef DBGPRINT
-						total_bytes += msg_size;
+							total_bytes += msg_size;
 #endif /* DBGPRINT */
-					}
+						}
 
-					// mission log
-					if (sub_idx < _num_mission_subs) {
-						if (_writer.is_started(LogType::Mission)) {
-							if (_mission_subscriptions[sub_idx].next_write_time < (loop_time / 100000)) {
-								unsigned delta_time = _mission_subscriptions[sub_idx].min_delta_ms;
+						// mission log
+						if (sub_idx < _num_mission_subs) {
+							if (_writer.is_started(LogType::Mission)) {
+								if (_mission_subscriptions[sub_idx].next_write_time < (loop_time / 100000)) {
+									unsigned delta_time = _mission_subscriptions[sub_idx].min_delta_ms;
 
-								if (delta_time > 0) {
-									_mission_subscriptions[sub_idx].next_write_time = (loop_time / 100000) + delta_time / 100;
-								}
+									if (delta_time > 0) {
+										_mission_subscriptions[sub_idx].next_write_time = (loop_time / 100000) + delta_time / 100;
+									}
 
-								write_message(LogType::Mission, _msg_buffer, msg_size);
+									write_message(LogType::Mission, _msg_buffer, msg_size);
+								}
 							}
 						}
 					}
+
+					// keep it for the next iteration if data is left (queued, or the interval did not pass yet)
+					if (sub.valid() && sub.unread()) {
+						pending |= 1u << bit;
+					}
+				}
+
+				if (pending != 0) {
+					_ready_set.set_word(word, pending);
 				}
 			}
 
@@ -856,6 +928,14 @@ void Logger::run()
 			/* notify the writer thread */
 			_writer.notify();
 
+			if (_param_sdlog_rate_gov.get()) {
+				update_rate_governor();
+			}
+
+			if (_log_index && _log_index->interval_elapsed(loop_time)) {
+				write_index_bucket();
+			}
+
 			/* subscription update */
 			if (next_subscribe_topic_index != -1) {
 				if (++next_subscribe_topic_index >= _num_subscriptions) {
@@ -878,7 +958,7 @@ void Logger::run()
 			// - we'll get the data immediately once we start logging (no need to wait for the next subscribe timeout)
 			if (next_subscribe_topic_index != -1) {
 				if (!_subscriptions[next_subscribe_topic_index].valid()) {
-					_subscriptions[next_subscribe_topic_index].subscribe();
+					subscribe(next_subscribe_topic_index);
 				}
 
 				if (++next_subscribe_topic_index >= _num_subscriptions) {
@@ -1088,6 +1168,48 @@ void Logger::adjust_subscription_updates()
 	}
 }
 
+void Logger::update_rate_governor()
+{
+	if (!_writer.is_started(LogType::Full, LogWriter::BackendFile)) {
+		return;
+	}
+
+	_writer.lock();
+	const bool changed = _rate_governor.update(hrt_absolute_time(), _writer.get_buffer_fill_count_file(LogType::Full),
+			     _writer.get_buffer_size_file(LogType::Full), _writer.get_total_written_file(LogType::Full));
+	_writer.unlock();
+
+	if (!changed) {
+		return;
+	}
+
+	apply_rate_governor();
+
+	if (_rate_governor.level() > 0) {
+		PX4_WARN("log buffer filling up (%.1f KiB/s written): reducing logging rates by %" PRIu32,
+			 (double)(_rate_governor.throughput() / 1024.f), _rate_governor.interval_factor());
+
+	} else {
+		PX4_INFO("logging rates restored");
+	}
+
+	// record the change, so that the analysis knows about the reduced rates
+	char value[48];
+	snprintf(value, sizeof(value), "t=%" PRIu64 " factor=%" PRIu32, hrt_absolute_time(), _rate_governor.interval_factor());
+	write_info_multiple(LogType::Full, "log_rate_change", value, false);
+}
+
+void Logger::apply_rate_governor()
+{
+	for (int i = _num_mission_subs; i < _num_subscriptions; ++i) {
+		LoggerSubscription &sub = _subscriptions[i];
+
+		if (sub.base_interval_ms > 0) {
+			sub.set_interval_ms(sub.base_interval_ms * _rate_governor.interval_factor());
+		}
+	}
+}
+
 bool Logger::get_disable_boot_logging()
 {
 	if (_param_sdlog_boot_bat.get()) {
@@ -1201,8 +1323,16 @@ void Logger::handle_vehicle_command_update()
 bool Logger::write_message(LogType type, void *ptr, size_t size)
 {
 	Statistics &stats = _statistics[(int)type];
+	const size_t file_offset = _writer.get_write_offset_file(type);
 
-	if (_writer.write_message(type, ptr, size, stats.dropout_start) != -1) {
+	const int ret = _writer.write_message(type, ptr, size, stats.dropout_start);
+
+	// index what made it into the file, regardless of the mavlink backend
+	if (_log_index && type == LogType::Full && _writer.get_write_offset_file(type) != file_offset) {
+		_log_index->add_message(static_cast<const uint8_t *>(ptr), file_offset);
+	}
+
+	if (ret != -1) {
 
 		if (stats.dropout_start) {
 			float dropout_duration = (float)(hrt_elapsed_time(&stats.dropout_start) / 1000) / 1.e3f;
@@ -1303,15 +1433,19 @@ int Logger::get_log_file_name(LogType type, char *file_name, size_t file_name_si
 		replay_suffix = "_replayed";
 	}
 
-	const char *crypto_suffix = "";
+	const char *file_suffix = "";
 #if defined(PX4_CRYPTO)
 
 	if (_param_sdlog_crypto_algorithm.get() != 0) {
-		crypto_suffix = "e";
+		file_suffix = "e";
 	}
 
 #endif
 
+	if (compress_log_file(type)) {
+		file_suffix = "z";
+	}
+
 	char *log_file_name = _file_name[(int)type].log_file_name;
 
 	if (time_ok) {
@@ -1324,7 +1458,7 @@ int Logger::get_log_file_name(LogType type, char *file_name, size_t file_name_si
 		char log_file_name_time[16] = "";
 		strftime(log_file_name_time, sizeof(log_file_name_time), "%H_%M_%S", &tt);
 		snprintf(log_file_name, sizeof(LogFileName::log_file_name), "%s%s.ulg%s", log_file_name_time, replay_suffix,
-			 crypto_suffix);
+			 file_suffix);
 		snprintf(file_name + n, file_name_size - n, "/%s", log_file_name);
 
 		if (notify) {
@@ -1355,7 +1489,7 @@ int Logger::get_log_file_name(LogType type, char *file_name, size_t file_name_si
 		while (file_number <= MAX_NO_LOGFILE) {
 			/* format log file path: e.g. /fs/microsd/log/sess001/log001.ulg */
 			snprintf(log_file_name, sizeof(LogFileName::log_file_name), "log%03" PRIu16 "%s.ulg%s", file_number, replay_suffix,
-				 crypto_suffix);
+				 file_suffix);
 			snprintf(file_name + n, file_name_size - n, "/%s", log_file_name);
 
 			if (!util::file_exist(file_name)) {
@@ -1384,6 +1518,79 @@ int Logger::get_log_file_name(LogType type, char *file_name, size_t file_name_si
 	return 0;
 }
 
+bool Logger::compress_log_file(LogType type)
+{
+	if (type != LogType::Full || !_param_sdlog_compress.get()) {
+		return false;
+	}
+
+#if defined(PX4_CRYPTO)
+
+	if (_param_sdlog_crypto_algorithm.get() != 0) {
+		// encryption is applied in place on the write buffer, compressing the ciphertext is pointless
+		return false;
+	}
+
+#endif
+
+	return true;
+}
+
+bool Logger::index_log_file()
+{
+	if (!_param_sdlog_index.get()) {
+		return false;
+	}
+
+#if defined(PX4_CRYPTO)
+
+	if (_param_sdlog_crypto_algorithm.get() != 0) {
+		// the key header at the start of the file is not part of the ULog stream
+		return false;
+	}
+
+#endif
+
+	return true;
+}
+
+void Logger::write_index_bucket()
+{
+	_writer.select_write_backend(LogWriter::BackendFile);
+
+	_writer.lock();
+	const size_t bucket_offset = _writer.get_write_offset_file(LogType::Full);
+	_writer.unlock();
+
+	const bool written = write_info_multiple(LogType::Full, "ulog_index", _log_index->bucket(), _log_index->bucket_size());
+
+	_writer.lock();
+	const size_t offset = _writer.get_write_offset_file(LogType::Full);
+	_writer.unlock();
+
+	_writer.unselect_write_backend();
+
+	// a dropped bucket is left out of the directory
+	_log_index->next_bucket(hrt_absolute_time(), written ? bucket_offset : 0, offset);
+}
+
+void Logger::write_index_footer()
+{
+	write_index_bucket();
+
+	_writer.select_write_backend(LogWriter::BackendFile);
+
+	_writer.lock();
+	const uint64_t directory_offset = _writer.get_write_offset_file(LogType::Full);
+	_writer.unlock();
+
+	if (write_info_multiple(LogType::Full, "ulog_index_dir", _log_index->directory(), _log_index->directory_size())) {
+		write_info(LogType::Full, "ulog_index_dir", directory_offset);
+	}
+
+	_writer.unselect_write_backend();
+}
+
 void Logger::setReplayFile(const char *file_name)
 {
 	if (_replay_file_name) {
@@ -1421,6 +1628,17 @@ void Logger::start_log_file(LogType type)
 		_param_sdlog_crypto_exchange_key.get());
 #endif
 
+	_writer.set_compression_file(type, compress_log_file(type));
+
+	if (type == LogType::Full) {
+		const bool was_reduced = _rate_governor.level() > 0;
+		_rate_governor.reset();
+
+		if (was_reduced) {
+			apply_rate_governor();
+		}
+	}
+
 	if (_writer.start_log_file(type, file_name)) {
 		_writer.select_write_backend(LogWriter::BackendFile);
 		_writer.set_need_reliable_transfer(true);
@@ -1448,6 +1666,19 @@ void Logger::start_log_file(LogType type)
 			perf_reset_all();
 		}
 
+		if (type == LogType::Full && index_log_file()) {
+			_log_index = new LogIndex();
+
+			if (_log_index) {
+				_writer.lock();
+				_log_index->start(hrt_absolute_time(), _writer.get_write_offset_file(type));
+				_writer.unlock();
+
+			} else {
+				PX4_ERR("alloc failed");
+			}
+		}
+
 		_statistics[(int) type].start_time_file = hrt_absolute_time();
 	}
 
@@ -1462,6 +1693,13 @@ void Logger::stop_log_file(LogType type)
 	if (type == LogType::Full) {
 		_writer.set_need_reliable_transfer(true);
 		write_perf_data(PrintLoadReason::Postflight);
+
+		if (_log_index) {
+			write_index_footer();
+			delete _log_index;
+			_log_index = nullptr;
+		}
+
 		_writer.set_need_reliable_transfer(false);
 	}
 
@@ -1980,6 +2218,41 @@ void Logger::write_info_multiple(LogType type, const char *name, int fd)
 	}
 }
 
+bool Logger::write_info_multiple(LogType type, const char *name, const uint8_t *data, size_t size)
+{
+	ulog_message_info_multiple_s msg;
+	uint8_t *buffer = reinterpret_cast<uint8_t *>(&msg);
+	msg.msg_type = static_cast<uint8_t>(ULogMessageType::INFO_MULTIPLE);
+	msg.is_continued = false;
+	const int name_len = strlen(name);
+	bool success = true;
+
+	_writer.lock();
+
+	while (size > 0) {
+		const int max_format_length = 16; // accounts for "uint8_t[x] "
+		const size_t chunk_length = math::min(size, sizeof(msg.key_value_str) - name_len - max_format_length);
+
+		/* construct format key (type and name) */
+		msg.key_len = snprintf(msg.key_value_str, sizeof(msg.key_value_str), "uint8_t[%zu] %s", chunk_length, name);
+		size_t msg_size = sizeof(msg) - sizeof(msg.key_value_str) + msg.key_len;
+
+		memcpy(&buffer[msg_size], data, chunk_length);
+		msg_size += chunk_length;
+		msg.msg_size = msg_size - ULOG_MSG_HEADER_LEN;
+
+		success = write_message(type, buffer, msg_size) && success;
+
+		data += chunk_length;
+		size -= chunk_length;
+		msg.is_continued = true;
+	}
+
+	_writer.unlock();
+
+	return success;
+}
+
 void Logger::write_info(LogType type, const char *name, int32_t value)
 {
 	write_info_template<int32_t>(type, name, value, "int32_t");
@@ -1990,6 +2263,11 @@ void Logger::write_info(LogType type, const char *name, uint32_t value)
 	write_info_template<uint32_t>(type, name, value, "uint32_t");
 }
 
+void Logger::write_info(LogType type, const char *name, uint64_t value)
+{
+	write_info_template<uint64_t>(type, name, value, "uint64_t");
+}
+
 
 template<typename T>
 void Logger::write_info_template(LogType type, const char *name, T value, const char *type_str)
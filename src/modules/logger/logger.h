@@ -33,6 +33,8 @@
 
 #pragma once
 
+#include "log_index.h"
+#include "log_rate_governor.h"
 #include "log_writer.h"
 #include "logged_topics.h"
 #include "messages.h"
@@ -49,6 +51,7 @@
 
 #include <uORB/PublicationMulti.hpp>
 #include <uORB/Subscription.hpp>
+#include <uORB/SubscriptionCallback.hpp>
 #include <uORB/SubscriptionInterval.hpp>
 #include <uORB/topics/logger_status.h>
 #include <uORB/topics/log_message.h>
@@ -71,14 +74,49 @@ namespace logger
 
 static constexpr uint8_t MSG_ID_INVALID = UINT8_MAX;
 
-struct LoggerSubscription : public uORB::SubscriptionInterval {
-	LoggerSubscription() = default;
+/**
+ * @class ReadySet
+ * Subscriptions with new data, set from the publication callbacks and taken by the logger loop
+ */
+class ReadySet
+{
+public:
+	static constexpr int NUM_WORDS = (LoggedTopics::MAX_TOPICS_NUM + 31) / 32;
+
+	void set(int index) { _words[index / 32].fetch_or(1u << (index % 32)); }
+
+	void set_word(int word, uint32_t bits) { _words[word].fetch_or(bits); }
+
+	/** clear the word and return the bits that were set */
+	uint32_t take_word(int word) { return _words[word].fetch_and(0); }
+
+private:
+	px4::atomic<uint32_t> _words[NUM_WORDS] {};
+};
+
+struct LoggerSubscription : public uORB::SubscriptionCallback {
+	LoggerSubscription() : uORB::SubscriptionCallback(nullptr) {}
 
 	LoggerSubscription(ORB_ID id, uint32_t interval_ms = 0, uint8_t instance = 0) :
-		uORB::SubscriptionInterval(id, interval_ms * 1000, instance)
+		uORB::SubscriptionCallback(get_orb_meta(id), interval_ms * 1000, instance),
+		base_interval_ms(interval_ms)
 	{}
 
+	void call() override
+	{
+		if (ready_set) {
+			ready_set->set(ready_index);
+		}
+	}
+
+	/** unread data, regardless of the interval */
+	bool unread() { return _subscription.updated(); }
+
 	uint8_t msg_id{MSG_ID_INVALID};
+	uint32_t base_interval_ms{0}; ///< configured interval, before scaling by the rate governor
+
+	ReadySet *ready_set{nullptr};
+	int ready_index{0};
 };
 
 class Logger : public ModuleBase<Logger>, public ModuleParams
@@ -213,6 +251,26 @@ private:
 	 */
 	int get_log_file_name(LogType type, char *file_name, size_t file_name_size, bool notify);
 
+	/**
+	 * Whether the log file of the given type is written compressed (SDLOG_COMPRESS, full log only)
+	 */
+	bool compress_log_file(LogType type);
+
+	/**
+	 * Whether the index is added to the full log (SDLOG_INDEX, not for encrypted logs)
+	 */
+	bool index_log_file();
+
+	/**
+	 * Write the index bucket of the elapsed interval and start the next one
+	 */
+	void write_index_bucket();
+
+	/**
+	 * Write the last bucket, the index directory and the trailer pointing to it. Must be the last messages of the log.
+	 */
+	void write_index_footer();
+
 	void start_log_file(LogType type);
 
 	void stop_log_file(LogType type);
@@ -265,8 +323,15 @@ private:
 	void write_info(LogType type, const char *name, const char *value);
 	void write_info_multiple(LogType type, const char *name, const char *value, bool is_continued);
 	void write_info_multiple(LogType type, const char *name, int fd);
+
+	/**
+	 * write binary data as uint8_t[] multi info message, split into continued messages if needed
+	 * @return true if all was written
+	 */
+	bool write_info_multiple(LogType type, const char *name, const uint8_t *data, size_t size);
 	void write_info(LogType type, const char *name, int32_t value);
 	void write_info(LogType type, const char *name, uint32_t value);
+	void write_info(LogType type, const char *name, uint64_t value);
 
 	/** generic common template method for write_info variants */
 	template<typename T>
@@ -280,6 +345,13 @@ private:
 
 	inline bool copy_if_updated(int sub_idx, void *buffer, bool try_to_subscribe);
 
+	/**
+	 * Subscribe (if not yet) and register the publication callback that adds the subscription to the ready set.
+	 * Subscriptions without callback are checked in every loop iteration instead.
+	 * @return true if subscribed
+	 */
+	bool subscribe(int sub_idx);
+
 	/**
 	 * Write exactly one ulog message to the logger and handle dropouts.
 	 * Must be called with _writer.lock() held.
@@ -338,6 +410,17 @@ private:
 
 	void adjust_subscription_updates();
 
+	/**
+	 * Feed the rate governor with the full log write buffer state and apply a changed level
+	 */
+	void update_rate_governor();
+
+	/**
+	 * Scale the intervals of the low-priority topics: rate-limited topics that are not in the mission log.
+	 * Topics logged at full rate (e.g. for replay) are never reduced.
+	 */
+	void apply_rate_governor();
+
 	uint8_t						*_msg_buffer{nullptr};
 	int						_msg_buffer_len{0};
 
@@ -354,6 +437,8 @@ private:
 
 	LoggerSubscription	 			*_subscriptions{nullptr}; ///< all subscriptions for full & mission log (in front)
 	int						_num_subscriptions{0};
+	ReadySet					_ready_set; ///< subscriptions with new data since the last check
+	uint32_t					_polled_subscriptions[ReadySet::NUM_WORDS] {}; ///< subscribed without callback
 	MissionSubscription 				_mission_subscriptions[MAX_MISSION_TOPICS_NUM] {}; ///< additional data for mission subscriptions
 	int						_num_mission_subs{0};
 	LoggerSubscription				_event_subscription; ///< Subscription for the event topic (handled separately)
@@ -366,6 +451,8 @@ private:
 	LogWriter					_writer;
 	uint32_t					_log_interval{0};
 	float						_rate_factor{1.0f};
+	LogRateGovernor					_rate_governor;
+	LogIndex					*_log_index{nullptr}; ///< set while the full log is indexed
 	const orb_metadata				*_polling_topic_meta{nullptr}; ///< if non-null, poll on this topic instead of sleeping
 	orb_advert_t					_mavlink_log_pub{nullptr};
 	uint8_t						_next_topic_id{0}; ///< Logger's internal id (first topic is 0, then 1, and so on) it will assign to the next subscribed ulog topic, used for ulog_message_add_logged_s
@@ -397,7 +484,10 @@ private:
 		(ParamInt<px4::params::SDLOG_PROFILE>) _param_sdlog_profile,
 		(ParamInt<px4::params::SDLOG_MISSION>) _param_sdlog_mission,
 		(ParamBool<px4::params::SDLOG_BOOT_BAT>) _param_sdlog_boot_bat,
-		(ParamBool<px4::params::SDLOG_UUID>) _param_sdlog_uuid
+		(ParamBool<px4::params::SDLOG_UUID>) _param_sdlog_uuid,
+		(ParamBool<px4::params::SDLOG_COMPRESS>) _param_sdlog_compress,
+		(ParamBool<px4::params::SDLOG_RATE_GOV>) _param_sdlog_rate_gov,
+		(ParamBool<px4::params::SDLOG_INDEX>) _param_sdlog_index
 #if defined(PX4_CRYPTO)
 		, (ParamInt<px4::params::SDLOG_ALGORITHM>) _param_sdlog_crypto_algorithm,
 		(ParamInt<px4::params::SDLOG_KEY>) _param_sdlog_crypto_key,
@@ -88,6 +88,96 @@ struct ulog_key_header_s {
 	uint8_t	data[0];
 };
 
+/** first bytes of a compressed log file (.ulgz), followed by compressed blocks */
+struct ulog_compressed_header_s {
+	/* magic identifying the file content */
+	uint8_t magic[7];
+
+	/* version of the container format */
+	uint8_t hdr_ver;
+
+	/* file creation timestamp */
+	uint64_t timestamp;
+
+	/* maximum number of uncompressed bytes in a block */
+	uint32_t block_size;
+};
+
+#define ULOG_COMPRESSED_BLOCK_SYNC 0x4b4c425a // 'ZBLK'
+#define ULOG_COMPRESSED_BLOCK_STORED (1u << 31) // compressed_size flag: block data is stored uncompressed
+
+/**
+ * header of every block in a compressed log file. Blocks are compressed independently (LZ4 block format),
+ * so a reader can seek to any block by walking the headers and start decompressing there.
+ */
+struct ulog_compressed_block_s {
+	/* ULOG_COMPRESSED_BLOCK_SYNC, to resynchronize after a corrupt or truncated block */
+	uint32_t sync;
+
+	/* offset of the block in the uncompressed ULog stream */
+	uint64_t offset;
+
+	/* number of uncompressed bytes */
+	uint32_t size;
+
+	/* number of bytes following this header, ORed with ULOG_COMPRESSED_BLOCK_STORED if not compressed */
+	uint32_t compressed_size;
+};
+
+/*
+ * Log index, so that readers can seek to a time or topic without scanning the whole file.
+ * All parts are regular ULog messages in the data section:
+ * - every interval a 'uint8_t[] ulog_index' multi info message (split into continued messages if needed)
+ *   containing a ulog_index_bucket_s followed by num_entries ulog_index_entry_s
+ * - on close a 'uint8_t[] ulog_index_dir' multi info message containing a ulog_index_dir_header_s followed by
+ *   num_entries ulog_index_dir_entry_s, pointing to the 'ulog_index' messages
+ * - as the last message of the file the 'uint64_t ulog_index_dir' info message with the file offset of the
+ *   first 'ulog_index_dir' message. It has a fixed size of ULOG_INDEX_TRAILER_LEN bytes.
+ * File offsets refer to the (uncompressed) ULog file.
+ */
+#define ULOG_INDEX_TRAILER_KEY "uint64_t ulog_index_dir"
+#define ULOG_INDEX_TRAILER_LEN (ULOG_MSG_HEADER_LEN + 1 + sizeof(ULOG_INDEX_TRAILER_KEY) - 1 + sizeof(uint64_t))
+
+/** index of one interval: where the data of each topic logged within the interval starts */
+struct ulog_index_bucket_s {
+	/* logger time at the start of the interval. Data messages logged within have a timestamp <= the next bucket's */
+	uint64_t timestamp;
+
+	/* file offset of the first message of the interval */
+	uint64_t offset;
+
+	/* file offset of the previous 'ulog_index' message (0 if none), so that readers can get all intervals
+	 * from a coarsened directory */
+	uint64_t previous;
+
+	uint16_t num_entries;
+};
+
+struct ulog_index_entry_s {
+	uint16_t msg_id;
+
+	/* file offset of the first data message with msg_id in the interval, relative to the bucket offset */
+	uint32_t offset;
+};
+
+struct ulog_index_dir_header_s {
+	uint8_t version;
+
+	/* interval between directory entries [ms]. Can be a multiple of the bucket interval for long logs,
+	 * in which case not all 'ulog_index' messages are listed (@see ulog_index_bucket_s::previous) */
+	uint32_t interval_ms;
+
+	uint32_t num_entries;
+};
+
+struct ulog_index_dir_entry_s {
+	/* ulog_index_bucket_s::timestamp */
+	uint64_t timestamp;
+
+	/* file offset of the 'ulog_index' message */
+	uint64_t offset;
+};
+
 
 /**
  * @brief Message Header for the ULog
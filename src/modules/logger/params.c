@@ -177,6 +177,47 @@ PARAM_DEFINE_INT32(SDLOG_DIRS_MAX, 0);
  */
 PARAM_DEFINE_INT32(SDLOG_UUID, 1);
 
+/**
+ * Compress the log file
+ *
+ * If set to 1, the full log is written compressed in blocks to a .ulgz file,
+ * which reduces the SD card bandwidth for high-rate logging profiles.
+ * Use Tools/ulog_decompress.py to convert it back to a .ulg file.
+ * Ignored if log encryption is enabled.
+ *
+ * @boolean
+ * @group SD Logging
+ */
+PARAM_DEFINE_INT32(SDLOG_COMPRESS, 0);
+
+/**
+ * Adapt the logging rates to the write throughput
+ *
+ * If set to 1, the logging rates of rate-limited topics are reduced in steps (down to 1/8)
+ * when the log buffer fills up, instead of dropping whole chunks of data. They are restored
+ * once the buffer stayed drained for a few seconds and the doubled rate fits into the write
+ * throughput measured while the buffer was full. Topics logged at full rate (e.g. for
+ * replay) and mission log topics are not affected. Each change is recorded in the log
+ * as 'log_rate_change' info message.
+ *
+ * @boolean
+ * @group SD Logging
+ */
+PARAM_DEFINE_INT32(SDLOG_RATE_GOV, 0);
+
+/**
+ * Add a seek index to the log
+ *
+ * If set to 1, the full log contains an index of the file offsets of each topic
+ * per second, and a directory of it at the end of the file. This allows tools
+ * (e.g. replay) to seek to a time or topic without scanning the whole log.
+ * Ignored if log encryption is enabled. Needs about 10 kB of RAM while logging.
+ *
+ * @boolean
+ * @group SD Logging
+ */
+PARAM_DEFINE_INT32(SDLOG_INDEX, 0);
+
 /**
  * Logfile Encryption algorithm
  *
@@ -210,7 +210,7 @@ void MavlinkLogHandler::state_sending_data()
 
 	while (_mavlink.get_free_tx_buf() > MAVLINK_PACKET_SIZE && bytes_sent < MAX_BYTES_BURST) {
 
-		// Only seek if we need to
+		// Only seek if we need to (e.g. a GCS reading the log index at the end of the file)
 		long int offset = _current_entry.offset - ftell(_current_entry.fp);
 
 		if (offset && fseek(_current_entry.fp, offset, SEEK_CUR)) {
@@ -218,6 +218,7 @@ void MavlinkLogHandler::state_sending_data()
 			_current_entry.fp = nullptr;
 			PX4_DEBUG("seek error");
 			_state = LogHandlerState::Idle;
+			return;
 		}
 
 		// Prepare mavlink message
@@ -288,8 +289,8 @@ void MavlinkLogHandler::handle_log_request_data(const mavlink_message_t *msg)
 		return;
 	}
 
-	// Handle switching to new request ID
-	if (request.id != _current_entry.id) {
+	// Handle switching to new request ID (or reopen the file after a seek error)
+	if (request.id != _current_entry.id || !_current_entry.fp) {
 		// Close the old file
 		if (_current_entry.fp) {
 			fclose(_current_entry.fp);
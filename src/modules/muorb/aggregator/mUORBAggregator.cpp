@@ -32,6 +32,7 @@
  ****************************************************************************/
 
 #include <px4_platform_common/log.h>
+#include <drivers/drv_hrt.h>
 #include "mUORBAggregator.hpp"
 
 const bool mUORB::Aggregator::debugFlag = false;
@@ -56,6 +57,10 @@ void mUORB::Aggregator::AddRecordToBuffer(const char *messageName, int32_t lengt
 {
 	if (! messageName) { return; }
 
+	if (bufferWriteIndex == 0) {
+		bufferFirstRecordTime = hrt_absolute_time();
+	}
+
 	uint32_t messageNameLength = strlen(messageName);
 	memcpy(&buffer[bufferId][bufferWriteIndex], (uint8_t *) &syncFlag, syncFlagSize);
 	bufferWriteIndex += syncFlagSize;
@@ -69,6 +74,180 @@ void mUORB::Aggregator::AddRecordToBuffer(const char *messageName, int32_t lengt
 	bufferWriteIndex += length;
 }
 
+void mUORB::Aggregator::WriteRecord(RecordType type, uint16_t id, uint8_t sequence, const uint8_t *data,
+				    uint32_t length)
+{
+	uint8_t *record = &buffer[bufferId][bufferWriteIndex];
+	record[0] = type;
+	record[1] = id & 0xFF;
+	record[2] = id >> 8;
+	record[3] = length & 0xFF;
+	record[4] = length >> 8;
+	record[5] = sequence;
+	memcpy(&record[recordHeaderSize], data, length);
+	bufferWriteIndex += recordHeaderSize + length;
+}
+
+void mUORB::Aggregator::ResetTransmitDictionary()
+{
+	for (TxTopic &topic : txTopics) {
+		topic.defined = false;
+		topic.previous.clear();
+	}
+}
+
+bool mUORB::Aggregator::EncodeDelta(const uint8_t *previous, const uint8_t *data, uint32_t length, uint8_t *delta,
+				    uint32_t &delta_length)
+{
+	uint32_t i = 0;
+	delta_length = 0;
+
+	while (i < length) {
+		uint32_t unchanged = 0;
+
+		while ((i + unchanged < length) && (unchanged < UINT8_MAX) && (previous[i + unchanged] == data[i + unchanged])) {
+			unchanged++;
+		}
+
+		// the receiver keeps the rest of the previous message
+		if (i + unchanged == length) {
+			break;
+		}
+
+		uint32_t changed = 0;
+
+		while ((i + unchanged + changed < length) && (changed < UINT8_MAX)
+		       && (previous[i + unchanged + changed] != data[i + unchanged + changed])) {
+			changed++;
+		}
+
+		// not worth it if it isn't smaller than the message
+		if (delta_length + 2 + changed >= length) {
+			return false;
+		}
+
+		delta[delta_length++] = unchanged;
+		delta[delta_length++] = changed;
+		memcpy(&delta[delta_length], &data[i + unchanged], changed);
+		delta_length += changed;
+
+		i += unchanged + changed;
+	}
+
+	return true;
+}
+
+bool mUORB::Aggregator::DecodeDelta(const uint8_t *delta, uint32_t delta_length, uint8_t *data, uint32_t length)
+{
+	uint32_t i = 0;
+	uint32_t index = 0;
+
+	while (index < delta_length) {
+		if (index + 2 > delta_length) {
+			return false;
+		}
+
+		i += delta[index];
+		const uint32_t changed = delta[index + 1];
+		index += 2;
+
+		if ((i + changed > length) || (index + changed > delta_length)) {
+			return false;
+		}
+
+		memcpy(&data[i], &delta[index], changed);
+		i += changed;
+		index += changed;
+	}
+
+	return true;
+}
+
+int16_t mUORB::Aggregator::AddCompactRecordToBuffer(const char *messageName, int32_t length, const uint8_t *data)
+{
+	if (! messageName) { return 0; }
+
+	int16_t rc = 0;
+	const uint64_t now = hrt_absolute_time();
+
+	if (now - txDictionaryTime >= dictionaryRefreshUs) {
+		ResetTransmitDictionary();
+		txDictionaryTime = now;
+	}
+
+	const uint32_t messageNameLength = strlen(messageName);
+	auto it = txTopicIds.find(messageName);
+	uint16_t id = 0;
+
+	if (it != txTopicIds.end()) {
+		id = it->second;
+
+	} else if (txTopics.size() < UINT16_MAX) {
+		id = txTopics.size();
+		txTopicIds.emplace(messageName, id);
+		txTopics.emplace_back();
+
+	} else {
+		return sendFunc(messageName, data, length);
+	}
+
+	if (syncFlagSize + (2 * recordHeaderSize) + messageNameLength + length > bufferSize) {
+		// doesn't fit into any buffer, send it on its own
+		return sendFunc(messageName, data, length);
+	}
+
+	TxTopic &topic = txTopics[id];
+
+	RecordType type = RECORD_DATA;
+	const uint8_t *payload = data;
+	uint32_t payloadLength = length;
+
+	auto encode = [&]() {
+		if (topic.defined && (topic.previous.size() == (size_t) length) && (topic.deltas < keyframeInterval)
+		    && EncodeDelta(topic.previous.data(), data, length, deltaBuffer, payloadLength)) {
+			type = RECORD_DELTA;
+			payload = deltaBuffer;
+
+		} else {
+			type = RECORD_DATA;
+			payload = data;
+			payloadLength = length;
+		}
+
+		return recordHeaderSize + payloadLength + (topic.defined ? 0 : recordHeaderSize + messageNameLength);
+	};
+
+	if (bufferWriteIndex + encode() > bufferSize) {
+		rc = SendData();
+
+		// a failed send resets the dictionary
+		encode();
+	}
+
+	if (bufferWriteIndex == 0) {
+		memcpy(&buffer[bufferId][0], (uint8_t *) &compactFlag, syncFlagSize);
+		bufferWriteIndex = syncFlagSize;
+		bufferFirstRecordTime = now;
+	}
+
+	if (! topic.defined) {
+		WriteRecord(RECORD_DEFINE, id, 0, (const uint8_t *) messageName, messageNameLength);
+		topic.defined = true;
+	}
+
+	topic.sequence++;
+	topic.deltas = (type == RECORD_DELTA) ? topic.deltas + 1 : 0;
+
+	WriteRecord(type, id, topic.sequence, payload, payloadLength);
+	topic.previous.assign(data, data + length);
+
+	if (bufferWriteIndex >= flushThreshold) {
+		rc = SendData();
+	}
+
+	return rc;
+}
+
 int16_t mUORB::Aggregator::SendData()
 {
 	int16_t rc = 0;
@@ -78,6 +257,11 @@ int16_t mUORB::Aggregator::SendData()
 			if (bufferWriteIndex) {
 				rc = sendFunc(topicName.c_str(), buffer[bufferId], bufferWriteIndex);
 				MoveToNextBuffer();
+
+				if (rc != 0) {
+					// the receiver might have missed ids or messages the next deltas refer to
+					ResetTransmitDictionary();
+				}
 			}
 		}
 	}
@@ -85,17 +269,41 @@ int16_t mUORB::Aggregator::SendData()
 	return rc;
 }
 
+uint32_t mUORB::Aggregator::SendDataIfDue(uint64_t now)
+{
+	// don't spin on a buffer that's about to be due
+	static constexpr uint32_t minimumWaitUs = 100;
+
+	if (bufferWriteIndex == 0) {
+		return maxLatencyUs;
+	}
+
+	const uint64_t waited = now - bufferFirstRecordTime;
+
+	if (waited + minimumWaitUs >= maxLatencyUs) {
+		SendData();
+		return maxLatencyUs;
+	}
+
+	return maxLatencyUs - waited;
+}
+
 int16_t mUORB::Aggregator::ProcessTransmitTopic(const char *topic, const uint8_t *data, uint32_t length_in_bytes)
 {
 	int16_t rc = 0;
 
 	if (sendFunc) {
 		if (aggregationEnabled) {
-			if (NewRecordOverflows(topic, length_in_bytes)) {
-				rc = SendData();
-			}
+			if (compressionEnabled) {
+				rc = AddCompactRecordToBuffer(topic, length_in_bytes, data);
 
-			AddRecordToBuffer(topic, length_in_bytes, data);
+			} else {
+				if (NewRecordOverflows(topic, length_in_bytes)) {
+					rc = SendData();
+				}
+
+				AddRecordToBuffer(topic, length_in_bytes, data);
+			}
 
 		} else if (topic) {
 			rc = sendFunc(topic, data, length_in_bytes);
@@ -105,57 +313,153 @@ int16_t mUORB::Aggregator::ProcessTransmitTopic(const char *topic, const uint8_t
 	return rc;
 }
 
-void mUORB::Aggregator::ProcessReceivedTopic(const char *topic, const uint8_t *data, uint32_t length_in_bytes)
+void mUORB::Aggregator::ParseLegacy(const uint8_t *data, uint32_t length_in_bytes)
 {
-	if (isAggregate(topic)) {
-		if (debugFlag) { PX4_INFO("Parsing aggregate buffer of length %u", length_in_bytes); }
+	uint32_t current_index = 0;
+	const uint32_t name_buffer_length = 80;
+	char name_buffer[name_buffer_length];
+
+	while ((current_index + headerSize) < length_in_bytes) {
+		uint32_t sync_flag = *((uint32_t *) &data[current_index]);
 
-		uint32_t current_index = 0;
-		const uint32_t name_buffer_length = 80;
-		char name_buffer[name_buffer_length];
+		if (sync_flag != syncFlag) {
+			PX4_ERR("Expected sync flag but got 0x%X", sync_flag);
+			break;
+		}
 
-		while ((current_index + headerSize) < length_in_bytes) {
-			uint32_t sync_flag = *((uint32_t *) &data[current_index]);
+		current_index += syncFlagSize;
 
-			if (sync_flag != syncFlag) {
-				PX4_ERR("Expected sync flag but got 0x%X", sync_flag);
-				break;
-			}
+		uint32_t name_length = *((uint32_t *) &data[current_index]);
+
+		// Make sure name plus a terminating null can fit into our buffer
+		if (name_length > (name_buffer_length - 1)) {
+			PX4_ERR("Name length too long %u", name_length);
+			break;
+		}
+
+		current_index += topicNameLengthSize;
+
+		uint32_t data_length = *((uint32_t *) &data[current_index]);
+		current_index += dataLengthSize;
+
+		int32_t payload_size = name_length + data_length;
+		int32_t remaining_bytes = length_in_bytes - current_index;
+
+		if (payload_size > remaining_bytes) {
+			PX4_ERR("Payload too big %u. Remaining bytes %d", payload_size, remaining_bytes);
+			break;
+		}
+
+		memcpy(name_buffer, &data[current_index], name_length);
+		name_buffer[name_length] = 0;
+
+		current_index += name_length;
+
+		if (debugFlag) { PX4_INFO("Parsed topic: %s, name length %u, data length: %u", name_buffer, name_length, data_length); }
 
-			current_index += syncFlagSize;
+		_RxHandler->process_received_message(name_buffer,
+						     data_length,
+						     const_cast<uint8_t *>(&data[current_index]));
+		current_index += data_length;
+	}
+}
+
+void mUORB::Aggregator::ParseCompact(const uint8_t *data, uint32_t length_in_bytes)
+{
+	uint32_t current_index = syncFlagSize;
+
+	pthread_mutex_lock(&rxMutex);
 
-			uint32_t name_length = *((uint32_t *) &data[current_index]);
+	while ((current_index + recordHeaderSize) <= length_in_bytes) {
+		const uint8_t type = data[current_index];
+		const uint16_t id = data[current_index + 1] | (data[current_index + 2] << 8);
+		const uint32_t length = data[current_index + 3] | (data[current_index + 4] << 8);
+		const uint8_t sequence = data[current_index + 5];
+		current_index += recordHeaderSize;
 
-			// Make sure name plus a terminating null can fit into our buffer
-			if (name_length > (name_buffer_length - 1)) {
-				PX4_ERR("Name length too long %u", name_length);
-				break;
+		if (length > (length_in_bytes - current_index)) {
+			PX4_ERR("Record too big %u. Remaining bytes %u", length, length_in_bytes - current_index);
+			break;
+		}
+
+		const uint8_t *payload = &data[current_index];
+		current_index += length;
+
+		if (type == RECORD_DEFINE) {
+			if (id >= rxTopics.size()) {
+				rxTopics.resize(id + 1);
 			}
 
-			current_index += topicNameLengthSize;
+			rxTopics[id].name.assign((const char *) payload, length);
+			rxTopics[id].previous.clear();
+			rxTopics[id].synced = false;
+
+			if (debugFlag) { PX4_INFO("Topic id %u: %s", id, rxTopics[id].name.c_str()); }
+
+			continue;
+		}
+
+		if ((type != RECORD_DATA) && (type != RECORD_DELTA)) {
+			PX4_ERR("Unknown record type %u", type);
+			break;
+		}
+
+		if ((id >= rxTopics.size()) || rxTopics[id].name.empty()) {
+			// defined before we started listening, the sender refreshes its ids periodically
+			if (debugFlag) { PX4_INFO("Dropping record for unknown topic id %u", id); }
+
+			continue;
+		}
+
+		RxTopic &topic = rxTopics[id];
 
-			uint32_t data_length = *((uint32_t *) &data[current_index]);
-			current_index += dataLengthSize;
+		if (type == RECORD_DATA) {
+			topic.previous.assign(payload, payload + length);
 
-			int32_t payload_size = name_length + data_length;
-			int32_t remaining_bytes = length_in_bytes - current_index;
+		} else {
+			// a lost or out of order record leaves previous stale until the next full message
+			bool decoded = topic.synced && (sequence == (uint8_t)(topic.sequence + 1));
 
-			if (payload_size > remaining_bytes) {
-				PX4_ERR("Payload too big %u. Remaining bytes %d", payload_size, remaining_bytes);
-				break;
+			if (decoded) {
+				rxScratch.assign(topic.previous.begin(), topic.previous.end());
+				decoded = DecodeDelta(payload, length, rxScratch.data(), rxScratch.size());
 			}
 
-			memcpy(name_buffer, &data[current_index], name_length);
-			name_buffer[name_length] = 0;
+			if (!decoded) {
+				if (debugFlag) { PX4_INFO("Dropping delta for %s", topic.name.c_str()); }
 
-			current_index += name_length;
+				topic.synced = false;
+				continue;
+			}
+
+			topic.previous.swap(rxScratch);
+		}
+
+		topic.sequence = sequence;
+		topic.synced = true;
+
+		_RxHandler->process_received_message(topic.name.c_str(), topic.previous.size(), topic.previous.data());
+	}
+
+	pthread_mutex_unlock(&rxMutex);
+}
+
+void mUORB::Aggregator::ProcessReceivedTopic(const char *topic, const uint8_t *data, uint32_t length_in_bytes)
+{
+	if (isAggregate(topic)) {
+		if (debugFlag) { PX4_INFO("Parsing aggregate buffer of length %u", length_in_bytes); }
+
+		uint32_t sync_flag = 0;
+
+		if (length_in_bytes >= syncFlagSize) {
+			memcpy(&sync_flag, data, syncFlagSize);
+		}
 
-			if (debugFlag) { PX4_INFO("Parsed topic: %s, name length %u, data length: %u", name_buffer, name_length, data_length); }
+		if (sync_flag == compactFlag) {
+			ParseCompact(data, length_in_bytes);
 
-			_RxHandler->process_received_message(name_buffer,
-							     data_length,
-							     const_cast<uint8_t *>(&data[current_index]));
-			current_index += data_length;
+		} else {
+			ParseLegacy(data, length_in_bytes);
 		}
 
 	} else {
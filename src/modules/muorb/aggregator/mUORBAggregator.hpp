@@ -33,8 +33,11 @@
 
 #pragma once
 
+#include <map>
 #include <string>
+#include <vector>
 #include <string.h>
+#include <pthread.h>
 #include "uORB/uORBCommunicator.hpp"
 
 namespace mUORB
@@ -55,6 +58,12 @@ public:
 
 	int16_t SendData();
 
+	/**
+	 * Send the buffer once its oldest record has waited maxLatencyUs.
+	 * @return time in microseconds until the buffer has to be checked again
+	 */
+	uint32_t SendDataIfDue(uint64_t now);
+
 private:
 	static const bool debugFlag;
 
@@ -63,6 +72,9 @@ private:
 	// Master flag to enable aggregation
 	const bool aggregationEnabled = true;
 
+	// Send topic ids instead of names and only the bytes that changed since the previous message
+	const bool compressionEnabled = true;
+
 	const uint32_t syncFlag = 0x5A01FF00;
 	const uint32_t syncFlagSize = 4;
 	const uint32_t topicNameLengthSize = 4;
@@ -71,10 +83,62 @@ private:
 	static const uint32_t numBuffers = 2;
 	static const uint32_t bufferSize = 2048;
 
+	// Compact format: the buffer starts with compactFlag, followed by records with a
+	// 6 byte header (type, 16 bit topic id, 16 bit length, sequence number) and the payload.
+	const uint32_t compactFlag = 0x5A03FF00;
+	static const uint32_t recordHeaderSize = 6;
+
+	enum RecordType : uint8_t {
+		RECORD_DEFINE = 1,	// payload is the topic name for the id
+		RECORD_DATA,		// payload is the message
+		RECORD_DELTA,		// payload are (unchanged count, changed count, changed bytes) runs against the previous message
+	};
+
+	// The receiver learns the ids from the stream, so they are sent again periodically
+	// in case it restarted or missed a buffer.
+	static const uint64_t dictionaryRefreshUs = 1000000;
+
+	// The data and delta records of a topic are numbered, a delta only applies to the
+	// record right before it. After a gap the receiver drops deltas until the next full
+	// message, which is sent at least every keyframeInterval records.
+	static const uint8_t keyframeInterval = 32;
+
+	// Longest a record waits in a buffer that isn't full
+	static const uint32_t maxLatencyUs = 2000;
+
+	// Flush early when a buffer is almost full, the next record would probably not fit
+	static const uint32_t flushThreshold = bufferSize - 64;
+
 	uint32_t bufferId;
 	uint32_t bufferWriteIndex;
 	uint8_t  buffer[numBuffers][bufferSize];
 
+	uint64_t bufferFirstRecordTime{0};
+
+	struct TxTopic {
+		bool defined{false};
+		std::vector<uint8_t> previous;
+		uint8_t sequence{0};
+		uint8_t deltas{0};	// since the last full message
+	};
+
+	std::map<std::string, uint16_t, std::less<>> txTopicIds;
+	std::vector<TxTopic> txTopics;
+	uint64_t txDictionaryTime{0};
+
+	struct RxTopic {
+		std::string name;
+		std::vector<uint8_t> previous;
+		uint8_t sequence{0};
+		bool synced{false};	// previous is the message the next delta applies to
+	};
+
+	std::vector<RxTopic> rxTopics;
+	std::vector<uint8_t> rxScratch;	// a delta is decoded here, previous only changes if it succeeds
+	pthread_mutex_t rxMutex = PTHREAD_MUTEX_INITIALIZER;
+
+	uint8_t deltaBuffer[bufferSize];
+
 	uORBCommunicator::IChannelRxHandler *_RxHandler;
 
 	sendFuncPtr sendFunc;
@@ -86,6 +150,21 @@ private:
 	void MoveToNextBuffer();
 
 	void AddRecordToBuffer(const char *messageName, int32_t length, const uint8_t *data);
+
+	int16_t AddCompactRecordToBuffer(const char *messageName, int32_t length, const uint8_t *data);
+
+	void WriteRecord(RecordType type, uint16_t id, uint8_t sequence, const uint8_t *data, uint32_t length);
+
+	void ResetTransmitDictionary();
+
+	static bool EncodeDelta(const uint8_t *previous, const uint8_t *data, uint32_t length, uint8_t *delta,
+				uint32_t &delta_length);
+
+	static bool DecodeDelta(const uint8_t *delta, uint32_t delta_length, uint8_t *data, uint32_t length);
+
+	void ParseLegacy(const uint8_t *data, uint32_t length_in_bytes);
+
+	void ParseCompact(const uint8_t *data, uint32_t length_in_bytes);
 };
 
 }
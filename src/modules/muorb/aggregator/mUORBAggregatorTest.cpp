@@ -0,0 +1,191 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Test code for the compact format of the muorb aggregator
+ * Built with the uORB tests (platforms/common/uORB/test), run with make tests TESTFILTER=mUORBAggregator
+ */
+
+#include <gtest/gtest.h>
+
+#include <string.h>
+#include <vector>
+
+#include "mUORBAggregator.hpp"
+
+namespace
+{
+
+struct Message {
+	uint32_t counter;
+	float values[15];
+};
+
+std::vector<std::vector<uint8_t>> sent_buffers;
+
+int capture_send(const char *topic, const uint8_t *data, int length)
+{
+	sent_buffers.emplace_back(data, data + length);
+	return 0;
+}
+
+class Receiver : public uORBCommunicator::IChannelRxHandler
+{
+public:
+	int16_t process_remote_topic(const char *topic_name) override { return 0; }
+	int16_t process_add_subscription(const char *messageName) override { return 0; }
+	int16_t process_remove_subscription(const char *messageName) override { return 0; }
+
+	int16_t process_received_message(const char *messageName, int32_t length, uint8_t *data) override
+	{
+		EXPECT_STREQ(messageName, "sensor_accel");
+		EXPECT_EQ(length, (int32_t)sizeof(Message));
+
+		Message message{};
+		memcpy(&message, data, sizeof(message));
+		received.push_back(message);
+		return 0;
+	}
+
+	std::vector<Message> received;
+};
+
+// a slowly changing message, most bytes repeat so it is sent as delta
+Message make_message(uint32_t counter)
+{
+	Message message{};
+	message.counter = counter;
+
+	for (int i = 0; i < 15; i++) {
+		message.values[i] = (float)i;
+	}
+
+	message.values[counter % 15] = (float)counter;
+	return message;
+}
+
+// one aggregated buffer per message
+void send_messages(mUORB::Aggregator &sender, uint32_t count)
+{
+	for (uint32_t counter = 0; counter < count; counter++) {
+		const Message message = make_message(counter);
+		sender.ProcessTransmitTopic("sensor_accel", (const uint8_t *)&message, sizeof(message));
+		sender.SendData();
+	}
+}
+
+} // namespace
+
+class mUORBAggregatorTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		sent_buffers.clear();
+		sender.RegisterSendHandler(&capture_send);
+		receiver_aggregator.RegisterHandler(&receiver);
+	}
+
+	// every message that comes out must be the one that was sent
+	void expect_intact()
+	{
+		for (const Message &message : receiver.received) {
+			const Message expected = make_message(message.counter);
+			EXPECT_EQ(memcmp(&message, &expected, sizeof(message)), 0) << "corrupt message " << message.counter;
+		}
+	}
+
+	mUORB::Aggregator sender{};
+	mUORB::Aggregator receiver_aggregator{};
+	Receiver receiver;
+};
+
+TEST_F(mUORBAggregatorTest, RoundTrip)
+{
+	send_messages(sender, 100);
+	ASSERT_EQ(sent_buffers.size(), 100u);
+
+	// the later ones are deltas, smaller than the message
+	EXPECT_LT(sent_buffers[50].size(), sizeof(Message));
+
+	for (const auto &buffer : sent_buffers) {
+		receiver_aggregator.ProcessReceivedTopic("aggregation", buffer.data(), buffer.size());
+	}
+
+	ASSERT_EQ(receiver.received.size(), 100u);
+
+	for (uint32_t counter = 0; counter < 100; counter++) {
+		EXPECT_EQ(receiver.received[counter].counter, counter);
+	}
+
+	expect_intact();
+}
+
+TEST_F(mUORBAggregatorTest, RecoversFromLostBuffer)
+{
+	send_messages(sender, 100);
+
+	// lose one buffer in the middle of a run of deltas
+	static constexpr size_t lost = 10;
+	sent_buffers.erase(sent_buffers.begin() + lost);
+
+	for (const auto &buffer : sent_buffers) {
+		receiver_aggregator.ProcessReceivedTopic("aggregation", buffer.data(), buffer.size());
+	}
+
+	// the deltas after the gap are dropped, not applied to the stale message
+	expect_intact();
+	ASSERT_FALSE(receiver.received.empty());
+	EXPECT_LT(receiver.received.size(), 99u);
+
+	// and the next full message resynchronizes the topic
+	EXPECT_EQ(receiver.received.back().counter, 99u);
+}
+
+TEST_F(mUORBAggregatorTest, IgnoresCorruptDelta)
+{
+	send_messages(sender, 3);
+	ASSERT_EQ(sent_buffers.size(), 3u);
+
+	// a delta that runs past the end of the message is rejected as a whole,
+	// corrupt its first run length (after the 4 byte flag and the 6 byte record header)
+	std::vector<uint8_t> corrupt = sent_buffers[2];
+	corrupt[4 + 6] = 0xFF;
+
+	receiver_aggregator.ProcessReceivedTopic("aggregation", sent_buffers[0].data(), sent_buffers[0].size());
+	receiver_aggregator.ProcessReceivedTopic("aggregation", sent_buffers[1].data(), sent_buffers[1].size());
+	receiver_aggregator.ProcessReceivedTopic("aggregation", corrupt.data(), corrupt.size());
+
+	ASSERT_EQ(receiver.received.size(), 2u);
+	expect_intact();
+}
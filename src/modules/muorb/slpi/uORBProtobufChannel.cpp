@@ -81,10 +81,8 @@ static void aggregator_thread_func(void *ptr)
 	uORB::ProtobufChannel *muorb = uORB::ProtobufChannel::GetInstance();
 
 	while (true) {
-		// Check for timeout. Send buffer if timeout happened.
-		muorb->SendAggregateData();
-
-		qurt_timer_sleep(2000);
+		// Send the buffer once its oldest record is due, then sleep until the next one can be
+		qurt_timer_sleep(muorb->SendAggregateData());
 	}
 
 	qurt_thread_exit(QURT_EOK);
@@ -40,6 +40,8 @@
 #include <pthread.h>
 #include <termios.h>
 
+#include <drivers/drv_hrt.h>
+
 #include "uORB/uORBCommunicator.hpp"
 #include "mUORBAggregator.hpp"
 
@@ -154,11 +156,12 @@ public:
 
 	bool DebugEnabled()	{ return _debug; }
 
-	void SendAggregateData()
+	uint32_t SendAggregateData()
 	{
 		pthread_mutex_lock(&_tx_mutex);
-		_Aggregator.SendData();
+		uint32_t next_check_us = _Aggregator.SendDataIfDue(hrt_absolute_time());
 		pthread_mutex_unlock(&_tx_mutex);
+		return next_check_us;
 	}
 
 private:
@@ -0,0 +1,106 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file ballistics.cpp
+ */
+
+#include "ballistics.h"
+
+#include <float.h>
+#include <lib/geo/geo.h>
+
+namespace ballistics
+{
+
+using matrix::Vector3f;
+
+static inline Vector3f acceleration(const Vector3f &v, const Vector3f &wind, const Vector3f &drag)
+{
+	const Vector3f v_rel = v - wind;
+	return Vector3f(0.f, 0.f, CONSTANTS_ONE_G) - drag.emult(v_rel) * v_rel.norm();
+}
+
+bool solve(const Body &body, const ReleaseState &state, Solution &solution, float step)
+{
+	if (!(body.mass > FLT_EPSILON) || !(body.drag_coef >= 0.f) || !(body.area_x >= 0.f) || !(body.area_y >= 0.f)
+	    || !(state.height > 0.f) || !(state.air_density >= 0.f) || !(step > FLT_EPSILON)
+	    || !state.velocity.isAllFinite() || !state.wind.isAllFinite()) {
+		return false;
+	}
+
+	// per-axis drag factor rho * Cd * A / (2 m)
+	const float k = 0.5f * state.air_density * body.drag_coef / body.mass;
+	const Vector3f drag(k * body.area_x, k * body.area_x, k * body.area_y);
+	const Vector3f wind(state.wind(0), state.wind(1), 0.f);
+
+	Vector3f p{};
+	Vector3f v = state.velocity;
+	float t = 0.f;
+
+	const int max_steps = static_cast<int>(kMaxFallTime / step) + 1;
+
+	for (int i = 0; i < max_steps; i++) {
+		const Vector3f k1v = acceleration(v, wind, drag);
+		const Vector3f k1p = v;
+		const Vector3f k2v = acceleration(v + k1v * (0.5f * step), wind, drag);
+		const Vector3f k2p = v + k1v * (0.5f * step);
+		const Vector3f k3v = acceleration(v + k2v * (0.5f * step), wind, drag);
+		const Vector3f k3p = v + k2v * (0.5f * step);
+		const Vector3f k4v = acceleration(v + k3v * step, wind, drag);
+		const Vector3f k4p = v + k3v * step;
+
+		const Vector3f p_next = p + (k1p + 2.f * k2p + 2.f * k3p + k4p) * (step / 6.f);
+		const Vector3f v_next = v + (k1v + 2.f * k2v + 2.f * k3v + k4v) * (step / 6.f);
+
+		if (p_next(2) >= state.height) {
+			// ground crossed during this step, interpolate to the exact height
+			const float dz = p_next(2) - p(2);
+			const float frac = dz > FLT_EPSILON ? (state.height - p(2)) / dz : 1.f;
+
+			const Vector3f p_impact = p + (p_next - p) * frac;
+			solution.offset = matrix::Vector2f(p_impact(0), p_impact(1));
+			solution.impact_velocity = v + (v_next - v) * frac;
+			solution.time_of_fall = t + frac * step;
+			return true;
+		}
+
+		p = p_next;
+		v = v_next;
+		t += step;
+	}
+
+	return false;
+}
+
+} // namespace ballistics
@@ -0,0 +1,101 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file ballistics.h
+ *
+ * Free-fall solver for a released payload with quadratic air drag.
+ *
+ * The payload is modelled as a point mass m falling through air moving
+ * with a constant horizontal wind w. In the NED frame
+ *
+ *   dp/dt = v
+ *   dv/dt = g * e_z - (rho * Cd / (2 m)) * |v - w| * A (v - w)
+ *
+ * where A = diag(area_x, area_x, area_y): area_x is the cross-section
+ * exposed to horizontal airflow and area_y the one exposed to vertical
+ * airflow. The system is integrated with a fixed-step RK4 scheme on the
+ * stack only, so a solve is bounded by kMaxFallTime / step evaluations.
+ */
+
+#pragma once
+
+#include <matrix/matrix/math.hpp>
+
+namespace ballistics
+{
+
+static constexpr float kDefaultStep = 0.05f;  ///< default integration step (s)
+static constexpr float kMaxFallTime = 120.f;  ///< integration is aborted past this time of fall (s)
+
+/**
+ * Aerodynamic properties of the released body
+ */
+struct Body {
+	float mass;      ///< kg
+	float area_x;    ///< cross-section normal to horizontal airflow (m^2)
+	float area_y;    ///< cross-section normal to vertical airflow (m^2)
+	float drag_coef; ///< dimensionless drag coefficient
+};
+
+/**
+ * Vehicle and environment state at the moment of release
+ */
+struct ReleaseState {
+	matrix::Vector3f velocity{}; ///< NED ground velocity of the vehicle (m/s)
+	matrix::Vector2f wind{};     ///< NE wind velocity (m/s)
+	float height{0.f};           ///< height of the release point above the target (m)
+	float air_density{1.225f};   ///< kg/m^3
+};
+
+/**
+ * Result of a single fall integration
+ */
+struct Solution {
+	matrix::Vector2f offset{};         ///< NE displacement from release point to impact point (m)
+	matrix::Vector3f impact_velocity{}; ///< NED ground velocity at impact (m/s)
+	float time_of_fall{0.f};           ///< s
+};
+
+/**
+ * Integrate the fall of a body from release until it has descended by state.height.
+ *
+ * @param body aerodynamic properties of the payload
+ * @param state release conditions
+ * @param solution output, only written on success
+ * @param step integration step (s)
+ * @return false if the inputs are invalid or the body does not reach the ground within kMaxFallTime
+ */
+bool solve(const Body &body, const ReleaseState &state, Solution &solution, float step = kDefaultStep);
+
+} // namespace ballistics
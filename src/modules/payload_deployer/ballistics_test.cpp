@@ -0,0 +1,127 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Test code for the payload ballistic solver
+ * Run this test only using make tests TESTFILTER=ballistics
+ */
+
+#include <gtest/gtest.h>
+#include <lib/geo/geo.h>
+
+#include "ballistics.h"
+
+using namespace ballistics;
+using matrix::Vector2f;
+using matrix::Vector3f;
+
+static constexpr Body kSphere{0.3f, 0.007f, 0.007f, 0.47f};
+
+TEST(BallisticsTest, VacuumMatchesAnalytic)
+{
+	const Body body{1.f, 0.f, 0.f, 0.f};
+	ReleaseState state{};
+	state.velocity = Vector3f(20.f, -5.f, 0.f);
+	state.height = 200.f;
+
+	Solution solution{};
+	ASSERT_TRUE(solve(body, state, solution));
+
+	const float t = sqrtf(2.f * state.height / CONSTANTS_ONE_G);
+	EXPECT_NEAR(solution.time_of_fall, t, 1e-3f);
+	EXPECT_NEAR(solution.offset(0), 20.f * t, 1e-2f);
+	EXPECT_NEAR(solution.offset(1), -5.f * t, 1e-2f);
+	EXPECT_NEAR(solution.impact_velocity(2), CONSTANTS_ONE_G * t, 1e-2f);
+}
+
+TEST(BallisticsTest, ReachesTerminalVelocity)
+{
+	ReleaseState state{};
+	state.height = 2000.f;
+
+	Solution solution{};
+	ASSERT_TRUE(solve(kSphere, state, solution));
+
+	const float v_terminal = sqrtf(2.f * kSphere.mass * CONSTANTS_ONE_G
+				       / (state.air_density * kSphere.drag_coef * kSphere.area_y));
+	EXPECT_NEAR(solution.impact_velocity(2), v_terminal, 0.01f * v_terminal);
+	EXPECT_GT(solution.time_of_fall, sqrtf(2.f * state.height / CONSTANTS_ONE_G));
+}
+
+TEST(BallisticsTest, DragShortensThrowAndWindCarriesBody)
+{
+	ReleaseState state{};
+	state.velocity = Vector3f(25.f, 0.f, 0.f);
+	state.height = 150.f;
+
+	Solution no_wind{};
+	ASSERT_TRUE(solve(kSphere, state, no_wind));
+	EXPECT_LT(no_wind.offset(0), 25.f * no_wind.time_of_fall);
+	EXPECT_NEAR(no_wind.offset(1), 0.f, 1e-4f);
+
+	state.wind = Vector2f(0.f, 8.f);
+	Solution cross_wind{};
+	ASSERT_TRUE(solve(kSphere, state, cross_wind));
+	EXPECT_GT(cross_wind.offset(1), 0.f);
+	EXPECT_LT(cross_wind.offset(1), 8.f * cross_wind.time_of_fall);
+}
+
+TEST(BallisticsTest, StepSizeConvergence)
+{
+	ReleaseState state{};
+	state.velocity = Vector3f(30.f, 10.f, -2.f);
+	state.wind = Vector2f(-6.f, 3.f);
+	state.height = 300.f;
+
+	Solution coarse{};
+	Solution fine{};
+	ASSERT_TRUE(solve(kSphere, state, coarse));
+	ASSERT_TRUE(solve(kSphere, state, fine, 0.001f));
+	EXPECT_LT((coarse.offset - fine.offset).norm(), 0.05f);
+	EXPECT_NEAR(coarse.time_of_fall, fine.time_of_fall, 1e-3f);
+}
+
+TEST(BallisticsTest, RejectsInvalidInput)
+{
+	ReleaseState state{};
+	Solution solution{};
+
+	state.height = 0.f;
+	EXPECT_FALSE(solve(kSphere, state, solution));
+
+	state.height = 100.f;
+	EXPECT_FALSE(solve(Body{0.f, 0.01f, 0.01f, 0.5f}, state, solution));
+
+	state.velocity(0) = NAN;
+	EXPECT_FALSE(solve(kSphere, state, solution));
+}
@@ -0,0 +1,150 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file deploy_worker.cpp
+ */
+
+#include "deploy_worker.h"
+#include "payload_deployer.h"
+
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/tasks.h>
+
+DeployWorker::~DeployWorker()
+{
+	if (_joinable) {
+		/* wait for thread to complete */
+		int ret = pthread_join(_thread_handle, nullptr);
+
+		if (ret) {
+			PX4_ERR("join failed: %d", ret);
+		}
+	}
+}
+
+void DeployWorker::startCommand(const vehicle_command_s &command)
+{
+	if (isBusy()) {
+		return;
+	}
+
+	_command = command;
+	start(Request::Command);
+}
+
+void DeployWorker::startManifest(const payload_manifest_s &manifest)
+{
+	if (isBusy()) {
+		return;
+	}
+
+	_manifest = manifest;
+	start(Request::Manifest);
+}
+
+void DeployWorker::startRestore()
+{
+	if (isBusy()) {
+		return;
+	}
+
+	start(Request::Restore);
+}
+
+void DeployWorker::start(Request request)
+{
+	// collect the previous thread, it has finished
+	if (_joinable) {
+		pthread_join(_thread_handle, nullptr);
+		_joinable = false;
+	}
+
+	_request = request;
+
+	/* initialize low priority thread */
+	pthread_attr_t low_prio_attr;
+	pthread_attr_init(&low_prio_attr);
+	pthread_attr_setstacksize(&low_prio_attr, PX4_STACK_ADJUSTED(3000));
+
+	struct sched_param param;
+	pthread_attr_getschedparam(&low_prio_attr, &param);
+
+	/* low priority */
+	param.sched_priority = SCHED_PRIORITY_DEFAULT - 50;
+	pthread_attr_setschedparam(&low_prio_attr, &param);
+
+	_state.store((int)State::Running);
+	int ret = pthread_create(&_thread_handle, &low_prio_attr, &threadEntryTrampoline, this);
+	pthread_attr_destroy(&low_prio_attr);
+
+	if (ret == 0) {
+		_joinable = true;
+
+	} else {
+		PX4_ERR("Failed to start thread (%i)", ret);
+		_result = vehicle_command_ack_s::VEHICLE_CMD_RESULT_FAILED;
+		_accepted = 0;
+		_rejected = _manifest.count;
+		_state.store((int)State::Finished);
+	}
+}
+
+void *DeployWorker::threadEntryTrampoline(void *arg)
+{
+	DeployWorker *worker = (DeployWorker *)arg;
+	worker->threadEntry();
+	return nullptr;
+}
+
+void DeployWorker::threadEntry()
+{
+	px4_prctl(PR_SET_NAME, "payload_deployer_low_prio", px4_getpid());
+
+	switch (_request) {
+	case Request::Command:
+		_result = PayloadDeployer::execute_command(_command);
+		break;
+
+	case Request::Manifest:
+		PayloadDeployer::apply_manifest(_manifest, _accepted, _rejected);
+		break;
+
+	case Request::Restore:
+		PayloadDeployer::load_payloads();
+		break;
+	}
+
+	_state.store((int)State::Finished); // set this last to signal the work queue we're done
+}
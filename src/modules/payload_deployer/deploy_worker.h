@@ -0,0 +1,104 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file deploy_worker.h
+ *
+ * Low priority background thread, started on demand, running the requests of
+ * the payload_deployer that block on dataman or take long to compute, so
+ * they stay off the work queue:
+ * - launching, which writes the mission
+ * - retargeting and manifest batches, which rebuild drop tables
+ * - loading the persistent manifest at startup, which builds all drop tables
+ */
+
+#pragma once
+
+#include <px4_platform_common/atomic.h>
+#include <px4_platform_common/posix.h>
+#include <uORB/topics/payload_manifest.h>
+#include <uORB/topics/vehicle_command.h>
+
+class DeployWorker
+{
+public:
+	enum class Request {
+		Command,  ///< vehicle_command, the result is a vehicle_command_ack result
+		Manifest, ///< payload_manifest batch
+		Restore   ///< persistent manifest
+	};
+
+	DeployWorker() = default;
+	~DeployWorker();
+
+	void startCommand(const vehicle_command_s &command);
+	void startManifest(const payload_manifest_s &manifest);
+	void startRestore();
+
+	bool isBusy() const { return _state.load() != (int)State::Idle; }
+	bool hasResult() const { return _state.load() == (int)State::Finished; }
+	void reset() { _state.store((int)State::Idle); }
+
+	Request request() const { return _request; }
+	const vehicle_command_s &command() const { return _command; }
+	const payload_manifest_s &manifest() const { return _manifest; }
+
+	uint8_t result() const { return _result; }  ///< vehicle_command_ack result of a command
+	uint8_t accepted() const { return _accepted; }  ///< manifest entries added or replaced
+	uint8_t rejected() const { return _rejected; }  ///< manifest entries that were invalid
+
+private:
+	enum class State {
+		Idle,
+		Running,
+		Finished
+	};
+
+	void start(Request request);
+
+	static void *threadEntryTrampoline(void *arg);
+	void threadEntry();
+
+	px4::atomic_int _state{(int)State::Idle};
+	pthread_t _thread_handle{};
+	bool _joinable{false};
+	Request _request{Request::Command};
+
+	vehicle_command_s _command{};
+	payload_manifest_s _manifest{};
+
+	uint8_t _result{0};
+	uint8_t _accepted{0};
+	uint8_t _rejected{0};
+};
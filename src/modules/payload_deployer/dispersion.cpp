@@ -0,0 +1,403 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file dispersion.cpp
+ */
+
+#include "dispersion.h"
+
+#include <float.h>
+#include <math.h>
+#include <new>
+#include <lib/geo/geo.h>
+
+#ifdef __PX4_POSIX
+#include <pthread.h>
+#endif
+
+namespace ballistics
+{
+
+namespace
+{
+
+/** xorshift32, seeded per block so the samples don't depend on the thread split */
+class Random
+{
+public:
+	explicit Random(uint32_t seed) : _state(seed != 0 ? seed : 0x9e3779b9u) {}
+
+	/** uniform in (0, 1] */
+	float uniform()
+	{
+		_state ^= _state << 13;
+		_state ^= _state >> 17;
+		_state ^= _state << 5;
+		return ((_state >> 8) + 1) * (1.f / 16777216.f);
+	}
+
+	/** standard normal, Box-Muller */
+	float normal()
+	{
+		if (_has_spare) {
+			_has_spare = false;
+			return _spare;
+		}
+
+		const float r = sqrtf(-2.f * logf(uniform()));
+		const float phi = 2.f * M_PI_F * uniform();
+		_spare = r * sinf(phi);
+		_has_spare = true;
+		return r * cosf(phi);
+	}
+
+private:
+	uint32_t _state;
+	float _spare{0.f};
+	bool _has_spare{false};
+};
+
+/** state of a block of samples, one lane per sample */
+struct Lanes {
+	float px[kBlock], py[kBlock], pz[kBlock];
+	float vx[kBlock], vy[kBlock], vz[kBlock];
+	float wx[kBlock], wy[kBlock];
+	float kh[kBlock], kv[kBlock];   // horizontal and vertical drag factor rho * Cd * A / (2 m)
+	float height[kBlock];
+};
+
+struct Job {
+	const Body *body;
+	const ReleaseState *state;
+	const Uncertainty *uncertainty;
+	uint32_t seed;
+	float step;
+	int first_block;
+	int blocks;
+	float *x;           // NE impact offsets by sample
+	float *y;
+	uint8_t *landed;
+};
+
+static inline void acceleration(const Lanes &l, const float *vx, const float *vy, const float *vz,
+				float *ax, float *ay, float *az)
+{
+	for (int i = 0; i < kBlock; i++) {
+		const float rx = vx[i] - l.wx[i];
+		const float ry = vy[i] - l.wy[i];
+		const float rz = vz[i];
+		const float speed = sqrtf(rx * rx + ry * ry + rz * rz);
+		ax[i] = -l.kh[i] * speed * rx;
+		ay[i] = -l.kh[i] * speed * ry;
+		az[i] = CONSTANTS_ONE_G - l.kv[i] * speed * rz;
+	}
+}
+
+static void sample(const Job &job, Random &random, Lanes &l, float *offset_x, float *offset_y)
+{
+	const Body &body = *job.body;
+	const ReleaseState &state = *job.state;
+	const Uncertainty &u = *job.uncertainty;
+
+	for (int i = 0; i < kBlock; i++) {
+		const float drag_coef = body.drag_coef * (1.f + u.drag_tolerance * (2.f * random.uniform() - 1.f));
+		const float k = 0.5f * state.air_density * drag_coef / body.mass;
+
+		l.px[i] = 0.f;
+		l.py[i] = 0.f;
+		l.pz[i] = 0.f;
+		l.vx[i] = state.velocity(0) + u.velocity_h * random.normal();
+		l.vy[i] = state.velocity(1) + u.velocity_h * random.normal();
+		l.vz[i] = state.velocity(2) + u.velocity_v * random.normal();
+		l.wx[i] = state.wind(0) + u.wind(0) * random.normal();
+		l.wy[i] = state.wind(1) + u.wind(1) * random.normal();
+		l.kh[i] = k * body.area_x;
+		l.kv[i] = k * body.area_y;
+		l.height[i] = fmaxf(state.height + u.height * random.normal(), 0.1f);
+		offset_x[i] = u.position_h * random.normal();
+		offset_y[i] = u.position_h * random.normal();
+	}
+}
+
+static void integrate(const Job &job, int block, Lanes &l)
+{
+	const float h = job.step;
+	const int max_steps = static_cast<int>(kMaxFallTime / h) + 1;
+	int remaining = kBlock;
+
+	float ax[4][kBlock], ay[4][kBlock], az[4][kBlock];
+	float ux[3][kBlock], uy[3][kBlock], uz[3][kBlock]; // velocities of the stages 2 to 4
+	bool landed[kBlock] {};
+
+	float *x = job.x + block * kBlock;
+	float *y = job.y + block * kBlock;
+	uint8_t *landed_out = job.landed + block * kBlock;
+
+	for (int n = 0; n < max_steps && remaining > 0; n++) {
+		acceleration(l, l.vx, l.vy, l.vz, ax[0], ay[0], az[0]);
+
+		for (int s = 0; s < 3; s++) {
+			const float dt = s < 2 ? 0.5f * h : h;
+
+			for (int i = 0; i < kBlock; i++) {
+				ux[s][i] = l.vx[i] + ax[s][i] * dt;
+				uy[s][i] = l.vy[i] + ay[s][i] * dt;
+				uz[s][i] = l.vz[i] + az[s][i] * dt;
+			}
+
+			acceleration(l, ux[s], uy[s], uz[s], ax[s + 1], ay[s + 1], az[s + 1]);
+		}
+
+		for (int i = 0; i < kBlock; i++) {
+			const float pz_next = l.pz[i] + (l.vz[i] + 2.f * uz[0][i] + 2.f * uz[1][i] + uz[2][i]) * (h / 6.f);
+
+			if (!landed[i] && pz_next >= l.height[i]) {
+				// ground crossed during this step, interpolate to the exact height
+				const float px_next = l.px[i] + (l.vx[i] + 2.f * ux[0][i] + 2.f * ux[1][i] + ux[2][i]) * (h / 6.f);
+				const float py_next = l.py[i] + (l.vy[i] + 2.f * uy[0][i] + 2.f * uy[1][i] + uy[2][i]) * (h / 6.f);
+				const float dz = pz_next - l.pz[i];
+				const float frac = dz > FLT_EPSILON ? (l.height[i] - l.pz[i]) / dz : 1.f;
+				x[i] += l.px[i] + (px_next - l.px[i]) * frac;
+				y[i] += l.py[i] + (py_next - l.py[i]) * frac;
+				landed[i] = true;
+				landed_out[i] = 1;
+				remaining--;
+			}
+		}
+
+		for (int i = 0; i < kBlock; i++) {
+			l.px[i] += (l.vx[i] + 2.f * ux[0][i] + 2.f * ux[1][i] + ux[2][i]) * (h / 6.f);
+			l.py[i] += (l.vy[i] + 2.f * uy[0][i] + 2.f * uy[1][i] + uy[2][i]) * (h / 6.f);
+			l.pz[i] += (l.vz[i] + 2.f * uz[0][i] + 2.f * uz[1][i] + uz[2][i]) * (h / 6.f);
+			l.vx[i] += (ax[0][i] + 2.f * ax[1][i] + 2.f * ax[2][i] + ax[3][i]) * (h / 6.f);
+			l.vy[i] += (ay[0][i] + 2.f * ay[1][i] + 2.f * ay[2][i] + ay[3][i]) * (h / 6.f);
+			l.vz[i] += (az[0][i] + 2.f * az[1][i] + 2.f * az[2][i] + az[3][i]) * (h / 6.f);
+		}
+	}
+}
+
+static void *run(void *arg)
+{
+	const Job &job = *static_cast<const Job *>(arg);
+	Lanes *lanes = new (std::nothrow) Lanes;
+
+	if (lanes == nullptr) {
+		return nullptr;
+	}
+
+	for (int b = job.first_block; b < job.first_block + job.blocks; b++) {
+		Random random(job.seed ^ (0x85ebca6bu * (b + 1)));
+		sample(job, random, *lanes, job.x + b * kBlock, job.y + b * kBlock);
+		integrate(job, b, *lanes);
+	}
+
+	delete lanes;
+	return nullptr;
+}
+
+/** k-th smallest value, reorders the values */
+static float select(float *values, int count, int k)
+{
+	int left = 0;
+	int right = count - 1;
+
+	while (left < right) {
+		const float pivot = values[(left + right) / 2];
+		int i = left;
+		int j = right;
+
+		while (i <= j) {
+			while (values[i] < pivot) { i++; }
+
+			while (values[j] > pivot) { j--; }
+
+			if (i <= j) {
+				const float tmp = values[i];
+				values[i] = values[j];
+				values[j] = tmp;
+				i++;
+				j--;
+			}
+		}
+
+		if (k <= j) {
+			right = j;
+
+		} else if (k >= i) {
+			left = i;
+
+		} else {
+			break;
+		}
+	}
+
+	return values[k];
+}
+
+} // namespace
+
+bool estimate_dispersion(const Body &body, const ReleaseState &state, const Uncertainty &uncertainty, int samples,
+			 uint32_t seed, Dispersion &dispersion, int threads, float step)
+{
+	Solution nominal{};
+
+	if (samples <= 0 || !(uncertainty.drag_tolerance >= 0.f) || !(uncertainty.drag_tolerance < 1.f)
+	    || !solve(body, state, nominal, step)) {
+		return false;
+	}
+
+	const int blocks = (samples + kBlock - 1) / kBlock;
+	const int count = blocks * kBlock;
+
+	float *x = new (std::nothrow) float[count] {};
+	float *y = new (std::nothrow) float[count] {};
+	uint8_t *landed = new (std::nothrow) uint8_t[count] {};
+
+	if (x == nullptr || y == nullptr || landed == nullptr) {
+		delete[] x;
+		delete[] y;
+		delete[] landed;
+		return false;
+	}
+
+#ifdef __PX4_POSIX
+	threads = threads < 1 ? 1 : (threads > kMaxThreads ? kMaxThreads : threads);
+	threads = threads > blocks ? blocks : threads;
+#else
+	threads = 1;
+#endif
+
+	Job jobs[kMaxThreads];
+
+	for (int t = 0; t < threads; t++) {
+		const int first = blocks * t / threads;
+		jobs[t] = {&body, &state, &uncertainty, seed, step, first, blocks * (t + 1) / threads - first, x, y, landed};
+	}
+
+#ifdef __PX4_POSIX
+	pthread_t handles[kMaxThreads] {};
+	bool started[kMaxThreads] {};
+
+	for (int t = 1; t < threads; t++) {
+		started[t] = pthread_create(&handles[t], nullptr, run, &jobs[t]) == 0;
+
+		if (!started[t]) {
+			run(&jobs[t]);
+		}
+	}
+
+	run(&jobs[0]);
+
+	for (int t = 1; t < threads; t++) {
+		if (started[t]) {
+			pthread_join(handles[t], nullptr);
+		}
+	}
+
+#else
+	run(&jobs[0]);
+#endif
+
+	// moments of the landed samples, kept compact at the front
+	int landed_count = 0;
+	double sum_x = 0.0;
+	double sum_y = 0.0;
+
+	for (int i = 0; i < count; i++) {
+		if (landed[i]) {
+			x[landed_count] = x[i];
+			y[landed_count] = y[i];
+			sum_x += (double)x[i];
+			sum_y += (double)y[i];
+			landed_count++;
+		}
+	}
+
+	delete[] landed;
+
+	if (landed_count < 2) {
+		delete[] x;
+		delete[] y;
+		return false;
+	}
+
+	const float mean_x = (float)(sum_x / landed_count);
+	const float mean_y = (float)(sum_y / landed_count);
+	double cxx = 0.0;
+	double cxy = 0.0;
+	double cyy = 0.0;
+
+	for (int i = 0; i < landed_count; i++) {
+		const float dx = x[i] - mean_x;
+		const float dy = y[i] - mean_y;
+		cxx += (double)dx * (double)dx;
+		cxy += (double)dx * (double)dy;
+		cyy += (double)dy * (double)dy;
+	}
+
+	cxx /= landed_count - 1;
+	cxy /= landed_count - 1;
+	cyy /= landed_count - 1;
+
+	// principal axes of the covariance
+	const double center = 0.5 * (cxx + cyy);
+	const double radius = sqrt(0.25 * (cxx - cyy) * (cxx - cyy) + cxy * cxy);
+
+	dispersion.nominal = nominal.offset;
+	dispersion.mean = matrix::Vector2f(mean_x, mean_y);
+	dispersion.major = (float)sqrt(center + radius);
+	dispersion.minor = (float)sqrt(fmax(center - radius, 0.0));
+	dispersion.orientation = (float)(0.5 * atan2(2.0 * cxy, cxx - cyy));
+	dispersion.samples = landed_count;
+
+	// radial distances reuse the x buffer, y holds the distances to the mean
+	for (int i = 0; i < landed_count; i++) {
+		const float dx = x[i] - nominal.offset(0);
+		const float dy = y[i] - nominal.offset(1);
+		const float mx = x[i] - mean_x;
+		const float my = y[i] - mean_y;
+		x[i] = sqrtf(dx * dx + dy * dy);
+		y[i] = sqrtf(mx * mx + my * my);
+	}
+
+	dispersion.cep = select(x, landed_count, landed_count / 2);
+	dispersion.cep_mean = select(y, landed_count, landed_count / 2);
+
+	delete[] x;
+	delete[] y;
+	return true;
+}
+
+} // namespace ballistics
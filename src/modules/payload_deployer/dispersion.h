@@ -0,0 +1,99 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file dispersion.h
+ *
+ * Monte-Carlo estimate of the impact dispersion of a payload.
+ *
+ * The release conditions are sampled from normal distributions around the
+ * nominal state, the drag coefficient uniformly within its tolerance, and
+ * every sample is integrated with the same RK4 scheme as ballistics::solve.
+ * The samples are integrated in blocks of kBlock lanes stored as structure
+ * of arrays, so the inner loops over the lanes vectorize. On POSIX the
+ * blocks are spread over several threads.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "ballistics.h"
+
+namespace ballistics
+{
+
+/**
+ * One standard deviation of the release conditions
+ */
+struct Uncertainty {
+	matrix::Vector2f wind{};     ///< NE wind (m/s)
+	float velocity_h{0.f};       ///< horizontal vehicle velocity, per axis (m/s)
+	float velocity_v{0.f};       ///< vertical vehicle velocity (m/s)
+	float position_h{0.f};       ///< horizontal release position, per axis (m)
+	float height{0.f};           ///< release height (m)
+	float drag_tolerance{0.f};   ///< relative drag coefficient tolerance, sampled uniformly within +-
+};
+
+struct Dispersion {
+	matrix::Vector2f nominal{};  ///< NE impact offset of the nominal release (m)
+	matrix::Vector2f mean{};     ///< NE mean impact offset (m)
+	float cep{0.f};              ///< radius around the nominal impact point holding half of the impacts (m)
+	float cep_mean{0.f};         ///< radius around the mean impact point holding half of the impacts (m)
+	float major{0.f};            ///< one sigma semi-major axis of the impact ellipse (m)
+	float minor{0.f};            ///< one sigma semi-minor axis of the impact ellipse (m)
+	float orientation{0.f};      ///< direction of the major axis, clockwise from north (rad)
+	int samples{0};              ///< samples that reached the ground
+};
+
+static constexpr int kBlock = 64;        ///< samples integrated together
+static constexpr int kMaxThreads = 8;
+
+/**
+ * Sample the impact points of a body released under uncertain conditions.
+ *
+ * @param body nominal aerodynamic properties
+ * @param state nominal release conditions
+ * @param uncertainty one standard deviation of the release conditions
+ * @param samples number of samples, rounded up to a multiple of kBlock
+ * @param seed random seed, the result is reproducible for the same seed, whatever the thread count
+ * @param dispersion output
+ * @param threads number of threads, only used on POSIX
+ * @param step integration step (s)
+ * @return false if the inputs are invalid, memory is short or the nominal fall can't be solved
+ */
+bool estimate_dispersion(const Body &body, const ReleaseState &state, const Uncertainty &uncertainty, int samples,
+			 uint32_t seed, Dispersion &dispersion, int threads = 1, float step = kDefaultStep);
+
+} // namespace ballistics
@@ -0,0 +1,125 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Test code for the impact dispersion estimate
+ * Run this test only using make tests TESTFILTER=dispersion
+ */
+
+#include <gtest/gtest.h>
+
+#include "dispersion.h"
+
+using matrix::Vector2f;
+using matrix::Vector3f;
+
+static constexpr ballistics::Body kSphere{0.3f, 0.007f, 0.007f, 0.47f};
+
+static ballistics::ReleaseState release()
+{
+	ballistics::ReleaseState state{};
+	state.velocity = Vector3f(15.f, 0.f, 0.f);
+	state.wind = Vector2f(-3.f, 2.f);
+	state.height = 80.f;
+	return state;
+}
+
+TEST(DispersionTest, NoUncertaintyMatchesSolver)
+{
+	const ballistics::ReleaseState state = release();
+	ballistics::Solution reference{};
+	ASSERT_TRUE(ballistics::solve(kSphere, state, reference));
+
+	ballistics::Dispersion dispersion{};
+	ASSERT_TRUE(ballistics::estimate_dispersion(kSphere, state, ballistics::Uncertainty{}, 256, 1, dispersion));
+
+	EXPECT_EQ(dispersion.samples, 256);
+	EXPECT_NEAR((dispersion.nominal - reference.offset).norm(), 0.f, 1e-4f);
+	EXPECT_NEAR((dispersion.mean - reference.offset).norm(), 0.f, 1e-2f);
+	EXPECT_LT(dispersion.cep, 1e-2f);
+	EXPECT_LT(dispersion.major, 1e-2f);
+}
+
+TEST(DispersionTest, ReproducibleAcrossThreads)
+{
+	ballistics::Uncertainty uncertainty{};
+	uncertainty.wind = Vector2f(1.f, 1.f);
+	uncertainty.velocity_h = 0.5f;
+	uncertainty.height = 2.f;
+	uncertainty.drag_tolerance = 0.1f;
+
+	ballistics::Dispersion single{};
+	ballistics::Dispersion parallel{};
+	ASSERT_TRUE(ballistics::estimate_dispersion(kSphere, release(), uncertainty, 1000, 7, single, 1));
+	ASSERT_TRUE(ballistics::estimate_dispersion(kSphere, release(), uncertainty, 1000, 7, parallel, 4));
+
+	EXPECT_EQ(single.samples, parallel.samples);
+	EXPECT_FLOAT_EQ(single.cep, parallel.cep);
+	EXPECT_FLOAT_EQ(single.major, parallel.major);
+	EXPECT_FLOAT_EQ(single.mean(0), parallel.mean(0));
+}
+
+TEST(DispersionTest, EllipseFollowsWindUncertainty)
+{
+	ballistics::Uncertainty uncertainty{};
+	uncertainty.wind = Vector2f(0.2f, 3.f);
+
+	ballistics::Dispersion dispersion{};
+	ASSERT_TRUE(ballistics::estimate_dispersion(kSphere, release(), uncertainty, 4096, 3, dispersion, 2));
+
+	// the east wind dominates, so the major axis points east
+	EXPECT_GT(dispersion.major, 3.f * dispersion.minor);
+	EXPECT_NEAR(fabsf(dispersion.orientation), M_PI_2_F, 0.1f);
+	EXPECT_GT(dispersion.cep, 0.5f * dispersion.minor);
+
+	ballistics::Uncertainty wider = uncertainty;
+	wider.wind *= 2.f;
+	ballistics::Dispersion wide{};
+	ASSERT_TRUE(ballistics::estimate_dispersion(kSphere, release(), wider, 4096, 3, wide, 2));
+	EXPECT_NEAR(wide.major, 2.f * dispersion.major, 0.2f * dispersion.major);
+	EXPECT_GT(wide.cep, dispersion.cep);
+}
+
+TEST(DispersionTest, InvalidInput)
+{
+	ballistics::Dispersion dispersion{};
+	ballistics::Uncertainty uncertainty{};
+	EXPECT_FALSE(ballistics::estimate_dispersion(kSphere, release(), uncertainty, 0, 1, dispersion));
+
+	uncertainty.drag_tolerance = 1.5f;
+	EXPECT_FALSE(ballistics::estimate_dispersion(kSphere, release(), uncertainty, 64, 1, dispersion));
+
+	ballistics::ReleaseState state = release();
+	state.height = 0.f;
+	EXPECT_FALSE(ballistics::estimate_dispersion(kSphere, state, ballistics::Uncertainty{}, 64, 1, dispersion));
+}
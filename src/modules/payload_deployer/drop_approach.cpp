@@ -0,0 +1,115 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file drop_approach.cpp
+ *
+ * Approach geometry of DropMission, without the dataman dependency of the
+ * mission writer.
+ */
+
+#include "drop_mission.h"
+
+#include <px4_platform_common/defines.h>
+
+using matrix::Vector2f;
+using matrix::Vector3f;
+
+bool DropMission::release_state(const PayloadStore &store, int slot, const MapProjection &reference,
+				 const Vector2f &wind, float airspeed, Vector2f &track, ballistics::ReleaseState &state)
+{
+	Vector2f target{};
+	reference.project(store.destination_lat(slot), store.destination_lon(slot), target(0), target(1));
+
+	// into the wind, or straight at the target in calm air
+	if (wind.norm() > 0.5f) {
+		track = -wind.normalized();
+
+	} else if (target.norm() > 1.f) {
+		track = target.normalized();
+
+	} else {
+		track = Vector2f(1.f, 0.f);
+	}
+
+	const float ground_speed = airspeed + wind.dot(track);
+
+	if (ground_speed < 1.f) {
+		return false;
+	}
+
+	state = ballistics::ReleaseState{};
+	state.velocity = Vector3f(track(0) * ground_speed, track(1) * ground_speed, 0.f);
+	state.wind = wind;
+	state.height = store.altitude(slot);
+	return true;
+}
+
+bool DropMission::plan_approach(const PayloadStore &store, int slot, const MapProjection &reference,
+				const Vector2f &wind, float airspeed, float run_in, Approach &approach)
+{
+	Vector2f track{};
+	ballistics::ReleaseState state{};
+
+	if (!release_state(store, slot, reference, wind, airspeed, track, state)) {
+		return false;
+	}
+
+	Vector2f target{};
+	reference.project(store.destination_lat(slot), store.destination_lon(slot), target(0), target(1));
+
+	ballistics::Solution solution{};
+
+	if (!store.drop_table(slot).lookup(state, solution) && !ballistics::solve(store.body(slot), state, solution)) {
+		return false;
+	}
+
+	approach.index = store.index(slot);
+	approach.release = target - solution.offset;
+	approach.entry = approach.release - track * run_in;
+
+	// the release height is above the destination, without its elevation the destination is assumed at home
+	const float destination_alt = store.destination_alt(slot);
+
+	if (PX4_ISFINITE(destination_alt)) {
+		approach.altitude = destination_alt + store.altitude(slot);
+		approach.altitude_is_relative = false;
+
+	} else {
+		approach.altitude = store.altitude(slot);
+		approach.altitude_is_relative = true;
+	}
+
+	return true;
+}
@@ -0,0 +1,112 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Test code for the payload drop approach
+ * Run this test only using make tests TESTFILTER=drop_approach
+ */
+
+#include <gtest/gtest.h>
+#include <math.h>
+
+#include "drop_mission.h"
+
+using matrix::Vector2f;
+using matrix::Vector3f;
+
+static constexpr double kHomeLat = 47.397742;
+static constexpr double kHomeLon = 8.545594;
+
+static PayloadManifest::Record make_record(unsigned index, float destination_alt)
+{
+	PayloadManifest::Record record{};
+	record.destination_lat = kHomeLat + 0.005;
+	record.destination_lon = kHomeLon;
+	record.weight = 0.3f;
+	record.area_x = 0.007f;
+	record.area_y = 0.007f;
+	record.drag_coef = 0.47f;
+	record.altitude = 100.f;
+	record.index = index;
+	record.pwm_id = 1;
+	record.pwm_open = 1900;
+	record.pwm_close = 1100;
+	record.destination_alt = destination_alt;
+	return record;
+}
+
+TEST(DropApproachTest, ReleaseHeightAboveDestination)
+{
+	PayloadStore store;
+	ASSERT_TRUE(store.init(4));
+	const int slot = store.insert(make_record(1, 612.5f), DropTable{});
+	ASSERT_NE(slot, PayloadStore::kInvalidSlot);
+
+	const MapProjection reference(kHomeLat, kHomeLon);
+	const Vector2f wind(-5.f, 0.f);
+	DropMission::Approach approach{};
+	ASSERT_TRUE(DropMission::plan_approach(store, slot, reference, wind, 15.f, 150.f, approach));
+
+	// AMSL, the release height is added to the elevation of the destination
+	EXPECT_FALSE(approach.altitude_is_relative);
+	EXPECT_FLOAT_EQ(approach.altitude, 712.5f);
+
+	// the fall is solved for the release height above the destination
+	Vector2f track{};
+	ballistics::ReleaseState state{};
+	ASSERT_TRUE(DropMission::release_state(store, slot, reference, wind, 15.f, track, state));
+	EXPECT_FLOAT_EQ(state.height, 100.f);
+
+	ballistics::Solution solution{};
+	ASSERT_TRUE(ballistics::solve(store.body(slot), state, solution));
+	Vector2f target{};
+	reference.project(kHomeLat + 0.005, kHomeLon, target(0), target(1));
+	EXPECT_LT((approach.release + solution.offset - target).norm(), 0.01f);
+	EXPECT_NEAR((approach.release - approach.entry).norm(), 150.f, 0.01f);
+}
+
+TEST(DropApproachTest, DestinationWithoutElevation)
+{
+	PayloadStore store;
+	ASSERT_TRUE(store.init(4));
+	const int slot = store.insert(make_record(1, NAN), DropTable{});
+	ASSERT_NE(slot, PayloadStore::kInvalidSlot);
+
+	const MapProjection reference(kHomeLat, kHomeLon);
+	DropMission::Approach approach{};
+	ASSERT_TRUE(DropMission::plan_approach(store, slot, reference, Vector2f(), 15.f, 150.f, approach));
+
+	// the destination is assumed at the elevation of home
+	EXPECT_TRUE(approach.altitude_is_relative);
+	EXPECT_FLOAT_EQ(approach.altitude, 100.f);
+}
@@ -0,0 +1,123 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file drop_mission.cpp
+ */
+
+#include "drop_mission.h"
+
+#include <crc32.h>
+#include <dataman_client/DatamanClient.hpp>
+#include <navigator/navigation.h>
+#include <new>
+#include <px4_platform_common/log.h>
+#include <uORB/Publication.hpp>
+#include <uORB/topics/mission.h>
+
+using matrix::Vector2f;
+
+bool DropMission::write(const MapProjection &reference, const Approach *approaches, const int *order, int count)
+{
+	if (count * kItemsPerDrop > DM_KEY_WAYPOINTS_OFFBOARD_0_MAX) {
+		PX4_ERR("Mission too long");
+		return false;
+	}
+
+	DatamanClient dataman_client;
+
+	mission_s mission{};
+
+	if (!dataman_client.readSync(DM_KEY_MISSION_STATE, 0, reinterpret_cast<uint8_t *>(&mission), sizeof(mission_s))) {
+		PX4_ERR("Can't read mission state");
+		return false;
+	}
+
+	// write into the storage that is not in use, so the active mission stays valid until the switch
+	const dm_item_t dataman_id = mission.mission_dataman_id == DM_KEY_WAYPOINTS_OFFBOARD_0 ?
+				     DM_KEY_WAYPOINTS_OFFBOARD_1 : DM_KEY_WAYPOINTS_OFFBOARD_0;
+	const int item_count = count * kItemsPerDrop;
+
+	mission_item_s *items = new (std::nothrow) mission_item_s[item_count] {};
+
+	if (items == nullptr) {
+		PX4_ERR("alloc failed");
+		return false;
+	}
+
+	for (int i = 0; i < count; i++) {
+		const Approach &approach = approaches[order[i]];
+		const Vector2f waypoints[kItemsPerDrop] = {approach.entry, approach.release};
+
+		for (int w = 0; w < kItemsPerDrop; w++) {
+			mission_item_s &item = items[i * kItemsPerDrop + w];
+			reference.reproject(waypoints[w](0), waypoints[w](1), item.lat, item.lon);
+			item.altitude = approach.altitude;
+			item.altitude_is_relative = approach.altitude_is_relative;
+			item.frame = approach.altitude_is_relative ? NAV_FRAME_GLOBAL_RELATIVE_ALT : NAV_FRAME_GLOBAL;
+			item.nav_cmd = NAV_CMD_WAYPOINT;
+			item.yaw = NAN;
+			item.autocontinue = true;
+			item.origin = ORIGIN_ONBOARD;
+		}
+	}
+
+	// one transaction: the storage is flushed once, after the last item
+	const bool written = dataman_client.writeBatchSync(dataman_id, 0, reinterpret_cast<uint8_t *>(items),
+			     sizeof(mission_item_s), item_count);
+	const uint32_t crc32 = crc32part(reinterpret_cast<const uint8_t *>(items), item_count * sizeof(mission_item_s), 0);
+
+	delete[] items;
+
+	if (!written) {
+		PX4_ERR("Can't write mission items");
+		return false;
+	}
+
+	mission.timestamp = hrt_absolute_time();
+	mission.mission_dataman_id = dataman_id;
+	mission.count = item_count;
+	mission.current_seq = 0;
+	mission.land_start_index = -1;
+	mission.land_index = -1;
+	mission.mission_id = crc32;
+
+	if (!dataman_client.writeSync(DM_KEY_MISSION_STATE, 0, reinterpret_cast<uint8_t *>(&mission), sizeof(mission_s))) {
+		PX4_ERR("Can't update mission state");
+		return false;
+	}
+
+	uORB::Publication<mission_s> mission_pub{ORB_ID(mission)};
+	mission_pub.publish(mission);
+	return true;
+}
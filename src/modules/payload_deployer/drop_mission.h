@@ -0,0 +1,100 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file drop_mission.h
+ *
+ * Approach geometry of payload drops and the mission flying them.
+ *
+ * Each payload is approached on a straight run-in into the wind, which keeps
+ * the ground speed low and the wind drift along the track. The run-in
+ * starts at an entry waypoint and ends at the release point, from where the
+ * payload falls onto its destination.
+ */
+
+#pragma once
+
+#include <lib/geo/geo.h>
+#include <matrix/matrix/math.hpp>
+
+#include "payload_store.h"
+
+class DropMission
+{
+public:
+	static constexpr int kItemsPerDrop = 2; ///< entry and release waypoint
+
+	struct Approach {
+		unsigned index;           ///< payload index
+		matrix::Vector2f entry;   ///< NE start of the run-in relative to the projection reference (m)
+		matrix::Vector2f release; ///< NE release point relative to the projection reference (m)
+		float altitude;           ///< release altitude, AMSL or above home (m)
+		bool altitude_is_relative; ///< altitude is above home, the destination has no elevation
+	};
+
+	/**
+	 * Release conditions at the end of the run-in of a payload.
+	 *
+	 * @param store payloads
+	 * @param slot slot of the payload to drop
+	 * @param reference local projection, centered at the vehicle
+	 * @param wind NE wind (m/s)
+	 * @param airspeed approach airspeed (m/s)
+	 * @param track output, NE unit vector of the run-in
+	 * @param state output
+	 * @return false if the vehicle can't make headway against the wind
+	 */
+	static bool release_state(const PayloadStore &store, int slot, const MapProjection &reference,
+				  const matrix::Vector2f &wind, float airspeed, matrix::Vector2f &track, ballistics::ReleaseState &state);
+
+	/**
+	 * Compute the run-in of a payload.
+	 *
+	 * @param store payloads
+	 * @param slot slot of the payload to drop
+	 * @param reference local projection, centered at the vehicle
+	 * @param wind NE wind (m/s)
+	 * @param airspeed approach airspeed (m/s)
+	 * @param run_in length of the straight run-in before the release (m)
+	 * @param approach output
+	 * @return false if the vehicle can't make headway against the wind or the fall can't be solved
+	 */
+	static bool plan_approach(const PayloadStore &store, int slot, const MapProjection &reference, const matrix::Vector2f &wind,
+				  float airspeed, float run_in, Approach &approach);
+
+	/**
+	 * Write the approaches in the given order as the active mission and notify the navigator.
+	 * Must not be called from a work queue, it blocks on dataman.
+	 */
+	static bool write(const MapProjection &reference, const Approach *approaches, const int *order, int count);
+};
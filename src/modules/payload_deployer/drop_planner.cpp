@@ -0,0 +1,331 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file drop_planner.cpp
+ */
+
+#include "drop_planner.h"
+
+#include <float.h>
+#include <new>
+
+using matrix::Vector2f;
+
+namespace
+{
+
+// edge cost between two positions in the order, -1 stands for the start, count for the open end of the path
+struct Costs {
+	const Vector2f &start;
+	const DropPlanner::Node *nodes;
+	int count;
+
+	float operator()(int from, int to) const
+	{
+		if (to < 0 || to >= count) {
+			return 0.f;
+		}
+
+		const Vector2f &origin = from < 0 ? start : nodes[from].exit;
+		return (nodes[to].entry - origin).norm();
+	}
+};
+
+// node at a position of the order, with -1 for the start and the end of the path
+inline int at(const int *order, int count, int position)
+{
+	return (position < 0 || position >= count) ? -1 : order[position];
+}
+
+} // namespace
+
+float DropPlanner::pathLength(const Vector2f &start, const Node *nodes, const int *order, int count)
+{
+	const Costs cost{start, nodes, count};
+	float length = 0.f;
+	int from = -1;
+
+	for (int i = 0; i < count; i++) {
+		length += cost(from, order[i]);
+		from = order[i];
+	}
+
+	return length;
+}
+
+float DropPlanner::plan(const Vector2f &start, const Node *nodes, int count, int *order, bool exact)
+{
+	if (count < 0 || count > kMaxNodes || (count > 0 && (nodes == nullptr || order == nullptr))) {
+		return -1.f;
+	}
+
+	if (!(exact && count <= kMaxExactNodes && solveExact(start, nodes, count, order))) {
+		solveHeuristic(start, nodes, count, order);
+	}
+
+	return pathLength(start, nodes, order, count);
+}
+
+bool DropPlanner::solveExact(const Vector2f &start, const Node *nodes, int count, int *order)
+{
+	if (count == 0) {
+		return true;
+	}
+
+	const Costs cost{start, nodes, count};
+	const unsigned subsets = 1u << count;
+
+	// best[subset * count + j]: shortest path from start through subset, ending at j
+	float *best = new (std::nothrow) float[subsets * count];
+
+	if (best == nullptr) {
+		return false;
+	}
+
+	float edge[kMaxExactNodes][kMaxExactNodes];
+
+	for (int i = 0; i < count; i++) {
+		for (int j = 0; j < count; j++) {
+			edge[i][j] = cost(i, j);
+		}
+	}
+
+	for (unsigned subset = 1; subset < subsets; subset++) {
+		for (int j = 0; j < count; j++) {
+			float &entry = best[subset * count + j];
+
+			if (!(subset & (1u << j))) {
+				entry = FLT_MAX;
+				continue;
+			}
+
+			const unsigned previous = subset & ~(1u << j);
+
+			if (previous == 0) {
+				entry = cost(-1, j);
+				continue;
+			}
+
+			entry = FLT_MAX;
+
+			for (int k = 0; k < count; k++) {
+				if (previous & (1u << k)) {
+					const float length = best[previous * count + k] + edge[k][j];
+
+					if (length < entry) {
+						entry = length;
+					}
+				}
+			}
+		}
+	}
+
+	// walk the table back from the best end node
+	unsigned subset = subsets - 1;
+	int last = 0;
+
+	for (int j = 1; j < count; j++) {
+		if (best[subset * count + j] < best[subset * count + last]) {
+			last = j;
+		}
+	}
+
+	for (int position = count - 1; position >= 0; position--) {
+		order[position] = last;
+		const unsigned previous = subset & ~(1u << last);
+
+		if (previous != 0) {
+			int next = -1;
+			float next_length = FLT_MAX;
+
+			for (int k = 0; k < count; k++) {
+				if (previous & (1u << k)) {
+					const float length = best[previous * count + k] + edge[k][last];
+
+					if (length < next_length) {
+						next_length = length;
+						next = k;
+					}
+				}
+			}
+
+			last = next;
+		}
+
+		subset = previous;
+	}
+
+	delete[] best;
+	return true;
+}
+
+void DropPlanner::solveHeuristic(const Vector2f &start, const Node *nodes, int count, int *order)
+{
+	const Costs cost{start, nodes, count};
+	bool visited[kMaxNodes] {};
+	int from = -1;
+
+	// nearest neighbour construction
+	for (int position = 0; position < count; position++) {
+		int nearest = -1;
+		float nearest_cost = FLT_MAX;
+
+		for (int j = 0; j < count; j++) {
+			if (!visited[j] && cost(from, j) < nearest_cost) {
+				nearest_cost = cost(from, j);
+				nearest = j;
+			}
+		}
+
+		order[position] = nearest;
+		visited[nearest] = true;
+		from = nearest;
+	}
+
+	// the number of passes is bounded since every accepted move strictly shortens the path
+	for (int pass = 0; pass < 10 * kMaxNodes; pass++) {
+		const bool improved_two_opt = improveTwoOpt(start, nodes, count, order);
+		const bool improved_or_opt = improveOrOpt(start, nodes, count, order);
+
+		if (!improved_two_opt && !improved_or_opt) {
+			break;
+		}
+	}
+}
+
+bool DropPlanner::improveTwoOpt(const Vector2f &start, const Node *nodes, int count, int *order)
+{
+	static constexpr float kMinGain = 1e-3f;
+	const Costs cost{start, nodes, count};
+	bool improved = false;
+
+	for (int i = 0; i < count - 1; i++) {
+		const int before = at(order, count, i - 1);
+
+		// edge sums inside the segment [i, k], forward and reversed
+		float forward = 0.f;
+		float reversed = 0.f;
+
+		for (int k = i + 1; k < count; k++) {
+			forward += cost(order[k - 1], order[k]);
+			reversed += cost(order[k], order[k - 1]);
+
+			const int after = at(order, count, k + 1);
+			const float current = cost(before, order[i]) + forward + cost(order[k], after);
+			const float candidate = cost(before, order[k]) + reversed + cost(order[i], after);
+
+			if (candidate < current - kMinGain) {
+				for (int a = i, b = k; a < b; a++, b--) {
+					const int tmp = order[a];
+					order[a] = order[b];
+					order[b] = tmp;
+				}
+
+				improved = true;
+				forward = 0.f;
+				reversed = 0.f;
+
+				// the segment sums are stale after the reversal, rebuild them up to k
+				for (int m = i + 1; m <= k; m++) {
+					forward += cost(order[m - 1], order[m]);
+					reversed += cost(order[m], order[m - 1]);
+				}
+			}
+		}
+	}
+
+	return improved;
+}
+
+bool DropPlanner::improveOrOpt(const Vector2f &start, const Node *nodes, int count, int *order)
+{
+	static constexpr float kMinGain = 1e-3f;
+	static constexpr int kMaxSegment = 3;
+	const Costs cost{start, nodes, count};
+	bool improved = false;
+
+	for (int length = 1; length <= kMaxSegment; length++) {
+		for (int s = 0; s + length <= count; s++) {
+			const int e = s + length - 1;
+			const int before = at(order, count, s - 1);
+			const int after = at(order, count, e + 1);
+			const float removal_gain = cost(before, order[s]) + cost(order[e], after) - cost(before, after);
+
+			// insert the segment between positions j and j + 1 of the remaining path
+			for (int j = -1; j < count; j++) {
+				if (j >= s - 1 && j <= e) {
+					continue;
+				}
+
+				const int a = at(order, count, j);
+				const int b = at(order, count, j + 1);
+				const float insertion_cost = cost(a, order[s]) + cost(order[e], b) - cost(a, b);
+
+				if (insertion_cost < removal_gain - kMinGain) {
+					int segment[kMaxSegment];
+
+					for (int m = 0; m < length; m++) {
+						segment[m] = order[s + m];
+					}
+
+					if (j < s) {
+						// shift [j + 1, s) towards the end
+						for (int m = s - 1; m > j; m--) {
+							order[m + length] = order[m];
+						}
+
+						for (int m = 0; m < length; m++) {
+							order[j + 1 + m] = segment[m];
+						}
+
+					} else {
+						// shift (e, j] towards the start
+						for (int m = e + 1; m <= j; m++) {
+							order[m - length] = order[m];
+						}
+
+						for (int m = 0; m < length; m++) {
+							order[j - length + 1 + m] = segment[m];
+						}
+					}
+
+					improved = true;
+					break;
+				}
+			}
+		}
+	}
+
+	return improved;
+}
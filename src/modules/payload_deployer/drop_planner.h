@@ -0,0 +1,87 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file drop_planner.h
+ *
+ * Orders payload drops for the shortest flight path.
+ *
+ * Every drop is a node with an entry point, where the straight run-in to the
+ * release point begins, and an exit point, where the vehicle is once the
+ * payload is released. The cost between two drops is the distance from the
+ * exit of the first to the entry of the second, so the problem is an open,
+ * asymmetric travelling salesman path starting at the vehicle.
+ *
+ * Up to kMaxExactNodes drops are ordered exactly with the Held-Karp dynamic
+ * program. Above that, or if its table can't be allocated, a nearest
+ * neighbour tour is improved with 2-opt and Or-opt moves until no move
+ * shortens it.
+ */
+
+#pragma once
+
+#include <matrix/matrix/math.hpp>
+
+class DropPlanner
+{
+public:
+	static constexpr int kMaxNodes = 64;
+	static constexpr int kMaxExactNodes = 8; ///< the exact solver allocates 2^n * n floats (8 kB for 8 drops)
+
+	struct Node {
+		matrix::Vector2f entry; ///< NE position where the approach starts (m)
+		matrix::Vector2f exit;  ///< NE position after the release (m)
+	};
+
+	/**
+	 * Order the nodes for the shortest path from start.
+	 *
+	 * @param start NE start position (m)
+	 * @param nodes drops to visit
+	 * @param count number of nodes, at most kMaxNodes
+	 * @param order output permutation of [0, count)
+	 * @param exact false to skip the exact solver, for testing
+	 * @return length of the planned path (m), negative on invalid input
+	 */
+	static float plan(const matrix::Vector2f &start, const Node *nodes, int count, int *order, bool exact = true);
+
+	/** length of the path visiting the nodes in the given order (m) */
+	static float pathLength(const matrix::Vector2f &start, const Node *nodes, const int *order, int count);
+
+private:
+	static bool solveExact(const matrix::Vector2f &start, const Node *nodes, int count, int *order);
+	static void solveHeuristic(const matrix::Vector2f &start, const Node *nodes, int count, int *order);
+
+	static bool improveTwoOpt(const matrix::Vector2f &start, const Node *nodes, int count, int *order);
+	static bool improveOrOpt(const matrix::Vector2f &start, const Node *nodes, int count, int *order);
+};
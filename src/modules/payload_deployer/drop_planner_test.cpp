@@ -0,0 +1,162 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Test code for the payload drop planner
+ * Run this test only using make tests TESTFILTER=drop_planner
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+
+#include "drop_planner.h"
+
+using matrix::Vector2f;
+
+class DropPlannerTest : public ::testing::Test
+{
+public:
+	DropPlannerTest()
+	{
+		_random_generator.seed(42);
+	}
+
+	void randomNodes(DropPlanner::Node *nodes, int count)
+	{
+		std::uniform_real_distribution<float> position(-2000.f, 2000.f);
+		std::uniform_real_distribution<float> heading(-M_PI_F, M_PI_F);
+
+		for (int i = 0; i < count; i++) {
+			const float course = heading(_random_generator);
+			nodes[i].exit = Vector2f(position(_random_generator), position(_random_generator));
+			nodes[i].entry = nodes[i].exit - Vector2f(cosf(course), sinf(course)) * 150.f;
+		}
+	}
+
+	static bool isPermutation(const int *order, int count)
+	{
+		bool seen[DropPlanner::kMaxNodes] {};
+
+		for (int i = 0; i < count; i++) {
+			if (order[i] < 0 || order[i] >= count || seen[order[i]]) {
+				return false;
+			}
+
+			seen[order[i]] = true;
+		}
+
+		return true;
+	}
+
+private:
+	std::default_random_engine _random_generator;
+};
+
+TEST_F(DropPlannerTest, ExactMatchesBruteForce)
+{
+	static constexpr int kCount = 7;
+	DropPlanner::Node nodes[kCount];
+	const Vector2f start(0.f, 0.f);
+
+	for (int trial = 0; trial < 5; trial++) {
+		randomNodes(nodes, kCount);
+
+		int order[kCount];
+		const float length = DropPlanner::plan(start, nodes, kCount, order);
+		ASSERT_TRUE(isPermutation(order, kCount));
+		EXPECT_FLOAT_EQ(length, DropPlanner::pathLength(start, nodes, order, kCount));
+
+		int permutation[kCount] = {0, 1, 2, 3, 4, 5, 6};
+		float best = FLT_MAX;
+
+		do {
+			best = std::min(best, DropPlanner::pathLength(start, nodes, permutation, kCount));
+		} while (std::next_permutation(permutation, permutation + kCount));
+
+		EXPECT_NEAR(length, best, 1e-2f);
+	}
+}
+
+TEST_F(DropPlannerTest, HeuristicCloseToExact)
+{
+	static constexpr int kCount = DropPlanner::kMaxExactNodes;
+	DropPlanner::Node nodes[kCount];
+	const Vector2f start(100.f, -300.f);
+
+	static constexpr int kTrials = 20;
+	float ratio_sum = 0.f;
+
+	for (int trial = 0; trial < kTrials; trial++) {
+		randomNodes(nodes, kCount);
+
+		int exact_order[kCount];
+		int heuristic_order[kCount];
+		const float exact = DropPlanner::plan(start, nodes, kCount, exact_order);
+		const float heuristic = DropPlanner::plan(start, nodes, kCount, heuristic_order, false);
+		ASSERT_TRUE(isPermutation(heuristic_order, kCount));
+		EXPECT_GE(heuristic, exact - 1e-2f);
+		EXPECT_LT(heuristic, 1.25f * exact);
+		ratio_sum += heuristic / exact;
+	}
+
+	EXPECT_LT(ratio_sum / kTrials, 1.05f);
+}
+
+TEST_F(DropPlannerTest, LargeSetImprovesOnIndexOrder)
+{
+	static constexpr int kCount = DropPlanner::kMaxNodes;
+	DropPlanner::Node nodes[kCount];
+	const Vector2f start(0.f, 0.f);
+	randomNodes(nodes, kCount);
+
+	int index_order[kCount];
+
+	for (int i = 0; i < kCount; i++) {
+		index_order[i] = i;
+	}
+
+	int order[kCount];
+	const float length = DropPlanner::plan(start, nodes, kCount, order);
+	ASSERT_TRUE(isPermutation(order, kCount));
+	EXPECT_LT(length, 0.5f * DropPlanner::pathLength(start, nodes, index_order, kCount));
+}
+
+TEST_F(DropPlannerTest, RejectsInvalidInput)
+{
+	int order[1];
+	DropPlanner::Node node{};
+	EXPECT_LT(DropPlanner::plan(Vector2f(), &node, DropPlanner::kMaxNodes + 1, order), 0.f);
+	EXPECT_LT(DropPlanner::plan(Vector2f(), nullptr, 1, order), 0.f);
+	EXPECT_FLOAT_EQ(DropPlanner::plan(Vector2f(), nullptr, 0, nullptr), 0.f);
+}
@@ -0,0 +1,202 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file drop_table.cpp
+ */
+
+#include "drop_table.h"
+
+#include <float.h>
+#include <math.h>
+#include <mathlib/mathlib.h>
+
+using matrix::Vector2f;
+using matrix::Vector3f;
+
+bool DropTable::solveLevel(float ground_speed, float wind_along, float wind_cross, float height,
+			   ballistics::Solution &solution) const
+{
+	// track frame: x along the ground track, y to the right of it
+	ballistics::ReleaseState state{};
+	state.velocity = Vector3f(ground_speed, 0.f, 0.f);
+	state.wind = Vector2f(wind_along, wind_cross);
+	state.height = height;
+	state.air_density = _air_density;
+	return ballistics::solve(_body, state, solution);
+}
+
+bool DropTable::build(const ballistics::Body &body, float nominal_height, float max_error, float air_density)
+{
+	_valid = false;
+	_max_error = 0.f;
+
+	if (!(nominal_height > 0.f)) {
+		return false;
+	}
+
+	_body = body;
+	_air_density = air_density;
+	_height_min = (1.f - kHeightSpan) * nominal_height;
+	_height_step = 2.f * kHeightSpan * nominal_height / (kHeightPoints - 1);
+
+	for (int i = 0; i < kSpeedPoints; i++) {
+		for (int j = 0; j < kWindPoints; j++) {
+			for (int k = 0; k < kHeightPoints; k++) {
+				ballistics::Solution solution{};
+				ballistics::Solution drift{};
+
+				if (!solveLevel(speedAt(i), windAt(j), 0.f, heightAt(k), solution)
+				    || !solveLevel(speedAt(i), windAt(j), kCrossWindRef, heightAt(k), drift)) {
+					return false;
+				}
+
+				_data[i][j][k][ALONG] = solution.offset(0);
+				_data[i][j][k][CROSS_GAIN] = drift.offset(1) / kCrossWindRef;
+				_data[i][j][k][TIME] = solution.time_of_fall;
+			}
+		}
+	}
+
+	_valid = true;
+
+	// interpolation error is largest in the middle of a cell
+	for (int i = 0; i < kSpeedPoints - 1; i++) {
+		for (int j = 0; j < kWindPoints - 1; j++) {
+			for (int k = 0; k < kHeightPoints - 1; k++) {
+				const float speed = speedAt(i) + 0.5f * kSpeedStep;
+				const float wind = windAt(j) + 0.5f * kWindStep;
+				const float height = heightAt(k) + 0.5f * _height_step;
+
+				// the drift is symmetric in the cross wind, checking one side is enough
+				const float cross_winds[] = {0.f, kCrossWindMax};
+
+				for (const float wind_cross : cross_winds) {
+					ballistics::Solution solution{};
+					float along = 0.f;
+					float cross = 0.f;
+					float time_of_fall = 0.f;
+
+					if (!solveLevel(speed, wind, wind_cross, height, solution)
+					    || !lookup(speed, wind, wind_cross, height, along, cross, time_of_fall)) {
+						_valid = false;
+						return false;
+					}
+
+					const float error = (solution.offset - Vector2f(along, cross)).norm();
+
+					if (error > _max_error) {
+						_max_error = error;
+					}
+				}
+			}
+		}
+	}
+
+	// too coarse for this body and height, the full solver has to be used
+	if (!(_max_error <= max_error)) {
+		_valid = false;
+		return false;
+	}
+
+	return true;
+}
+
+bool DropTable::lookup(float ground_speed, float wind_along, float wind_cross, float height,
+		       float &along, float &cross, float &time_of_fall) const
+{
+	if (!_valid) {
+		return false;
+	}
+
+	// continuous grid coordinates
+	const float x = ground_speed / kSpeedStep;
+	const float y = wind_along / kWindStep + (kWindPoints - 1) / 2;
+	const float z = (height - _height_min) / _height_step;
+
+	if (!(x >= 0.f && x <= kSpeedPoints - 1) || !(y >= 0.f && y <= kWindPoints - 1)
+	    || !(z >= 0.f && z <= kHeightPoints - 1) || !(fabsf(wind_cross) <= kCrossWindMax)) {
+		return false;
+	}
+
+	// lower cell corner, clamped so that the upper bound of the grid stays inside the last cell
+	const int i = math::min(static_cast<int>(x), kSpeedPoints - 2);
+	const int j = math::min(static_cast<int>(y), kWindPoints - 2);
+	const int k = math::min(static_cast<int>(z), kHeightPoints - 2);
+	const float fx = x - i;
+	const float fy = y - j;
+	const float fz = z - k;
+
+	float out[FIELD_COUNT];
+
+	for (int f = 0; f < FIELD_COUNT; f++) {
+		const float c00 = _data[i][j][k][f] * (1.f - fx) + _data[i + 1][j][k][f] * fx;
+		const float c01 = _data[i][j][k + 1][f] * (1.f - fx) + _data[i + 1][j][k + 1][f] * fx;
+		const float c10 = _data[i][j + 1][k][f] * (1.f - fx) + _data[i + 1][j + 1][k][f] * fx;
+		const float c11 = _data[i][j + 1][k + 1][f] * (1.f - fx) + _data[i + 1][j + 1][k + 1][f] * fx;
+		const float c0 = c00 * (1.f - fy) + c10 * fy;
+		const float c1 = c01 * (1.f - fy) + c11 * fy;
+		out[f] = c0 * (1.f - fz) + c1 * fz;
+	}
+
+	along = out[ALONG];
+	cross = out[CROSS_GAIN] * wind_cross;
+	time_of_fall = out[TIME];
+	return true;
+}
+
+bool DropTable::lookup(const ballistics::ReleaseState &state, ballistics::Solution &solution) const
+{
+	if (!(fabsf(state.velocity(2)) < kMaxVerticalSpeed)) {
+		return false;
+	}
+
+	const Vector2f velocity_xy(state.velocity(0), state.velocity(1));
+	const float ground_speed = velocity_xy.norm();
+
+	// unit vector along the ground track, any direction is fine when hovering
+	const Vector2f track = ground_speed > FLT_EPSILON ? velocity_xy / ground_speed : Vector2f(1.f, 0.f);
+	const Vector2f right(-track(1), track(0));
+
+	float along = 0.f;
+	float cross = 0.f;
+	float time_of_fall = 0.f;
+
+	if (!lookup(ground_speed, state.wind.dot(track), state.wind.dot(right), state.height, along, cross, time_of_fall)) {
+		return false;
+	}
+
+	solution.offset = track * along + right * cross;
+	solution.time_of_fall = time_of_fall;
+	return true;
+}
@@ -0,0 +1,121 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file drop_table.h
+ *
+ * Precomputed drop offsets of a single payload.
+ *
+ * The fall is tabulated for level flight on a regular grid of ground speed,
+ * along-track wind and release height, and queried by trilinear
+ * interpolation. Cross-track wind is handled to first order with a drift
+ * gain tabulated on the same grid. When the table is built, the
+ * interpolated values are compared against the full solver at every cell
+ * center, where the interpolation error peaks, for no and for the largest
+ * accepted cross wind. The largest deviation is kept as the error bound of
+ * the table, a table that exceeds the requested bound is rejected.
+ */
+
+#pragma once
+
+#include "ballistics.h"
+
+class DropTable
+{
+public:
+	static constexpr int kSpeedPoints = 6;
+	static constexpr float kSpeedStep = 7.f;        ///< m/s, covers 0..35 m/s ground speed
+	static constexpr int kWindPoints = 5;
+	static constexpr float kWindStep = 6.f;         ///< m/s, covers -12..12 m/s along-track wind
+	static constexpr int kHeightPoints = 5;
+	static constexpr float kHeightSpan = 0.5f;      ///< heights cover (1 +- kHeightSpan) * nominal height
+	static constexpr float kCrossWindMax = 12.f;    ///< m/s, largest cross wind accepted by lookup
+	static constexpr float kCrossWindRef = 6.f;     ///< m/s, cross wind used to tabulate the drift gain
+	static constexpr float kMaxVerticalSpeed = 0.5f; ///< m/s, the table assumes level flight
+
+	DropTable() = default;
+	~DropTable() = default;
+
+	/**
+	 * Tabulate the fall of a body around a nominal release height.
+	 * @param max_error largest accepted deviation of the interpolated impact point from the full solver (m)
+	 * @return false if the solver fails anywhere on the grid or the error exceeds max_error, the table is then invalid
+	 */
+	bool build(const ballistics::Body &body, float nominal_height, float max_error, float air_density = 1.225f);
+
+	/**
+	 * Interpolate the drop of the body.
+	 *
+	 * @param ground_speed horizontal ground speed of the vehicle (m/s)
+	 * @param wind_along wind component along the ground track, positive for tailwind (m/s)
+	 * @param wind_cross wind component to the right of the ground track (m/s)
+	 * @param height release height above the target (m)
+	 * @param along output offset along the ground track (m)
+	 * @param cross output offset to the right of the ground track (m)
+	 * @param time_of_fall output (s)
+	 * @return false if the query lies outside of the table
+	 */
+	bool lookup(float ground_speed, float wind_along, float wind_cross, float height,
+		    float &along, float &cross, float &time_of_fall) const;
+
+	/**
+	 * Interpolate the drop for a NED vehicle velocity and NE wind.
+	 * Only the offset and the time of fall of the solution are written.
+	 * @return false if the query lies outside of the table or the vehicle is not in level flight
+	 */
+	bool lookup(const ballistics::ReleaseState &state, ballistics::Solution &solution) const;
+
+	bool valid() const { return _valid; }
+
+	/** largest deviation of the interpolated impact point from the full solver (m) */
+	float max_error() const { return _max_error; }
+
+private:
+	enum Field { ALONG = 0, CROSS_GAIN, TIME, FIELD_COUNT };
+
+	float speedAt(int i) const { return i * kSpeedStep; }
+	float windAt(int j) const { return (j - (kWindPoints - 1) / 2) * kWindStep; }
+	float heightAt(int k) const { return _height_min + k * _height_step; }
+
+	bool solveLevel(float ground_speed, float wind_along, float wind_cross, float height,
+			ballistics::Solution &solution) const;
+
+	ballistics::Body _body{};
+	float _air_density{1.225f};
+	float _height_min{0.f};
+	float _height_step{0.f};
+	float _max_error{0.f};
+	bool _valid{false};
+
+	float _data[kSpeedPoints][kWindPoints][kHeightPoints][FIELD_COUNT] {};
+};
@@ -0,0 +1,141 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Test code for the payload drop table
+ * Run this test only using make tests TESTFILTER=drop_table
+ */
+
+#include <gtest/gtest.h>
+#include <random>
+
+#include "drop_table.h"
+
+using matrix::Vector2f;
+using matrix::Vector3f;
+
+static constexpr ballistics::Body kSphere{0.3f, 0.007f, 0.007f, 0.47f};
+
+TEST(DropTableTest, ErrorBoundHoldsInsideTable)
+{
+	DropTable table;
+	ASSERT_TRUE(table.build(kSphere, 100.f, 5.f));
+	ASSERT_TRUE(table.valid());
+	EXPECT_LT(table.max_error(), 5.f);
+
+	std::default_random_engine generator(42);
+	std::uniform_real_distribution<float> speed(0.f, 35.f);
+	std::uniform_real_distribution<float> wind(-12.f, 12.f);
+	std::uniform_real_distribution<float> height(50.f, 150.f);
+	std::uniform_real_distribution<float> heading(-M_PI_F, M_PI_F);
+
+	for (int n = 0; n < 200; n++) {
+		const float course = heading(generator);
+		const float ground_speed = speed(generator);
+
+		ballistics::ReleaseState state{};
+		state.velocity = Vector3f(ground_speed * cosf(course), ground_speed * sinf(course), 0.f);
+		state.height = height(generator);
+
+		// stay within the tabulated wind range
+		const Vector2f track(cosf(course), sinf(course));
+		const Vector2f right(-track(1), track(0));
+		state.wind = track * wind(generator) + right * wind(generator);
+
+		ballistics::Solution reference{};
+		ballistics::Solution interpolated{};
+		ASSERT_TRUE(ballistics::solve(kSphere, state, reference));
+		ASSERT_TRUE(table.lookup(state, interpolated));
+
+		// the bound is sampled at the cell centers only, allow some margin
+		EXPECT_LT((reference.offset - interpolated.offset).norm(), 1.5f * table.max_error() + 0.5f);
+		EXPECT_NEAR(reference.time_of_fall, interpolated.time_of_fall, 0.1f);
+	}
+}
+
+TEST(DropTableTest, ExactOnGridNodes)
+{
+	DropTable table;
+	ASSERT_TRUE(table.build(kSphere, 200.f, 5.f));
+
+	ballistics::ReleaseState state{};
+	state.velocity = Vector3f(DropTable::kSpeedStep * 3.f, 0.f, 0.f);
+	state.wind = Vector2f(-DropTable::kWindStep, 0.f);
+	state.height = 200.f;
+
+	ballistics::Solution reference{};
+	ballistics::Solution interpolated{};
+	ASSERT_TRUE(ballistics::solve(kSphere, state, reference));
+	ASSERT_TRUE(table.lookup(state, interpolated));
+	EXPECT_NEAR(reference.offset(0), interpolated.offset(0), 1e-3f);
+	EXPECT_NEAR(reference.offset(1), interpolated.offset(1), 1e-3f);
+	EXPECT_NEAR(reference.time_of_fall, interpolated.time_of_fall, 1e-4f);
+}
+
+TEST(DropTableTest, RejectsQueriesOutsideTable)
+{
+	DropTable table;
+	float along = 0.f;
+	float cross = 0.f;
+	float time_of_fall = 0.f;
+	EXPECT_FALSE(table.lookup(10.f, 0.f, 0.f, 100.f, along, cross, time_of_fall));
+
+	ASSERT_TRUE(table.build(kSphere, 100.f, 5.f));
+	EXPECT_TRUE(table.lookup(10.f, 0.f, 0.f, 100.f, along, cross, time_of_fall));
+	EXPECT_FALSE(table.lookup(50.f, 0.f, 0.f, 100.f, along, cross, time_of_fall));
+	EXPECT_FALSE(table.lookup(10.f, 20.f, 0.f, 100.f, along, cross, time_of_fall));
+	EXPECT_FALSE(table.lookup(10.f, 0.f, 0.f, 20.f, along, cross, time_of_fall));
+	EXPECT_FALSE(table.lookup(10.f, 0.f, -15.f, 100.f, along, cross, time_of_fall));
+
+	ballistics::ReleaseState climbing{};
+	climbing.velocity = Vector3f(10.f, 0.f, -3.f);
+	climbing.height = 100.f;
+	ballistics::Solution solution{};
+	EXPECT_FALSE(table.lookup(climbing, solution));
+}
+
+TEST(DropTableTest, RejectsTableAboveErrorBound)
+{
+	DropTable table;
+	ASSERT_TRUE(table.build(kSphere, 100.f, 5.f));
+	const float max_error = table.max_error();
+	ASSERT_GT(max_error, 0.f);
+
+	EXPECT_FALSE(table.build(kSphere, 100.f, 0.5f * max_error));
+	EXPECT_FALSE(table.valid());
+
+	float along = 0.f;
+	float cross = 0.f;
+	float time_of_fall = 0.f;
+	EXPECT_FALSE(table.lookup(10.f, 0.f, 0.f, 100.f, along, cross, time_of_fall));
+}
@@ -0,0 +1,256 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file manifest.cpp
+ */
+
+#include "manifest.h"
+
+#include <crc32.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __PX4_POSIX
+#include <sys/mman.h>
+#endif
+
+#include <px4_platform_common/defines.h>
+#include <px4_platform_common/log.h>
+
+PayloadManifest::~PayloadManifest()
+{
+	close();
+}
+
+bool PayloadManifest::open(const char *path)
+{
+	close();
+
+	const int fd = ::open(path, O_RDONLY | O_BINARY);
+
+	if (fd < 0) {
+		return false;
+	}
+
+	struct stat st {};
+
+	if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(Header)) {
+		::close(fd);
+		return false;
+	}
+
+	_size = st.st_size;
+
+#ifdef __PX4_POSIX
+	_data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	if (_data == MAP_FAILED) {
+		_data = nullptr;
+
+	} else {
+		_mapped = true;
+	}
+
+#endif
+
+	if (!_data) {
+		_data = malloc(_size);
+
+		if (_data && ::read(fd, _data, _size) != (ssize_t)_size) {
+			free(_data);
+			_data = nullptr;
+		}
+	}
+
+	::close(fd);
+
+	if (!_data) {
+		_size = 0;
+		return false;
+	}
+
+	const Header *header = static_cast<const Header *>(_data);
+
+	// version 1 has the same layout, with the destination elevation reserved
+	if (header->magic != kMagic || header->version < 1 || header->version > kVersion || header->record_size != sizeof(Record)
+	    || header->count > kMaxRecords || _size != sizeof(Header) + header->count * sizeof(Record)) {
+		close();
+		return false;
+	}
+
+	const Record *records = reinterpret_cast<const Record *>(static_cast<const uint8_t *>(_data) + sizeof(Header));
+
+	if (crc32part(reinterpret_cast<const uint8_t *>(records), header->count * sizeof(Record), 0) != header->crc32) {
+		close();
+		return false;
+	}
+
+	_records = records;
+	_count = header->count;
+	_version = header->version;
+	return true;
+}
+
+bool PayloadManifest::recover(const char *path)
+{
+	char tmp_path[128];
+
+	if (access(path, F_OK) == 0 || snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path) >= (int)sizeof(tmp_path)) {
+		return false;
+	}
+
+	// the temporary file is complete once the old manifest was unlinked, but check it anyway
+	PayloadManifest manifest;
+
+	if (!manifest.open(tmp_path)) {
+		return false;
+	}
+
+	manifest.close();
+	return rename(tmp_path, path) == 0;
+}
+
+void PayloadManifest::close()
+{
+	if (_data) {
+#ifdef __PX4_POSIX
+
+		if (_mapped) {
+			munmap(_data, _size);
+
+		} else
+#endif
+		{
+			free(_data);
+		}
+	}
+
+	_data = nullptr;
+	_size = 0;
+	_mapped = false;
+	_records = nullptr;
+	_count = 0;
+	_version = 0;
+}
+
+PayloadManifest::Writer::~Writer()
+{
+	if (_fd >= 0) {
+		// not committed, drop the partial file
+		::close(_fd);
+		unlink(_path);
+	}
+}
+
+bool PayloadManifest::Writer::open(const char *path)
+{
+	if (_fd >= 0 || snprintf(_path, sizeof(_path), "%s.tmp", path) >= (int)sizeof(_path)) {
+		return false;
+	}
+
+	_fd = ::open(_path, O_WRONLY | O_CREAT | O_TRUNC | O_BINARY, PX4_O_MODE_666);
+
+	if (_fd < 0) {
+		PX4_ERR("can't create %s (%i)", _path, errno);
+		return false;
+	}
+
+	// placeholder, rewritten on commit once count and checksum are known
+	const Header header{};
+	_count = 0;
+	_crc32 = 0;
+	return ::write(_fd, &header, sizeof(header)) == (ssize_t)sizeof(header);
+}
+
+bool PayloadManifest::Writer::append(const Record &record)
+{
+	if (_fd < 0 || _count >= kMaxRecords) {
+		return false;
+	}
+
+	if (::write(_fd, &record, sizeof(record)) != (ssize_t)sizeof(record)) {
+		return false;
+	}
+
+	_crc32 = crc32part(reinterpret_cast<const uint8_t *>(&record), sizeof(record), _crc32);
+	_count++;
+	return true;
+}
+
+bool PayloadManifest::Writer::commit()
+{
+	if (_fd < 0) {
+		return false;
+	}
+
+	Header header{};
+	header.magic = kMagic;
+	header.version = kVersion;
+	header.record_size = sizeof(Record);
+	header.count = _count;
+	header.crc32 = _crc32;
+
+	bool success = lseek(_fd, 0, SEEK_SET) == 0 && ::write(_fd, &header, sizeof(header)) == (ssize_t)sizeof(header);
+	success = success && fsync(_fd) == 0;
+
+	::close(_fd);
+	_fd = -1;
+
+	// strip the .tmp suffix
+	char path[sizeof(_path)];
+	strncpy(path, _path, sizeof(path));
+	path[strlen(path) - 4] = '\0';
+
+#ifndef __PX4_POSIX
+	// FAT can't rename onto an existing file
+	if (success) {
+		unlink(path);
+	}
+
+#endif
+
+	if (!success || rename(_path, path) != 0) {
+		PX4_ERR("can't write %s", path);
+		unlink(_path);
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,147 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file manifest.h
+ *
+ * Persistent binary manifest of the payload definitions.
+ *
+ * The file is a fixed header followed by an array of fixed-size records, so
+ * it is loaded with a single read, or mapped into memory where mmap is
+ * available, and the records are used in place without any parsing. The
+ * header carries a version and the record size, which reject files written
+ * by an incompatible layout, and a CRC of the records.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+class PayloadManifest
+{
+public:
+	static constexpr uint32_t kMagic = 0x464d4450;  ///< "PDMF" in little endian
+	static constexpr uint16_t kVersion = 2;         ///< increment on any change of the record layout
+	static constexpr unsigned kMaxRecords = 1024;
+
+	struct Header {
+		uint32_t magic;
+		uint16_t version;
+		uint16_t record_size;
+		uint32_t count;
+		uint32_t crc32;      ///< CRC of the records
+	};
+
+	/** One payload, doubles first so the layout has no padding */
+	struct Record {
+		double destination_lat; ///< WGS84 (deg)
+		double destination_lon; ///< WGS84 (deg)
+		float weight;           ///< kg
+		float area_x;           ///< horizontal reference area (m^2)
+		float area_y;           ///< vertical reference area (m^2)
+		float drag_coef;
+		float altitude;         ///< release height above the destination (m)
+		uint32_t index;
+		int32_t pwm_id;
+		int32_t pwm_open;
+		int32_t pwm_close;
+		float destination_alt;  ///< AMSL elevation of the destination (m), NaN if at the elevation of home (reserved in version 1)
+	};
+
+	static_assert(sizeof(Header) == 16, "manifest header layout changed");
+	static_assert(sizeof(Record) == 56, "manifest record layout changed, increment kVersion");
+
+	PayloadManifest() = default;
+	~PayloadManifest();
+
+	PayloadManifest(const PayloadManifest &) = delete;
+	PayloadManifest &operator=(const PayloadManifest &) = delete;
+
+	/**
+	 * Map or read a manifest file and validate it.
+	 * @return false if the file is missing, truncated, of another version or corrupt
+	 */
+	bool open(const char *path);
+
+	/** version of the open file, the records of version 1 have no destination_alt */
+	uint16_t version() const { return _version; }
+
+	/**
+	 * Complete a commit() interrupted between unlinking the old manifest and
+	 * renaming the new one, by renaming a valid <path>.tmp if path is missing.
+	 * @return true if the manifest was recovered
+	 */
+	static bool recover(const char *path);
+
+	/** Release the file contents, invalidates the records */
+	void close();
+
+	unsigned count() const { return _count; }
+	const Record &operator[](unsigned i) const { return _records[i]; }
+
+	/**
+	 * Streams records into a new manifest file. The file is written next to
+	 * the destination and renamed on commit(), a power loss leaves either
+	 * the old or the new manifest. Where the old file has to be unlinked
+	 * before the rename (NuttX), the new one may be left as <path>.tmp,
+	 * which recover() puts in place.
+	 */
+	class Writer
+	{
+	public:
+		Writer() = default;
+		~Writer();
+
+		Writer(const Writer &) = delete;
+		Writer &operator=(const Writer &) = delete;
+
+		bool open(const char *path);
+		bool append(const Record &record);
+		bool commit();
+
+	private:
+		int _fd{-1};
+		char _path[128] {};
+		uint32_t _count{0};
+		uint32_t _crc32{0};
+	};
+
+private:
+	void *_data{nullptr};
+	unsigned _size{0};
+	bool _mapped{false};
+	const Record *_records{nullptr};
+	unsigned _count{0};
+	uint16_t _version{0};
+};
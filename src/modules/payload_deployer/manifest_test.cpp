@@ -0,0 +1,204 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * Test code for the payload manifest
+ * Run this test only using make tests TESTFILTER=manifest
+ */
+
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "manifest.h"
+
+static constexpr const char *kPath = "manifest_test.bin";
+
+static PayloadManifest::Record make_record(unsigned index)
+{
+	PayloadManifest::Record record{};
+	record.destination_lat = 35.143214165 + index * 1e-4;
+	record.destination_lon = 42.55138791202;
+	record.weight = 0.3f;
+	record.area_x = 0.007f;
+	record.area_y = 0.0022f;
+	record.drag_coef = 0.42f;
+	record.altitude = 100.f + index;
+	record.destination_alt = 400.f + index;
+	record.index = index;
+	record.pwm_id = 1;
+	record.pwm_open = 1900;
+	record.pwm_close = 1100;
+	return record;
+}
+
+static void write_manifest(unsigned count)
+{
+	PayloadManifest::Writer writer;
+	ASSERT_TRUE(writer.open(kPath));
+
+	for (unsigned i = 1; i <= count; i++) {
+		ASSERT_TRUE(writer.append(make_record(i)));
+	}
+
+	ASSERT_TRUE(writer.commit());
+}
+
+TEST(ManifestTest, RoundTrip)
+{
+	write_manifest(300);
+
+	PayloadManifest manifest;
+	ASSERT_TRUE(manifest.open(kPath));
+	ASSERT_EQ(manifest.count(), 300u);
+
+	for (unsigned i = 0; i < manifest.count(); i++) {
+		const PayloadManifest::Record expected = make_record(i + 1);
+		EXPECT_EQ(memcmp(&manifest[i], &expected, sizeof(expected)), 0);
+	}
+
+	EXPECT_EQ(manifest.version(), PayloadManifest::kVersion);
+	manifest.close();
+	EXPECT_EQ(manifest.count(), 0u);
+
+	// an empty manifest is valid
+	write_manifest(0);
+	ASSERT_TRUE(manifest.open(kPath));
+	EXPECT_EQ(manifest.count(), 0u);
+
+	unlink(kPath);
+}
+
+TEST(ManifestTest, RejectsCorruptFile)
+{
+	write_manifest(10);
+
+	// flip a byte in the last record
+	int fd = open(kPath, O_RDWR);
+	ASSERT_GE(fd, 0);
+	const off_t offset = sizeof(PayloadManifest::Header) + 9 * sizeof(PayloadManifest::Record) + 20;
+	uint8_t byte = 0;
+	ASSERT_EQ(pread(fd, &byte, 1, offset), 1);
+	byte ^= 0x01;
+	ASSERT_EQ(pwrite(fd, &byte, 1, offset), 1);
+
+	PayloadManifest manifest;
+	EXPECT_FALSE(manifest.open(kPath));
+
+	// truncated
+	ASSERT_EQ(ftruncate(fd, offset), 0);
+	EXPECT_FALSE(manifest.open(kPath));
+	close(fd);
+
+	// another version
+	write_manifest(1);
+	fd = open(kPath, O_RDWR);
+	ASSERT_GE(fd, 0);
+	PayloadManifest::Header header{};
+	ASSERT_EQ(pread(fd, &header, sizeof(header), 0), (ssize_t)sizeof(header));
+	header.version++;
+	ASSERT_EQ(pwrite(fd, &header, sizeof(header), 0), (ssize_t)sizeof(header));
+	close(fd);
+	EXPECT_FALSE(manifest.open(kPath));
+
+	// version 1 has the same layout
+	header.version = 1;
+	fd = open(kPath, O_RDWR);
+	ASSERT_GE(fd, 0);
+	ASSERT_EQ(pwrite(fd, &header, sizeof(header), 0), (ssize_t)sizeof(header));
+	close(fd);
+	ASSERT_TRUE(manifest.open(kPath));
+	EXPECT_EQ(manifest.version(), 1);
+
+	EXPECT_FALSE(manifest.open("does_not_exist.bin"));
+
+	unlink(kPath);
+}
+
+TEST(ManifestTest, UncommittedWriterKeepsOldFile)
+{
+	write_manifest(5);
+
+	{
+		PayloadManifest::Writer writer;
+		ASSERT_TRUE(writer.open(kPath));
+		ASSERT_TRUE(writer.append(make_record(42)));
+		// destroyed without commit
+	}
+
+	PayloadManifest manifest;
+	ASSERT_TRUE(manifest.open(kPath));
+	EXPECT_EQ(manifest.count(), 5u);
+	EXPECT_NE(access("manifest_test.bin.tmp", F_OK), 0);
+
+	unlink(kPath);
+}
+
+TEST(ManifestTest, RecoversInterruptedCommit)
+{
+	// power loss after the old file was unlinked, before the rename
+	write_manifest(5);
+	ASSERT_EQ(rename(kPath, "manifest_test.bin.tmp"), 0);
+
+	EXPECT_TRUE(PayloadManifest::recover(kPath));
+
+	PayloadManifest manifest;
+	ASSERT_TRUE(manifest.open(kPath));
+	EXPECT_EQ(manifest.count(), 5u);
+	EXPECT_NE(access("manifest_test.bin.tmp", F_OK), 0);
+
+	// nothing to do with the destination in place
+	EXPECT_FALSE(PayloadManifest::recover(kPath));
+
+	unlink(kPath);
+}
+
+TEST(ManifestTest, IgnoresPartialTemporaryFile)
+{
+	{
+		PayloadManifest::Writer writer;
+		ASSERT_TRUE(writer.open(kPath));
+		ASSERT_TRUE(writer.append(make_record(1)));
+		// leave the partial file behind, as a power loss during the write would
+		ASSERT_EQ(rename("manifest_test.bin.tmp", "manifest_test.bin.partial"), 0);
+	}
+
+	ASSERT_EQ(rename("manifest_test.bin.partial", "manifest_test.bin.tmp"), 0);
+
+	EXPECT_FALSE(PayloadManifest::recover(kPath));
+	EXPECT_NE(access(kPath, F_OK), 0);
+
+	unlink("manifest_test.bin.tmp");
+}
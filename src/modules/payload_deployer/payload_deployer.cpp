@@ -32,7 +32,13 @@
  ****************************************************************************/
 
 #include "payload_deployer.h"
+#include <containers/LockGuard.hpp>
 #include <limits.h>
+#include <lib/geo/geo.h>
+#include <mathlib/mathlib.h>
+
+using matrix::Vector2f;
+using matrix::Vector3f;
 
 inline bool expect_eq(float a, float b, float eps = 1e-5f) {
     return (a > b ? a - b : b - a) < eps;
@@ -43,30 +49,55 @@ inline bool expect_eq(double a, double b, double eps = 1e-9) {
 }
 
 
-IntrusiveSortedList<Payload *> PayloadDeployer::_payloads;
+PayloadStore PayloadDeployer::_store;
+
+pthread_mutex_t PayloadDeployer::_command_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+DropTable PayloadDeployer::_scratch_table;
 
 unsigned PayloadDeployer::_active_item = 0;
 
+unsigned PayloadDeployer::_sequence[DropPlanner::kMaxNodes] {};
+
+int PayloadDeployer::_sequence_length = 0;
+
+int PayloadDeployer::_sequence_position = 0;
+
+bool PayloadDeployer::_restored = false;
+
 PayloadDeployer::PayloadDeployer()
 	: ModuleBase<PayloadDeployer>()
 	, ModuleParams(nullptr)
 	, ScheduledWorkItem(MODULE_NAME, px4::wq_configurations::lp_default)
 {}
 
-bool PayloadDeployer::init()
+PayloadDeployer::~PayloadDeployer()
 {
-	ScheduleOnInterval(100_ms);
+	perf_free(_loop_perf);
+	perf_free(_solve_perf);
+}
 
-	if (!_vehicle_command_sub.registerCallback()) {
+bool PayloadDeployer::init()
+{
+	if (!_vehicle_command_sub.registerCallback() || !_vehicle_global_position_sub.registerCallback()
+	    || !_payload_manifest_sub.registerCallback()) {
 		PX4_ERR("Callback registration failed");
 		return false;
 	}
 
+	_worker.startRestore();
+	ScheduleNow();
 	return true;
 }
 
 /* initialize instance */
 int PayloadDeployer::task_spawn(int argc, char *argv[]) {
+	{
+		// the payloads are loaded by the worker, building their drop tables takes long
+		LockGuard command_guard{_command_mutex};
+		if (!_store.init(CONFIG_PAYLOAD_DEPLOYER_MAX_PAYLOADS))
+			PX4_ERR("Payload store allocation failed");
+	}
 	PayloadDeployer *instance = new PayloadDeployer();
 	if (instance) {
 		_object.store(instance);
@@ -86,44 +117,82 @@ int PayloadDeployer::task_spawn(int argc, char *argv[]) {
 
 /* add a new payload */
 bool PayloadDeployer::add(int size, char *args[]) {
-	if (size != 11) {
+	if (size != 11 && size != 12) {
 		PX4_WARN("Usage:");
 		printf("payload_deployer add [index: unsigned] [weight(kg): float] [area_x(sqm): float] [area_y(sqm): float] [drag_coef: float]");
-		printf(" [alt(m): float] [lat(WGS84): double] [lon(WGS84): double] [pwm_id: int] [pwm_open: int] [pwm_close: int]\n");
-		printf("example:\n\tpayload_deployer add 15 0.3 0.007 0.0022 0.42 200 35.143214165 42.55138791202 14 1500 990\n");
+		printf(" [alt(m): float] [lat(WGS84): double] [lon(WGS84): double] [pwm_id: int] [pwm_open: int] [pwm_close: int]");
+		printf(" [[target_alt(m AMSL): float]]\n");
+		printf("alt is the release height above the target, without target_alt the target is assumed at the elevation of home\n");
+		printf("example:\n\tpayload_deployer add 15 0.3 0.007 0.0022 0.42 200 35.143214165 42.55138791202 14 1500 990 1250\n");
 		return PX4_OK;
 	}
-	unsigned	index = (atoi(args[0]) > USHRT_MAX ||
-				 atoi(args[0]) <= 0)? 0 : atoi(args[0]);
-	int	pwm_id = atoi(args[8]),
-		pwm_open_freq = atoi(args[9]),
-		pwm_close_freq = atoi(args[10]);
-	float	weight = atof(args[1]),
-		area_x = atof(args[2]),
-		area_y = atof(args[3]),
-		drag_coef = atof(args[4]),
-		alt = atof(args[5]);
-	double	lat = strtod(args[6], NULL),
-		lon = strtod(args[7], NULL);
-	if (index == 0 || pwm_id == 0 || pwm_open_freq == 0 || pwm_close_freq == 0 ||
-	    expect_eq(weight, 0) || expect_eq(area_x, 0) || expect_eq(area_y, 0) ||
-	    expect_eq(drag_coef, 0) || expect_eq(alt, 0) || expect_eq(lat, 0) ||
-	    expect_eq(lon, 0)) {
-		PX4_ERR("Invalid arguments");
+	PayloadManifest::Record record{};
+	parse_record(args, size, record);
+	const int slot = insert(record);
+	if (slot == PayloadStore::kInvalidSlot)
 		return PX4_ERROR;
+	if (_store.drop_table(slot).valid())
+		PX4_INFO("Drop table built, max error %.2f m", (double)_store.drop_table(slot).max_error());
+	save_manifest();
+	return PX4_OK;
+}
+
+void PayloadDeployer::parse_record(char *args[], int size, PayloadManifest::Record &record) {
+	record.index = (atoi(args[0]) > USHRT_MAX ||
+			atoi(args[0]) <= 0)? 0 : atoi(args[0]);
+	record.weight = atof(args[1]);
+	record.area_x = atof(args[2]);
+	record.area_y = atof(args[3]);
+	record.drag_coef = atof(args[4]);
+	record.altitude = atof(args[5]);
+	record.destination_lat = strtod(args[6], NULL);
+	record.destination_lon = strtod(args[7], NULL);
+	record.pwm_id = atoi(args[8]);
+	record.pwm_open = atoi(args[9]);
+	record.pwm_close = atoi(args[10]);
+	record.destination_alt = size > 11 ? strtof(args[11], NULL) : NAN;
+}
+
+bool PayloadDeployer::valid(const PayloadManifest::Record &record) {
+	return !(record.index == 0 || record.index > USHRT_MAX || record.pwm_id == 0 || record.pwm_open == 0 ||
+		 record.pwm_close == 0 || expect_eq(record.weight, 0) || expect_eq(record.area_x, 0) ||
+		 expect_eq(record.area_y, 0) || expect_eq(record.drag_coef, 0) || expect_eq(record.altitude, 0) ||
+		 expect_eq(record.destination_lat, 0) || expect_eq(record.destination_lon, 0));
+}
+
+int PayloadDeployer::insert(const PayloadManifest::Record &record, bool replace) {
+	if (!valid(record)) {
+		PX4_ERR("Invalid arguments");
+		return PayloadStore::kInvalidSlot;
 	}
-	for (const Payload *it: _payloads) {
-		if (it->_index == index) {
-			PX4_ERR("Payload with index already exists.");
-			return PX4_ERROR;
-		}
+	const int existing = _store.find(record.index);
+	if (existing != PayloadStore::kInvalidSlot && !replace) {
+		PX4_ERR("Payload with index %u already exists.", (unsigned)record.index);
+		return PayloadStore::kInvalidSlot;
 	}
-	Payload *new_item = new Payload(index, weight, area_x, area_y, drag_coef, alt,
-				  lat, lon, pwm_id, pwm_open_freq, pwm_close_freq);
-	if (!new_item)
-		PX4_ERR("Allocation error.");
-	_payloads.add(new_item);
-	return PX4_OK;
+	if (existing == PayloadStore::kInvalidSlot && _store.size() == _store.capacity()) {
+		PX4_ERR("Payload store is full (%u).", _store.capacity());
+		return PayloadStore::kInvalidSlot;
+	}
+	// the table is built without blocking the work queue, only the copy is made under the lock
+	if (!build_table(record))
+		PX4_WARN("payload %u: couldn't build drop table, falling back to the full solver.", (unsigned)record.index);
+	LockGuard guard{_store.mutex()};
+	if (existing != PayloadStore::kInvalidSlot)
+		return _store.update(existing, record, _scratch_table) ? existing : PayloadStore::kInvalidSlot;
+	return _store.insert(record, _scratch_table);
+}
+
+bool PayloadDeployer::build_table(const PayloadManifest::Record &record) {
+	// the interpolation may use up to half of the release acceptance radius, may run before the instance exists
+	float acceptance_radius = 5.f;
+	param_get(param_find("PD_ACC_RAD"), &acceptance_radius);
+	const bool built = _scratch_table.build(ballistics::Body{record.weight, record.area_x, record.area_y, record.drag_coef},
+						record.altitude, 0.5f * acceptance_radius);
+	if (!built && _scratch_table.max_error() > 0.f)
+		PX4_WARN("payload %u: drop table error %.2f m exceeds %.2f m", (unsigned)record.index,
+			 (double)_scratch_table.max_error(), (double)(0.5f * acceptance_radius));
+	return built;
 }
 
 /* edit an existing payload by its index */
@@ -138,78 +207,86 @@ example:\n\
 
 	unsigned	index = (atoi(args[0]) > USHRT_MAX ||
 				 atoi(args[0]) <= 0)? 0 : atoi(args[0]);
-	Payload *item = nullptr;
-	for (Payload *it: _payloads) {
-		if (it->_index == index) {
-			item = it; break;
-		}
-	}
-	if (!item) {
+	const int slot = _store.find(index);
+	if (slot == PayloadStore::kInvalidSlot) {
 		PX4_ERR("Couldn't find item with specified index.");
 		return PX4_ERROR;
 	}
-	auto set_val = [] (const char *name, auto &address, auto parse_func, auto validate_func) {
+	PayloadManifest::Record record = _store.record(slot);
+	auto set_val = [slot, &record] (const char *name, auto &address, auto parse_func, auto validate_func) {
 		auto new_val = parse_func();
 		if (!validate_func(new_val)) {
 			PX4_ERR("Invalid value specified for field");
 			return PX4_ERROR;
 		}
 		address = new_val;
+		// cheap enough to redo on every edit, most fields feed the table
+		if (!build_table(record))
+			PX4_WARN("Couldn't rebuild drop table, falling back to the full solver.");
+		{
+			LockGuard guard{_store.mutex()};
+			if (!_store.update(slot, record, _scratch_table))
+				return PX4_ERROR;
+		}
+		save_manifest();
 		return PX4_OK;
 	};
 	if (strcmp(args[1], "index") == 0) {
-		return set_val("index", item->_index,
+		return set_val("index", record.index,
 				[&args]() {
 					return (unsigned)((atoi(args[2]) > USHRT_MAX ||
 							   atoi(args[2]) <= 0)? 0 : atoi(args[2]));
 				},
 				[](unsigned val) {
-					for (Payload *it: _payloads) {
-						if (it->_index == val) {
-							PX4_ERR("index already in use.");
-							return false;
-						}
+					if (_store.find(val) != PayloadStore::kInvalidSlot) {
+						PX4_ERR("index already in use.");
+						return false;
 					}
 					return val != 0;
 				});
 	} else if (strcmp(args[1], "weight") == 0) {
-		return set_val("weight", item->_weight,
+		return set_val("weight", record.weight,
 				[&args]() { return atof(args[2]);},
 				[](float val) { return !(expect_eq(val, 0) || val < 0); });
 	} else if (strcmp(args[1], "area_x") == 0) {
-		return set_val("area_x", item->_area_x,
+		return set_val("area_x", record.area_x,
 				[&args]() { return atof(args[2]);},
 				[](float val) { return !(expect_eq(val, 0) || val < 0); });
 	} else if (strcmp(args[1], "area_y") == 0) {
-		return set_val("area_y", item->_area_y,
+		return set_val("area_y", record.area_y,
 				[&args]() { return atof(args[2]);},
 				[](float val) { return !(expect_eq(val, 0) || val < 0); });
 	} else if (strcmp(args[1], "drag_coef") == 0) {
-		return set_val("drag_coef", item->_drag_coef,
+		return set_val("drag_coef", record.drag_coef,
 				[&args]() { return atof(args[2]);},
 				[](float val) { return !(expect_eq(val, 0) || val < 0); });
 	} else if (strcmp(args[1], "pwm_id") == 0) {
-		return set_val("pwm_id", item->_pwm_id,
+		return set_val("pwm_id", record.pwm_id,
 				[&args]() { return atoi(args[2]);},
 				[](int val) { return (val < 0); });
 	} else if (strcmp(args[1], "pwm_open") == 0) {
-		return set_val("pwm_open", item->_pwm_open_freq,
+		return set_val("pwm_open", record.pwm_open,
 				[&args]() { return atoi(args[2]);},
 				[](int val) { return (val < 0); });
 	} else if (strcmp(args[1], "pwm_close") == 0) {
-		return set_val("pwm_close", item->_pwm_close_freq,
+		return set_val("pwm_close", record.pwm_close,
 				[&args]() { return atoi(args[2]);},
 				[](int val) { return (val < 0); });
 	} else if (strcmp(args[1], "alt") == 0) {
-		return set_val("alt", item->_altitude,
+		return set_val("alt", record.altitude,
 				[&args]() { return atof(args[2]);},
 				[](float val) { return !(expect_eq(val, 0) || val < 0); });
+	} else if (strcmp(args[1], "target_alt") == 0) {
+		// nan for a target at the elevation of home
+		return set_val("target_alt", record.destination_alt,
+				[&args]() { return strtof(args[2], NULL);},
+				[](float val) { return !isinf(val); });
 	} else if (strcmp(args[1], "lat") == 0) {
-		return set_val("lat", item->_destination_lat,
+		return set_val("lat", record.destination_lat,
 				[&args]() { return strtod(args[2], NULL);},
 				[](double val) { return !(expect_eq(val, 0) || val < 0); });
 	} else if (strcmp(args[1], "lon") == 0) {
-		return set_val("lon", item->_destination_lon,
+		return set_val("lon", record.destination_lon,
 				[&args]() { return strtod(args[2], NULL);},
 				[](double val) { return !(expect_eq(val, 0) || val < 0); });
 	} else {
@@ -230,12 +307,15 @@ example:\n\
 	}
 	unsigned	index = (atoi(args[0]) > USHRT_MAX ||
 				 atoi(args[0]) <= 0)? 0 : atoi(args[0]);
-	for (Payload *it: _payloads) {
-		if (it->_index == index) {
-			_payloads.remove(it);
-			PX4_INFO("Payload removed");
-			return PX4_OK;
-		}
+	bool removed = false;
+	{
+		LockGuard guard{_store.mutex()};
+		removed = _store.remove(index);
+	}
+	if (removed) {
+		save_manifest();
+		PX4_INFO("Payload removed");
+		return PX4_OK;
 	}
 	PX4_WARN("Couldn't find payload with index.\n");
 	return PX4_OK;
@@ -249,21 +329,250 @@ bool PayloadDeployer::test_servo(int size, char *args[]) {
 
 /* list added payloads */
 bool PayloadDeployer::list() {
-	printf("[index]  [weight(kg)]  [area_x(sqm)]  [area_y(sqm)]  [drag_coef]  [pwm_id]  [pwm_open]  [pwm_close]  [alt(m)]  [lat(WGS84)]    [lon(WGS84)]\n");
-	for (const Payload *it: _payloads) {
-		printf(" %-7d  %-12.5f  %-13.5f  %-13.5f  %-11.5f  %-8d  %-10d  %-11d  %-7.2f  %-12.10lf    %-12.10lf\n",
-			it->_index,
-			it->_weight,
-			it->_area_x,
-			it->_area_y,
-			it->_drag_coef,
-			it->_pwm_id,
-			it->_pwm_open_freq,
-			it->_pwm_close_freq,
-			it->_altitude,
-			it->_destination_lat,
-			it->_destination_lon);
+	printf("[index]  [weight(kg)]  [area_x(sqm)]  [area_y(sqm)]  [drag_coef]  [pwm_id]  [pwm_open]  [pwm_close]  [alt(m)]  [lat(WGS84)]    [lon(WGS84)]    [target_alt(m)]\n");
+	for (unsigned slot = 0; slot < _store.size(); slot++) {
+		const PayloadManifest::Record it = _store.record(slot);
+		printf(" %-7u  %-12.5f  %-13.5f  %-13.5f  %-11.5f  %-8d  %-10d  %-11d  %-7.2f  %-12.10lf    %-12.10lf    %-.2f\n",
+			(unsigned)it.index,
+			(double)it.weight,
+			(double)it.area_x,
+			(double)it.area_y,
+			(double)it.drag_coef,
+			(int)it.pwm_id,
+			(int)it.pwm_open,
+			(int)it.pwm_close,
+			(double)it.altitude,
+			it.destination_lat,
+			it.destination_lon,
+			(double)it.destination_alt);
+	}
+	return PX4_OK;
+}
+
+/* add the payloads of a manifest or a text file with one payload per line */
+bool PayloadDeployer::import_payloads(int size, char *args[]) {
+	if (size != 1) {
+		PX4_WARN("Usage:");
+		printf("payload_deployer import FILE\n\
+FILE is a manifest written by export, or text with the arguments of add on each line\n\
+example:\n\
+\tpayload_deployer import /fs/microsd/payloads.txt\n");
+		return PX4_OK;
+	}
+
+	int added = load_manifest(args[0]);
+	if (added < 0) {
+		FILE *file = fopen(args[0], "r");
+		if (!file) {
+			PX4_ERR("Can't open %s", args[0]);
+			return PX4_ERROR;
+		}
+		added = 0;
+		char line[256];
+		int line_number = 0;
+		while (fgets(line, sizeof(line), file)) {
+			line_number++;
+			char *fields[12];
+			int count = 0;
+			char *saveptr = nullptr;
+			for (char *token = strtok_r(line, " \t\r\n", &saveptr); token && count <= 12;
+			     token = strtok_r(nullptr, " \t\r\n", &saveptr)) {
+				if (token[0] == '#')
+					break;
+				if (count < 12)
+					fields[count] = token;
+				count++;
+			}
+			if (count == 0)
+				continue;
+			PayloadManifest::Record record{};
+			if (count != 11 && count != 12) {
+				PX4_ERR("line %d: expected 11 or 12 fields", line_number);
+				continue;
+			}
+			parse_record(fields, count, record);
+			if (insert(record) != PayloadStore::kInvalidSlot)
+				added++;
+		}
+		fclose(file);
+	}
+
+	if (added > 0)
+		save_manifest();
+	PX4_INFO("%d payloads imported", added);
+	return PX4_OK;
+}
+
+/* write the payloads to a manifest file */
+bool PayloadDeployer::export_payloads(int size, char *args[]) {
+	if (size != 1) {
+		PX4_WARN("Usage:");
+		printf("payload_deployer export FILE\n\
+example:\n\
+\tpayload_deployer export /fs/microsd/payloads_backup.bin\n");
+		return PX4_OK;
+	}
+	if (!save_manifest(args[0]))
+		return PX4_ERROR;
+	PX4_INFO("%u payloads exported", _store.size());
+	return PX4_OK;
+}
+
+int PayloadDeployer::load_manifest(const char *path) {
+	PayloadManifest manifest;
+	if (!manifest.open(path))
+		return -1;
+	int added = 0;
+	for (unsigned i = 0; i < manifest.count(); i++) {
+		PayloadManifest::Record record = manifest[i];
+		if (manifest.version() < 2)
+			record.destination_alt = NAN;
+		if (insert(record) != PayloadStore::kInvalidSlot)
+			added++;
+	}
+	return added;
+}
+
+bool PayloadDeployer::save_manifest(const char *path) {
+	PayloadManifest::Writer writer;
+	bool success = writer.open(path);
+	for (unsigned slot = 0; success && slot < _store.size(); slot++)
+		success = writer.append(_store.record(slot));
+	if (!success || !writer.commit()) {
+		PX4_ERR("Can't write payload manifest %s", path);
+		return false;
+	}
+	return true;
+}
+
+void PayloadDeployer::restore() {
+	if (_restored)
+		return;
+	_restored = true;
+	if (!_store.init(CONFIG_PAYLOAD_DEPLOYER_MAX_PAYLOADS))
+		PX4_ERR("Payload store allocation failed");
+	if (PayloadManifest::recover(kManifestPath))
+		PX4_WARN("%s recovered from an interrupted save", kManifestPath);
+	const int added = load_manifest(kManifestPath);
+	if (added > 0)
+		PX4_INFO("%d payloads restored", added);
+	else if (added < 0 && access(kManifestPath, F_OK) == 0)
+		PX4_ERR("%s is corrupt or of another version, ignored", kManifestPath);
+}
+
+void PayloadDeployer::load_payloads() {
+	LockGuard command_guard{_command_mutex};
+	restore();
+}
+
+/* predict where a payload released now would land, relative to the vehicle */
+bool PayloadDeployer::predict_impact(int slot, ballistics::Solution &solution) {
+	ballistics::ReleaseState state{};
+	state.height = _store.altitude(slot);
+
+	uORB::Subscription local_position_sub{ORB_ID(vehicle_local_position)};
+	vehicle_local_position_s local_position{};
+	if (local_position_sub.copy(&local_position) && local_position.v_xy_valid && local_position.v_z_valid)
+		state.velocity = matrix::Vector3f(local_position.vx, local_position.vy, local_position.vz);
+
+	uORB::Subscription wind_sub{ORB_ID(wind)};
+	wind_s wind{};
+	if (wind_sub.copy(&wind))
+		state.wind = matrix::Vector2f(wind.windspeed_north, wind.windspeed_east);
+
+	if (_store.drop_table(slot).lookup(state, solution))
+		return true;
+	return ballistics::solve(_store.body(slot), state, solution);
+}
+
+/* estimate the impact dispersion of a payload released at the end of its run-in */
+bool PayloadDeployer::dispersion(int size, char *args[]) {
+	if (size < 1 || size > 2) {
+		PX4_WARN("Usage:");
+		printf("payload_deployer dispersion INDEX [SAMPLES]\n\
+SAMPLES defaults to 4096, at most 16384\n\
+example:\n\
+\tpayload_deployer dispersion 15\n\
+\tpayload_deployer dispersion 15 10000\n");
+		return PX4_OK;
+	}
+	const unsigned index = (atoi(args[0]) > USHRT_MAX || atoi(args[0]) <= 0) ? 0 : atoi(args[0]);
+	// integrated on the shell thread, keep it to a few seconds on a single core
+	const int samples = size == 2 ? math::constrain(atoi(args[1]), ballistics::kBlock, 16384) : 4096;
+	if (!is_running()) {
+		PX4_ERR("Module is not running");
+		return PX4_ERROR;
+	}
+
+	uORB::Subscription global_position_sub{ORB_ID(vehicle_global_position)};
+	vehicle_global_position_s global_position{};
+	if (!global_position_sub.copy(&global_position) || !global_position.lat_lon_valid) {
+		PX4_ERR("No valid global position");
+		return PX4_ERROR;
+	}
+
+	ballistics::Uncertainty uncertainty{};
+	uncertainty.drag_tolerance = get_instance()->_param_pd_cd_tol.get();
+
+	uORB::Subscription wind_sub{ORB_ID(wind)};
+	wind_s wind{};
+	Vector2f wind_ne{};
+	if (wind_sub.copy(&wind)) {
+		wind_ne = Vector2f(wind.windspeed_north, wind.windspeed_east);
+		uncertainty.wind = Vector2f(sqrtf(fmaxf(wind.variance_north, 0.f)), sqrtf(fmaxf(wind.variance_east, 0.f)));
+	}
+
+	uORB::Subscription local_position_sub{ORB_ID(vehicle_local_position)};
+	vehicle_local_position_s local_position{};
+	if (local_position_sub.copy(&local_position)) {
+		uncertainty.position_h = local_position.eph;
+		uncertainty.height = local_position.epv;
+		uncertainty.velocity_h = local_position.evh;
+		uncertainty.velocity_v = local_position.evv;
+	}
+
+	// the command mutex is only held to read the payload, the samples are integrated without it
+	ballistics::Body body{};
+	Vector2f track{};
+	ballistics::ReleaseState state{};
+	{
+		LockGuard command_guard{_command_mutex};
+		restore();
+		const int slot = _store.find(index);
+		if (slot == PayloadStore::kInvalidSlot) {
+			PX4_WARN("Couldn't find payload with index.");
+			return PX4_OK;
+		}
+		const MapProjection reference(global_position.lat, global_position.lon);
+		if (!DropMission::release_state(_store, slot, reference, wind_ne, get_instance()->_param_pd_appr_spd.get(), track, state)) {
+			PX4_ERR("Can't make headway against the wind");
+			return PX4_ERROR;
+		}
+		body = _store.body(slot);
 	}
+
+#ifdef __PX4_POSIX
+	static constexpr int threads = 4;
+#else
+	static constexpr int threads = 1;
+#endif
+	const hrt_abstime start = hrt_absolute_time();
+	ballistics::Dispersion result{};
+	if (!ballistics::estimate_dispersion(body, state, uncertainty, samples, (uint32_t)start, result, threads)) {
+		PX4_ERR("Can't estimate the dispersion of payload %u", index);
+		return PX4_ERROR;
+	}
+
+	printf("sigma: wind %.2f/%.2f m/s, velocity %.2f/%.2f m/s, position %.2f m, height %.2f m, drag +-%.0f%%\n",
+		(double)uncertainty.wind(0), (double)uncertainty.wind(1), (double)uncertainty.velocity_h,
+		(double)uncertainty.velocity_v, (double)uncertainty.position_h, (double)uncertainty.height,
+		(double)(uncertainty.drag_tolerance * 100.f));
+	printf("CEP %.2f m (%.2f m around the mean impact, %.2f m off the nominal)\n",
+		(double)result.cep, (double)result.cep_mean, (double)(result.mean - result.nominal).norm());
+	printf("1 sigma ellipse %.2f x %.2f m, major axis %.0f deg\n", (double)result.major, (double)result.minor,
+		(double)math::degrees(matrix::wrap(result.orientation, 0.f, M_PI_F)));
+	printf("%d of %d samples landed, %.1f ms\n", result.samples, (samples + ballistics::kBlock - 1) / ballistics::kBlock * ballistics::kBlock,
+		(double)(hrt_elapsed_time(&start) / 1e3));
 	return PX4_OK;
 }
 
@@ -278,39 +587,189 @@ example:\n\
 \tpayload_deployer launch // launch all\n");
 		return PX4_OK;
 	}
-	if (_active_item != 0)
-		PX4_WARN("Another item is already launched, please cancel it first.\n");
-	else if (size == 1) { // launch for specified index only
-		unsigned index = (atoi(args[0]) > USHRT_MAX ||
-				 atoi(args[0]) <= 0)? 0 : atoi(args[0]);
-		const Payload *item{nullptr};
-		for (const Payload *it: _payloads)
-			if (it->_index == index) {
-				item = it;
-				break;
-			}
-		if (!item) {
+	unsigned index = 0;
+	if (size == 1) { // launch for specified index only
+		index = (atoi(args[0]) > USHRT_MAX ||
+			 atoi(args[0]) <= 0)? 0 : atoi(args[0]);
+		if (index == 0) {
 			PX4_ERR("Invalid index");
 			return PX4_ERROR;
 		}
-		// Generate mission for item
-		_active_item = index;
 	}
-	else if (_payloads.size() == 0) { // launch for all
+	if (launch_payloads(index) != vehicle_command_ack_s::VEHICLE_CMD_RESULT_ACCEPTED)
+		return PX4_ERROR;
+	return PX4_OK;
+}
+
+uint8_t PayloadDeployer::launch_payloads(unsigned index) {
+	{
+		LockGuard guard{_store.mutex()};
+		if (_active_item != 0) {
+			PX4_WARN("Another item is already launched, please cancel it first.");
+			return vehicle_command_ack_s::VEHICLE_CMD_RESULT_TEMPORARILY_REJECTED;
+		}
+	}
+	if (!is_running()) {
+		PX4_ERR("Module is not running");
+		return vehicle_command_ack_s::VEHICLE_CMD_RESULT_DENIED;
+	}
+	static int selected[DropPlanner::kMaxNodes];
+	int count = 0;
+	if (index != 0) { // launch for specified index only
+		const int slot = _store.find(index);
+		if (slot == PayloadStore::kInvalidSlot) {
+			PX4_ERR("Invalid index");
+			return vehicle_command_ack_s::VEHICLE_CMD_RESULT_DENIED;
+		}
+		ballistics::Solution solution{};
+		if (!predict_impact(slot, solution)) {
+			PX4_ERR("Can't solve the fall of payload %u", index);
+			return vehicle_command_ack_s::VEHICLE_CMD_RESULT_FAILED;
+		}
+		PX4_INFO("payload %u: release offset N %.2f m, E %.2f m, time of fall %.2f s", index,
+			 (double)solution.offset(0), (double)solution.offset(1), (double)solution.time_of_fall);
+		selected[count++] = slot;
+	}
+	else if (_store.size() == 0) { // launch for all
 		PX4_WARN("Nothing to launch.");
+		return vehicle_command_ack_s::VEHICLE_CMD_RESULT_DENIED;
+	}
+	else if (_store.size() > DropPlanner::kMaxNodes) {
+		PX4_ERR("At most %d payloads can be launched at once", DropPlanner::kMaxNodes);
+		return vehicle_command_ack_s::VEHICLE_CMD_RESULT_DENIED;
 	}
 	else {
-		// generate mission for all
-		_active_item = 1;
+		for (unsigned slot = 0; slot < _store.size(); slot++)
+			selected[count++] = slot;
 	}
-	return PX4_OK;
+	if (!plan_launch(selected, count))
+		return vehicle_command_ack_s::VEHICLE_CMD_RESULT_FAILED;
+	return vehicle_command_ack_s::VEHICLE_CMD_RESULT_ACCEPTED;
+}
+
+/* move the target of a payload, NaN keeps a value */
+uint8_t PayloadDeployer::retarget(unsigned index, double lat, double lon, float destination_alt) {
+	const int slot = _store.find(index);
+	if (slot == PayloadStore::kInvalidSlot)
+		return vehicle_command_ack_s::VEHICLE_CMD_RESULT_DENIED;
+	PayloadManifest::Record record = _store.record(slot);
+	if (PX4_ISFINITE(lat) && PX4_ISFINITE(lon)) {
+		record.destination_lat = lat;
+		record.destination_lon = lon;
+	}
+	// the release height above the target is kept
+	if (PX4_ISFINITE(destination_alt))
+		record.destination_alt = destination_alt;
+	if (!valid(record) || insert(record, true) == PayloadStore::kInvalidSlot)
+		return vehicle_command_ack_s::VEHICLE_CMD_RESULT_DENIED;
+	save_manifest();
+	return vehicle_command_ack_s::VEHICLE_CMD_RESULT_ACCEPTED;
+}
+
+uint8_t PayloadDeployer::execute_command(const vehicle_command_s &command) {
+	LockGuard command_guard{_command_mutex};
+	restore();
+	switch (command.command) {
+	case vehicle_command_s::VEHICLE_CMD_PAYLOAD_CONTROL_DEPLOY:
+		// param2 was range checked by handle_command
+		return launch_payloads(PX4_ISFINITE(command.param2) && command.param2 >= 1.f ? (unsigned)command.param2 : 0);
+	case vehicle_command_s::VEHICLE_CMD_PAYLOAD_PREPARE_DEPLOY:
+		// param1 was range checked by handle_command
+		return retarget((unsigned)command.param1, command.param5, command.param6, command.param7);
+	default:
+		return vehicle_command_ack_s::VEHICLE_CMD_RESULT_UNSUPPORTED;
+	}
+}
+
+void PayloadDeployer::apply_manifest(const payload_manifest_s &manifest, uint8_t &accepted, uint8_t &rejected) {
+	LockGuard command_guard{_command_mutex};
+	restore();
+	accepted = 0;
+	rejected = 0;
+	if (manifest.clear) {
+		LockGuard guard{_store.mutex()};
+		while (_store.size() > 0)
+			_store.remove(_store.index(0));
+	}
+	const int count = math::min((int)manifest.count, (int)payload_manifest_s::MAX_PAYLOADS);
+	for (int i = 0; i < count; i++) {
+		PayloadManifest::Record record{};
+		record.index = manifest.index[i];
+		record.weight = manifest.weight[i];
+		record.area_x = manifest.area_x[i];
+		record.area_y = manifest.area_y[i];
+		record.drag_coef = manifest.drag_coef[i];
+		record.altitude = manifest.altitude[i];
+		record.destination_lat = manifest.destination_lat[i];
+		record.destination_lon = manifest.destination_lon[i];
+		record.destination_alt = manifest.destination_alt[i];
+		record.pwm_id = manifest.pwm_id[i];
+		record.pwm_open = manifest.pwm_open[i];
+		record.pwm_close = manifest.pwm_close[i];
+		if (insert(record, true) != PayloadStore::kInvalidSlot)
+			accepted++;
+		else
+			rejected++;
+	}
+	if (manifest.clear || accepted > 0)
+		save_manifest();
+}
+
+/* plan the approach of each payload, order them for the shortest flight and write the mission */
+bool PayloadDeployer::plan_launch(const int *slots, int count) {
+	uORB::Subscription global_position_sub{ORB_ID(vehicle_global_position)};
+	vehicle_global_position_s global_position{};
+	if (!global_position_sub.copy(&global_position) || !global_position.lat_lon_valid) {
+		PX4_ERR("No valid global position");
+		return false;
+	}
+
+	uORB::Subscription wind_sub{ORB_ID(wind)};
+	wind_s wind{};
+	Vector2f wind_ne{};
+	if (wind_sub.copy(&wind))
+		wind_ne = Vector2f(wind.windspeed_north, wind.windspeed_east);
+
+	const PayloadDeployer *instance = get_instance();
+	const float airspeed = instance->_param_pd_appr_spd.get();
+	const float run_in = instance->_param_pd_run_in.get();
+
+	// shell context only, kept off the stack
+	static DropMission::Approach approaches[DropPlanner::kMaxNodes];
+	static DropPlanner::Node nodes[DropPlanner::kMaxNodes];
+	static int order[DropPlanner::kMaxNodes];
+
+	const MapProjection reference(global_position.lat, global_position.lon);
+	for (int i = 0; i < count; i++) {
+		if (!DropMission::plan_approach(_store, slots[i], reference, wind_ne, airspeed, run_in, approaches[i])) {
+			PX4_ERR("Can't plan the approach of payload %u", _store.index(slots[i]));
+			return false;
+		}
+		nodes[i].entry = approaches[i].entry;
+		nodes[i].exit = approaches[i].release;
+	}
+
+	const float length = DropPlanner::plan(Vector2f(), nodes, count, order);
+	if (length < 0.f || !DropMission::write(reference, approaches, order, count))
+		return false;
+
+	LockGuard guard{_store.mutex()};
+	for (int i = 0; i < count; i++)
+		_sequence[i] = approaches[order[i]].index;
+	_sequence_length = count;
+	_sequence_position = 0;
+	_active_item = _sequence[0];
+	PX4_INFO("Mission with %d drops written, %.0f m to the last release", count, (double)length);
+	return true;
 }
 
 /* cancel deployment of payloads and stop vehicle where it is */
 bool PayloadDeployer::cancel() {
+	LockGuard guard{_store.mutex()};
 	if (_active_item) {
 		// cancel mission
 		_active_item = 0;
+		_sequence_length = 0;
 	}
 	return PX4_OK;
 }
@@ -318,7 +777,12 @@ bool PayloadDeployer::cancel() {
 int PayloadDeployer::custom_command(int argc, char *argv[]) {
 	if (argc == 0)
 		return print_usage();
-	else if (strcmp(argv[0], "add") == 0)
+	// takes the command mutex itself, only while it reads the payload
+	if (strcmp(argv[0], "dispersion") == 0)
+		return dispersion(argc - 1, argv + 1);
+	LockGuard command_guard{_command_mutex};
+	restore();
+	if (strcmp(argv[0], "add") == 0)
 		return add(argc - 1, argv + 1);
 	else if (strcmp(argv[0], "edit") == 0)
 		return edit(argc - 1, argv + 1);
@@ -328,6 +792,10 @@ int PayloadDeployer::custom_command(int argc, char *argv[]) {
 		return test_servo(argc - 1, argv + 1);
 	else if (strcmp(argv[0], "list") == 0)
 		return list();
+	else if (strcmp(argv[0], "import") == 0)
+		return import_payloads(argc - 1, argv + 1);
+	else if (strcmp(argv[0], "export") == 0)
+		return export_payloads(argc - 1, argv + 1);
 	else if (strcmp(argv[0], "launch") == 0)
 		return launch(argc - 1, argv + 1);
 	else if (strcmp(argv[0], "cancel") == 0)
@@ -344,6 +812,34 @@ int PayloadDeployer::print_usage(const char *reason) {
 		R"DESCR_STR(
 ### Description
 Handles payload deployment for each item based on its aerodynamic properties.
+
+While a payload is being deployed, the module runs on every global position update, predicts the
+impact point from the current velocity and wind estimate, and opens the release servo when the
+predicted impact error is smallest and within PD_ACC_RAD.
+
+Besides the shell, the module is controlled over uORB, so that a ground station or companion can
+drive it through MAVLink or the DDS bridge:
+- payload_manifest adds or replaces up to 8 payloads per message
+- VEHICLE_CMD_PAYLOAD_CONTROL_DEPLOY cancels with param1 0, and launches with param1 1, param2 selecting
+  a payload index or 0 for all
+- VEHICLE_CMD_PAYLOAD_PREPARE_DEPLOY moves the target of payload param1 to param5/param6 (lat/lon) and
+  param7 (AMSL altitude of the target), NaN keeps a value
+The state of the deployment is published in payload_deploy_status.
+
+The release is published ahead of time through timed_actuator_set, with the pwm_id selecting the
+Peripheral via Actuator Set output. The mixer applies it on the output cycle closest to the requested
+time, and the measured delay of each output is subtracted from later releases.
+
+The dispersion command samples the release conditions from the wind, position and velocity uncertainty
+of the estimators and the drag tolerance PD_CD_TOL, integrates the fall of each sample and reports the
+circular error probable and the impact ellipse. On POSIX the samples are integrated on several threads.
+
+The release altitude of a payload is its height above the target. If the AMSL elevation of the target
+is set (target_alt), the approach is flown at AMSL altitude, otherwise the target is assumed at the
+elevation of home.
+
+The payloads are kept in a binary manifest on the storage. They are loaded in the background when the module starts,
+or by the first command if that comes earlier.
 )DESCR_STR");
 	PRINT_MODULE_USAGE_NAME("payload_deployer", "command");
 	PRINT_MODULE_USAGE_COMMAND_DESCR("add [index ...]", "Add a new payload.");
@@ -351,7 +847,10 @@ Handles payload deployment for each item based on its aerodynamic properties.
 	PRINT_MODULE_USAGE_COMMAND_DESCR("test_servo [index]", "Test servo open/close functionality.");
 	PRINT_MODULE_USAGE_COMMAND_DESCR("remove [index]", "Remove the payload.");
 	PRINT_MODULE_USAGE_COMMAND_DESCR("list", "List the payloads.");
-	PRINT_MODULE_USAGE_COMMAND_DESCR("launch [[index]]", "Launch deployment, if index not specified all will be deployed by their order.");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("import [file]", "Add the payloads of a manifest or a text file with the arguments of add on each line.");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("export [file]", "Write the payloads to a manifest file.");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("dispersion [index] [[samples]]", "Estimate the impact dispersion of a payload from the current estimator uncertainty.");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("launch [[index]]", "Launch deployment, if index not specified all will be deployed in the order of the shortest flight.");
 	PRINT_MODULE_USAGE_COMMAND_DESCR("cancel", "Stop deplyment and hold vechicle.");
 	PRINT_MODULE_USAGE_DEFAULT_COMMANDS();
 	return PX4_OK;
@@ -359,17 +858,285 @@ Handles payload deployment for each item based on its aerodynamic properties.
 
 void PayloadDeployer::Run() {
 	if (should_exit()) {
-		ScheduleClear();
 		_vehicle_command_sub.unregisterCallback();
+		_vehicle_global_position_sub.unregisterCallback();
+		_payload_manifest_sub.unregisterCallback();
 		exit_and_cleanup();
 		return;
 	}
 
+	perf_begin(_loop_perf);
+
 	if (_parameter_update_sub.updated()) {
 		parameter_update_s param_update_dummy;
 		_parameter_update_sub.copy(&param_update_dummy);
 		parameter_update();
 	}
+
+	vehicle_command_s command;
+	while (_vehicle_command_sub.update(&command))
+		handle_command(command);
+
+	update_worker();
+
+	vehicle_global_position_s global_position;
+	if (_vehicle_global_position_sub.update(&global_position)) {
+		if (_last_position_time != 0) {
+			const float dt = math::constrain((global_position.timestamp - _last_position_time) * 1e-6f, 0.001f, 0.5f);
+			_position_interval = 0.9f * _position_interval + 0.1f * dt;
+		}
+		_last_position_time = global_position.timestamp;
+
+		_vehicle_local_position_sub.update(&_local_position);
+		_home_position_sub.update(&_home_position);
+
+		wind_s wind;
+		if (_wind_sub.update(&wind))
+			_wind = Vector2f(wind.windspeed_north, wind.windspeed_east);
+
+		LockGuard guard{_store.mutex()};
+		if (_active_item != 0)
+			track_release(global_position);
+		else if (_release_time != 0)
+			close_servo(); // cancelled
+	}
+
+	update_output_offset();
+	publish_status();
+
+	perf_end(_loop_perf);
+}
+
+void PayloadDeployer::handle_command(const vehicle_command_s &command) {
+	// only handle commands that are meant for this system and component, or broadcast
+	_vehicle_status_sub.update(&_vehicle_status);
+	if ((command.target_system != _vehicle_status.system_id && command.target_system != 0)
+	    || (command.target_component != _vehicle_status.component_id && command.target_component != 0))
+		return;
+
+	switch (command.command) {
+	case vehicle_command_s::VEHICLE_CMD_PAYLOAD_CONTROL_DEPLOY:
+		// param2 is a payload index, or 0 or NaN for all
+		if (!PX4_ISFINITE(command.param1) || command.param2 > PayloadStore::kMaxIndex) {
+			answer_command(command, vehicle_command_ack_s::VEHICLE_CMD_RESULT_DENIED);
+			return;
+		}
+		if (command.param1 < 0.5f) { // abort
+			cancel();
+			answer_command(command, vehicle_command_ack_s::VEHICLE_CMD_RESULT_ACCEPTED);
+			return;
+		}
+		break;
+	case vehicle_command_s::VEHICLE_CMD_PAYLOAD_PREPARE_DEPLOY:
+		// payload index, converted to unsigned by the worker
+		if (!PX4_ISFINITE(command.param1) || command.param1 < 1.f || command.param1 > PayloadStore::kMaxIndex) {
+			answer_command(command, vehicle_command_ack_s::VEHICLE_CMD_RESULT_DENIED);
+			return;
+		}
+		break;
+	default:
+		return;
+	}
+	// launching and retargeting block, the worker answers once done
+	if (_worker.isBusy()) {
+		answer_command(command, vehicle_command_ack_s::VEHICLE_CMD_RESULT_TEMPORARILY_REJECTED);
+		return;
+	}
+	_worker.startCommand(command);
+	answer_command(command, vehicle_command_ack_s::VEHICLE_CMD_RESULT_IN_PROGRESS);
+}
+
+void PayloadDeployer::answer_command(const vehicle_command_s &command, uint8_t result) {
+	vehicle_command_ack_s command_ack{};
+	command_ack.command = command.command;
+	command_ack.result = result;
+	command_ack.target_system = command.source_system;
+	command_ack.target_component = command.source_component;
+	command_ack.timestamp = hrt_absolute_time();
+	_vehicle_command_ack_pub.publish(command_ack);
+}
+
+void PayloadDeployer::update_worker() {
+	if (_worker.hasResult()) {
+		if (_worker.request() == DeployWorker::Request::Command) {
+			answer_command(_worker.command(), _worker.result());
+		} else if (_worker.request() == DeployWorker::Request::Manifest) {
+			_status.manifest_batch_id = _worker.manifest().batch_id;
+			_status.manifest_accepted = _worker.accepted();
+			_status.manifest_rejected = _worker.rejected();
+			_last_status_time = 0; // publish now
+		}
+		_worker.reset();
+	}
+
+	// batches wait in the subscription queue while the worker is busy
+	payload_manifest_s manifest;
+	if (!_worker.isBusy() && _payload_manifest_sub.update(&manifest))
+		_worker.startManifest(manifest);
+
+	// poll for the result, position updates may be missing on the ground
+	if (_worker.isBusy())
+		ScheduleDelayed(50_ms);
+}
+
+void PayloadDeployer::publish_status() {
+	LockGuard guard{_store.mutex()};
+	uint8_t state = payload_deploy_status_s::STATE_IDLE;
+	if (_active_item != 0)
+		state = _release_time != 0 ? payload_deploy_status_s::STATE_RELEASING : payload_deploy_status_s::STATE_APPROACH;
+
+	const hrt_abstime now = hrt_absolute_time();
+	if (state == _status.state && _active_item == _status.active_index && now < _last_status_time + 500_ms)
+		return;
+
+	_status.state = state;
+	_status.active_index = _active_item;
+	_status.sequence_position = _active_item != 0 ? _sequence_position : 0;
+	_status.sequence_length = _sequence_length;
+	_status.payload_count = _store.size();
+	_status.miss_distance = _active_item != 0 ? _miss_distance : NAN;
+	_status.release_time = _release_time;
+	_status.timestamp = now;
+	_payload_deploy_status_pub.publish(_status);
+	_last_status_time = now;
+}
+
+void PayloadDeployer::track_release(const vehicle_global_position_s &global_position) {
+	const int slot = _store.find(_active_item);
+	if (slot == PayloadStore::kInvalidSlot) { // removed while being deployed
+		_active_item = 0;
+		if (_release_time != 0)
+			close_servo();
+		return;
+	}
+
+	if (_release_time != 0) {
+		const hrt_abstime now = hrt_absolute_time();
+		if (now > _release_time && now - _release_time > static_cast<hrt_abstime>(_param_pd_open_time.get() * 1e6f)) {
+			close_servo();
+			advance();
+		}
+		return;
+	}
+
+	if (!global_position.lat_lon_valid || !_local_position.v_xy_valid || !_local_position.v_z_valid)
+		return;
+
+	ballistics::ReleaseState state{};
+	state.velocity = Vector3f(_local_position.vx, _local_position.vy, _local_position.vz);
+	state.wind = _wind;
+	// height above the target, in the same reference as the flown approach: the destination elevation,
+	// or home for destinations without one (the approach altitude is then relative to home)
+	const float destination_alt = _store.destination_alt(slot);
+	if (PX4_ISFINITE(destination_alt))
+		state.height = global_position.alt - destination_alt;
+	else if (_home_position.valid_alt)
+		state.height = global_position.alt - _home_position.alt;
+	else
+		return;
+
+	// the terrain estimate refers to the ground below the vehicle, which is only a cross-check for the target
+	float ground_height = NAN;
+	if (global_position.terrain_alt_valid)
+		ground_height = global_position.alt - global_position.terrain_alt;
+	else if (_local_position.dist_bottom_valid)
+		ground_height = _local_position.dist_bottom;
+	if (PX4_ISFINITE(ground_height) && fabsf(ground_height - state.height) > kHeightMismatch
+	    && _height_warned_item != _active_item) {
+		PX4_WARN("payload %u: height above the target %.1f m, above ground %.1f m", _active_item,
+			 (double)state.height, (double)ground_height);
+		_height_warned_item = _active_item;
+	}
+
+	ballistics::Solution solution{};
+	perf_begin(_solve_perf);
+	const bool solved = _store.drop_table(slot).lookup(state, solution) || ballistics::solve(_store.body(slot), state, solution);
+	perf_end(_solve_perf);
+	if (!solved)
+		return;
+
+	Vector2f target{};
+	get_vector_to_next_waypoint(global_position.lat, global_position.lon,
+				    _store.destination_lat(slot), _store.destination_lon(slot), &target(0), &target(1));
+
+	// impact error if released now, the impact point moves along with the vehicle
+	const Vector2f error = solution.offset - target;
+	const Vector2f velocity(_local_position.vx, _local_position.vy);
+	const float speed_sq = velocity.norm_squared();
+	const float t_closest = speed_sq > FLT_EPSILON ? -error.dot(velocity) / speed_sq : 0.f;
+	_miss_distance = error.norm();
+
+	// schedule the release if the impact error is smallest before the next sample arrives
+	if (t_closest < _position_interval) {
+		const float miss = (error + velocity * math::max(t_closest, 0.f)).norm();
+		if (miss <= _param_pd_acc_rad.get()) {
+			// the prediction refers to the estimator sample time, the mixer applies it on the closest output cycle
+			hrt_abstime apply_at = 0;
+			const int pwm_id = _store.pwm_id(slot);
+			if (t_closest > 0.f && pwm_id >= 1 && pwm_id <= timed_actuator_set_s::MAX_NUM_ACTUATORS) {
+				const float lead = t_closest - _output_offset[pwm_id - 1];
+				const hrt_abstime sample_time = global_position.timestamp_sample != 0 ?
+								global_position.timestamp_sample : global_position.timestamp;
+				apply_at = sample_time + static_cast<hrt_abstime>(math::max(lead, 0.f) * 1e6f);
+			}
+			actuate(slot, true, apply_at);
+			_release_time = apply_at != 0 ? apply_at : hrt_absolute_time();
+			PX4_INFO("payload %u release in %.1f ms, predicted impact error %.2f m", _active_item,
+				 (double)(math::max(t_closest, 0.f) * 1e3f), (double)miss);
+		}
+	}
+}
+
+void PayloadDeployer::actuate(int slot, bool open, hrt_abstime apply_at) {
+	// pwm_id selects the Peripheral via Actuator Set output function, pwm is mapped to [-1, 1]
+	const int pwm_id = _store.pwm_id(slot);
+	if (pwm_id < 1 || pwm_id > timed_actuator_set_s::MAX_NUM_ACTUATORS) {
+		PX4_ERR("payload %u: pwm_id %d is not an actuator set output (1-6)", _store.index(slot), pwm_id);
+		return;
+	}
+	const int pwm = open ? _store.pwm_open(slot) : _store.pwm_close(slot);
+
+	timed_actuator_set_s timed_set{};
+	timed_set.apply_at = apply_at;
+	timed_set.index = pwm_id - 1;
+	timed_set.value = math::constrain((pwm - 1500) / 500.f, -1.f, 1.f);
+	timed_set.timestamp = hrt_absolute_time();
+	_timed_actuator_set_pub.publish(timed_set);
+
+	if (open) {
+		_released_pwm_id = pwm_id;
+		_released_close_value = math::constrain((_store.pwm_close(slot) - 1500) / 500.f, -1.f, 1.f);
+	}
+}
+
+void PayloadDeployer::close_servo() {
+	if (_released_pwm_id != 0) {
+		timed_actuator_set_s timed_set{};
+		timed_set.index = _released_pwm_id - 1;
+		timed_set.value = _released_close_value;
+		timed_set.timestamp = hrt_absolute_time();
+		_timed_actuator_set_pub.publish(timed_set);
+	}
+	_released_pwm_id = 0;
+	_release_time = 0;
+}
+
+void PayloadDeployer::update_output_offset() {
+	timed_actuator_set_ack_s ack;
+	while (_timed_actuator_set_ack_sub.update(&ack)) {
+		// only scheduled requests tell how far off the requested time the output moved
+		if (ack.apply_at != 0 && ack.index < timed_actuator_set_s::MAX_NUM_ACTUATORS) {
+			const float offset = math::constrain((float)((int64_t)ack.applied - (int64_t)ack.apply_at) * 1e-6f, -0.1f, 0.1f);
+			_output_offset[ack.index] = 0.8f * _output_offset[ack.index] + 0.2f * offset;
+		}
+	}
+}
+
+void PayloadDeployer::advance() {
+	if (++_sequence_position < _sequence_length)
+		_active_item = _sequence[_sequence_position];
+	else
+		_active_item = 0;
 }
 
 void PayloadDeployer::parameter_update()
@@ -379,6 +1146,15 @@ void PayloadDeployer::parameter_update()
 
 /** @see ModuleBase::print_status() */
 int PayloadDeployer::print_status() {
+	if (_active_item != 0)
+		PX4_INFO("deploying payload %u, predicted impact error %.2f m", _active_item, (double)_miss_distance);
+	else
+		PX4_INFO("idle");
+	PX4_INFO("position update interval %.1f ms", (double)(_position_interval * 1e3f));
+	for (int i = 0; i < timed_actuator_set_s::MAX_NUM_ACTUATORS; i++)
+		PX4_INFO("pwm_id %d output cycle offset %.2f ms", i + 1, (double)(_output_offset[i] * 1e3f));
+	perf_print_counter(_loop_perf);
+	perf_print_counter(_solve_perf);
 	return 0;
 }
 
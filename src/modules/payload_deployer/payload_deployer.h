@@ -40,6 +40,7 @@
 #include <px4_platform_common/module.h>
 #include <px4_platform_common/module_params.h>
 #include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
+#include <lib/perf/perf_counter.h>
 
 #include <uORB/Publication.hpp>
 #include <uORB/Subscription.hpp>
@@ -48,11 +49,28 @@
 #include <uORB/topics/vehicle_command.h>
 #include <uORB/topics/vehicle_command_ack.h>
 #include <uORB/topics/parameter_update.h>
+#include <uORB/topics/home_position.h>
+#include <uORB/topics/payload_deploy_status.h>
+#include <uORB/topics/payload_manifest.h>
+#include <uORB/topics/timed_actuator_set.h>
+#include <uORB/topics/timed_actuator_set_ack.h>
+#include <uORB/topics/vehicle_global_position.h>
+#include <uORB/topics/vehicle_local_position.h>
+#include <uORB/topics/vehicle_status.h>
+#include <uORB/topics/wind.h>
 
-#include "payload.h"
+#include "deploy_worker.h"
+#include "dispersion.h"
+#include "drop_mission.h"
+#include "drop_planner.h"
+#include "payload_store.h"
 
 using namespace time_literals;
 
+#ifndef CONFIG_PAYLOAD_DEPLOYER_MAX_PAYLOADS
+#define CONFIG_PAYLOAD_DEPLOYER_MAX_PAYLOADS 8
+#endif
+
 extern "C" __EXPORT int payload_deployer_main(int argc, char *argv[]);
 
 class PayloadDeployer : public ModuleBase<PayloadDeployer>, public ModuleParams, public px4::ScheduledWorkItem
@@ -60,7 +78,7 @@ class PayloadDeployer : public ModuleBase<PayloadDeployer>, public ModuleParams,
 public:
 	PayloadDeployer();
 
-	virtual ~PayloadDeployer() = default;
+	virtual ~PayloadDeployer();
 
 	/** @see ModuleBase */
 	static int task_spawn(int argc, char *argv[]);
@@ -92,11 +110,32 @@ public:
 	/* list added payloads */
 	static bool list();
 
-	/* start deployment of payloads, if index is not specified, all payloads will be deployed by their order */
+	/* add the payloads of a manifest or a text file with one payload per line */
+	static bool import_payloads(int argc, char *argv[]);
+
+	/* write the payloads to a manifest file */
+	static bool export_payloads(int argc, char *argv[]);
+
+	/* estimate the impact dispersion of a payload released at the end of its run-in */
+	static bool dispersion(int argc, char *argv[]);
+
+	/* start deployment of payloads, if index is not specified, all payloads will be deployed in the order of the shortest flight */
 	static bool launch(int argc, char *argv[]);
 
 	/* cancel deployment of payloads and stop vehicle where it is */
 	static bool cancel();
+
+	/* predict where a payload released now would land, relative to the vehicle */
+	static bool predict_impact(int slot, ballistics::Solution &solution);
+
+	/* run a vehicle_command that blocks, from the worker thread, returns the vehicle_command_ack result */
+	static uint8_t execute_command(const vehicle_command_s &command);
+
+	/* add or replace the payloads of a payload_manifest batch, from the worker thread */
+	static void apply_manifest(const payload_manifest_s &manifest, uint8_t &accepted, uint8_t &rejected);
+
+	/* load the persistent manifest, from the worker thread at startup */
+	static void load_payloads();
 private:
 	/**
 	 * @brief Main Run function that runs when subscription callback is triggered
@@ -105,14 +144,123 @@ private:
 
 	void parameter_update();
 
+	/* handle a vehicle_command, the ones that block are passed to the worker thread */
+	void handle_command(const vehicle_command_s &command);
+
+	/* acknowledge a vehicle_command */
+	void answer_command(const vehicle_command_s &command, uint8_t result);
+
+	/* report the worker results and hand it the next manifest batch */
+	void update_worker();
+
+	/* publish payload_deploy_status on change, or at 2 Hz */
+	void publish_status();
+
+	/* track the predicted impact point of the active payload and release it at the closest approach */
+	void track_release(const vehicle_global_position_s &global_position);
+
+	/* drive the release servo of a payload to its open or close position at apply_at, 0 for immediately */
+	void actuate(int slot, bool open, hrt_abstime apply_at = 0);
+
+	/* drive a release servo back to its close position */
+	void close_servo();
+
+	/* update the measured output cycle offset from the mixer acknowledgements */
+	void update_output_offset();
+
+	/* select the payload following the active one, or end the deployment */
+	static void advance();
+
+	/* plan the approach of each payload, order them for the shortest flight and write the mission */
+	static bool plan_launch(const int *slots, int count);
+
+	/* plan and write the mission for one payload, or all if index is 0, returns the vehicle_command_ack result */
+	static uint8_t launch_payloads(unsigned index);
+
+	/* move the target of a payload, NaN keeps a value, returns the vehicle_command_ack result */
+	static uint8_t retarget(unsigned index, double lat, double lon, float destination_alt);
+
+	/* convert the 11 or 12 arguments of add into a manifest record */
+	static void parse_record(char *args[], int size, PayloadManifest::Record &record);
+
+	/* check the fields of a record are in range */
+	static bool valid(const PayloadManifest::Record &record);
+
+	/* build the drop table of a record into _scratch_table, false if it fails or is too coarse for PD_ACC_RAD */
+	static bool build_table(const PayloadManifest::Record &record);
+
+	/* validate a record and add it as a new payload, kInvalidSlot if invalid or its index is taken unless replace is set */
+	static int insert(const PayloadManifest::Record &record, bool replace = false);
+
+	/* add the payloads of a manifest file, returns the number added or -1 if the file isn't a manifest */
+	static int load_manifest(const char *path);
+
+	/* write all payloads to a manifest file */
+	static bool save_manifest(const char *path = kManifestPath);
+
+	/* load the persistent manifest once, before the first command, recovering an interrupted save */
+	static void restore();
+
+	static constexpr const char *kManifestPath = PX4_STORAGEDIR "/payloads.bin";
+	static constexpr float kHeightMismatch = 10.f; // difference of the target and ground heights that is reported (m)
+
 	// Subscription
 	uORB::SubscriptionCallbackWorkItem _vehicle_command_sub{this, ORB_ID(vehicle_command)};
+	uORB::SubscriptionCallbackWorkItem _vehicle_global_position_sub{this, ORB_ID(vehicle_global_position)}; // runs the module at estimator rate
+	uORB::SubscriptionCallbackWorkItem _payload_manifest_sub{this, ORB_ID(payload_manifest)};
+	uORB::Subscription                 _vehicle_local_position_sub{ORB_ID(vehicle_local_position)};
+	uORB::Subscription                 _home_position_sub{ORB_ID(home_position)};
+	uORB::Subscription                 _vehicle_status_sub{ORB_ID(vehicle_status)};
+	uORB::Subscription                 _wind_sub{ORB_ID(wind)};
+	uORB::Subscription                 _timed_actuator_set_ack_sub{ORB_ID(timed_actuator_set_ack)};
 	uORB::SubscriptionInterval         _parameter_update_sub{ORB_ID(parameter_update), 1_s}; // subscription limited to 1 Hz updates
 
 	// Publications
 	uORB::Publication<vehicle_command_ack_s> _vehicle_command_ack_pub{ORB_ID(vehicle_command_ack)};
-	uORB::Publication<vehicle_command_s> _vehicle_command_pub{ORB_ID(vehicle_command)};
+	uORB::Publication<timed_actuator_set_s> _timed_actuator_set_pub{ORB_ID(timed_actuator_set)};
+	uORB::Publication<payload_deploy_status_s> _payload_deploy_status_pub{ORB_ID(payload_deploy_status)};
+
+	DeployWorker _worker;
+
+	hrt_abstime _last_status_time{0};
+	payload_deploy_status_s _status{};
+
+	vehicle_local_position_s _local_position{};
+	home_position_s _home_position{}; // reference of destinations without an elevation
+	vehicle_status_s _vehicle_status{}; // system and component id the commands are addressed to
+	matrix::Vector2f _wind{}; // last wind estimate, zero until one is available
+
+	hrt_abstime _last_position_time{0};
+	float _position_interval{0.01f}; // filtered interval between position updates (s)
+	hrt_abstime _release_time{0}; // time the servo of the active payload is scheduled to open, 0 if closed
+	int _released_pwm_id{0}; // servo to close once the open time has passed
+	float _released_close_value{0.f};
+
+	// offset of the output cycle that applied a scheduled value from the requested time per pwm_id (s).
+	// This is the quantization to the output cycle, not the servo response.
+	float _output_offset[timed_actuator_set_s::MAX_NUM_ACTUATORS] {};
+	float _miss_distance{NAN}; // predicted impact error of the active payload (m)
+	uint32_t _height_warned_item{0}; // payload the height cross-check already warned about
+
+	perf_counter_t _loop_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": cycle")};
+	perf_counter_t _solve_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": solve")};
+
+	DEFINE_PARAMETERS(
+		(ParamFloat<px4::params::PD_ACC_RAD>) _param_pd_acc_rad,
+		(ParamFloat<px4::params::PD_OPEN_TIME>) _param_pd_open_time,
+		(ParamFloat<px4::params::PD_APPR_SPD>) _param_pd_appr_spd,
+		(ParamFloat<px4::params::PD_RUN_IN>) _param_pd_run_in,
+		(ParamFloat<px4::params::PD_CD_TOL>) _param_pd_cd_tol
+	)
 
-	static IntrusiveSortedList<Payload *> _payloads; // list of added payloads, sorted by index
+	// Shell commands are serialized by _command_mutex and are the only writers of _store. They take the store
+	// mutex to modify it, the work queue takes it to read the store and the deployment state below.
+	static PayloadStore _store; // added payloads
+	static pthread_mutex_t _command_mutex;
+	static DropTable _scratch_table; // built outside of the store mutex, guarded by _command_mutex
 	static unsigned _active_item; // index of item that is currently being deployed
+	static unsigned _sequence[DropPlanner::kMaxNodes]; // payload indices in the planned drop order
+	static int _sequence_length;
+	static int _sequence_position; // position of the active item in _sequence
+	static bool _restored; // persistent manifest has been loaded
 };
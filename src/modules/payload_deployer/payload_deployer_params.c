@@ -0,0 +1,108 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file payload_deployer_params.c
+ *
+ * Parameters used by the payload deployer
+ */
+
+/**
+ * Release acceptance radius
+ *
+ * A payload is only released if its predicted impact point
+ * at the moment of closest approach is within this distance
+ * of the target.
+ *
+ * @decimal 1
+ * @min 0.5
+ * @max 100.0
+ * @unit m
+ * @group Payload Deployer
+ */
+PARAM_DEFINE_FLOAT(PD_ACC_RAD, 5.0);
+
+/**
+ * Servo open time
+ *
+ * Time the release servo of a payload is held in the open
+ * position before it is closed again.
+ *
+ * @decimal 1
+ * @min 0.1
+ * @max 10.0
+ * @unit s
+ * @group Payload Deployer
+ */
+PARAM_DEFINE_FLOAT(PD_OPEN_TIME, 1.0);
+
+/**
+ * Approach airspeed
+ *
+ * Airspeed on the run-in towards a release point, used to
+ * plan the release points of a launch.
+ *
+ * @decimal 1
+ * @min 1.0
+ * @max 50.0
+ * @unit m/s
+ * @group Payload Deployer
+ */
+PARAM_DEFINE_FLOAT(PD_APPR_SPD, 15.0);
+
+/**
+ * Run-in length
+ *
+ * Length of the straight, into-wind approach that ends at
+ * the release point of a payload.
+ *
+ * @decimal 0
+ * @min 0.0
+ * @max 1000.0
+ * @unit m
+ * @group Payload Deployer
+ */
+PARAM_DEFINE_FLOAT(PD_RUN_IN, 150.0);
+
+/**
+ * Drag coefficient tolerance
+ *
+ * Relative tolerance of the drag coefficient of the payloads,
+ * used to estimate the impact dispersion.
+ *
+ * @decimal 2
+ * @min 0.0
+ * @max 0.9
+ * @group Payload Deployer
+ */
+PARAM_DEFINE_FLOAT(PD_CD_TOL, 0.1);
@@ -0,0 +1,261 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file payload_store.cpp
+ */
+
+#include "payload_store.h"
+
+#include <new>
+
+PayloadStore::PayloadStore()
+{
+	pthread_mutex_init(&_mutex, nullptr);
+}
+
+PayloadStore::~PayloadStore()
+{
+	free_arrays();
+	pthread_mutex_destroy(&_mutex);
+}
+
+void PayloadStore::free_arrays()
+{
+	delete[] _index;
+	delete[] _weight;
+	delete[] _area_x;
+	delete[] _area_y;
+	delete[] _drag_coef;
+	delete[] _altitude;
+	delete[] _destination;
+	delete[] _servo;
+	delete[] _drop_table;
+	delete[] _hash;
+
+	_index = nullptr;
+	_weight = nullptr;
+	_area_x = nullptr;
+	_area_y = nullptr;
+	_drag_coef = nullptr;
+	_altitude = nullptr;
+	_destination = nullptr;
+	_servo = nullptr;
+	_drop_table = nullptr;
+	_hash = nullptr;
+}
+
+bool PayloadStore::init(unsigned capacity)
+{
+	if (_capacity != 0) {
+		return true;
+	}
+
+	if (capacity == 0 || capacity > INT16_MAX / 2) {
+		return false;
+	}
+
+	unsigned hash_size = 1;
+
+	while (hash_size < 2 * capacity) {
+		hash_size <<= 1;
+	}
+
+	_index = new (std::nothrow) uint16_t[capacity];
+	_weight = new (std::nothrow) float[capacity];
+	_area_x = new (std::nothrow) float[capacity];
+	_area_y = new (std::nothrow) float[capacity];
+	_drag_coef = new (std::nothrow) float[capacity];
+	_altitude = new (std::nothrow) float[capacity];
+	_destination = new (std::nothrow) Destination[capacity];
+	_servo = new (std::nothrow) Servo[capacity];
+	_drop_table = new (std::nothrow) DropTable[capacity];
+	_hash = new (std::nothrow) int16_t[hash_size];
+
+	if (!_index || !_weight || !_area_x || !_area_y || !_drag_coef || !_altitude || !_destination || !_servo
+	    || !_drop_table || !_hash) {
+		// a later call can retry
+		free_arrays();
+		return false;
+	}
+
+	for (unsigned i = 0; i < hash_size; i++) {
+		_hash[i] = kInvalidSlot;
+	}
+
+	_hash_mask = hash_size - 1;
+	_capacity = capacity;
+	return true;
+}
+
+int PayloadStore::find(unsigned index) const
+{
+	if (_capacity == 0) {
+		return kInvalidSlot;
+	}
+
+	for (unsigned b = bucket(index); _hash[b] != kInvalidSlot; b = (b + 1) & _hash_mask) {
+		if (_index[_hash[b]] == index) {
+			return _hash[b];
+		}
+	}
+
+	return kInvalidSlot;
+}
+
+int PayloadStore::insert(const PayloadManifest::Record &record, const DropTable &table)
+{
+	if (_size >= _capacity || record.index == 0 || record.index > kMaxIndex || find(record.index) != kInvalidSlot) {
+		return kInvalidSlot;
+	}
+
+	const int slot = _size++;
+	assign(slot, record, table);
+	hash_insert(record.index, slot);
+	return slot;
+}
+
+bool PayloadStore::update(int slot, const PayloadManifest::Record &record, const DropTable &table)
+{
+	if (record.index != _index[slot]) {
+		if (record.index == 0 || record.index > kMaxIndex || find(record.index) != kInvalidSlot) {
+			return false;
+		}
+
+		hash_remove(_index[slot]);
+		hash_insert(record.index, slot);
+	}
+
+	assign(slot, record, table);
+	return true;
+}
+
+bool PayloadStore::remove(unsigned index)
+{
+	const int slot = find(index);
+
+	if (slot == kInvalidSlot) {
+		return false;
+	}
+
+	hash_remove(index);
+
+	// keep the slots dense, the last payload takes the freed slot
+	const int last = --_size;
+
+	if (slot != last) {
+		for (unsigned b = bucket(_index[last]); ; b = (b + 1) & _hash_mask) {
+			if (_hash[b] == last) {
+				_hash[b] = slot;
+				break;
+			}
+		}
+
+		_index[slot] = _index[last];
+		_weight[slot] = _weight[last];
+		_area_x[slot] = _area_x[last];
+		_area_y[slot] = _area_y[last];
+		_drag_coef[slot] = _drag_coef[last];
+		_altitude[slot] = _altitude[last];
+		_destination[slot] = _destination[last];
+		_servo[slot] = _servo[last];
+		_drop_table[slot] = _drop_table[last];
+	}
+
+	return true;
+}
+
+PayloadManifest::Record PayloadStore::record(int slot) const
+{
+	PayloadManifest::Record record{};
+	record.destination_lat = _destination[slot].lat;
+	record.destination_lon = _destination[slot].lon;
+	record.destination_alt = _destination[slot].alt;
+	record.weight = _weight[slot];
+	record.area_x = _area_x[slot];
+	record.area_y = _area_y[slot];
+	record.drag_coef = _drag_coef[slot];
+	record.altitude = _altitude[slot];
+	record.index = _index[slot];
+	record.pwm_id = _servo[slot].pwm_id;
+	record.pwm_open = _servo[slot].pwm_open;
+	record.pwm_close = _servo[slot].pwm_close;
+	return record;
+}
+
+void PayloadStore::assign(int slot, const PayloadManifest::Record &record, const DropTable &table)
+{
+	_index[slot] = record.index;
+	_weight[slot] = record.weight;
+	_area_x[slot] = record.area_x;
+	_area_y[slot] = record.area_y;
+	_drag_coef[slot] = record.drag_coef;
+	_altitude[slot] = record.altitude;
+	_destination[slot] = {record.destination_lat, record.destination_lon, record.destination_alt};
+	_servo[slot] = {record.pwm_id, record.pwm_open, record.pwm_close};
+	_drop_table[slot] = table;
+}
+
+void PayloadStore::hash_insert(unsigned index, int slot)
+{
+	unsigned b = bucket(index);
+
+	while (_hash[b] != kInvalidSlot) {
+		b = (b + 1) & _hash_mask;
+	}
+
+	_hash[b] = slot;
+}
+
+void PayloadStore::hash_remove(unsigned index)
+{
+	unsigned hole = bucket(index);
+
+	while (_index[_hash[hole]] != index) {
+		hole = (hole + 1) & _hash_mask;
+	}
+
+	// shift back the entries of the probe sequence behind the hole, no tombstones needed
+	for (unsigned b = (hole + 1) & _hash_mask; _hash[b] != kInvalidSlot; b = (b + 1) & _hash_mask) {
+		const unsigned home = bucket(_index[_hash[b]]);
+		const bool movable = hole <= b ? (home <= hole || home > b) : (home <= hole && home > b);
+
+		if (movable) {
+			_hash[hole] = _hash[b];
+			hole = b;
+		}
+	}
+
+	_hash[hole] = kInvalidSlot;
+}
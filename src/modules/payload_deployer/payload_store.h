@@ -0,0 +1,153 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file payload_store.h
+ *
+ * Fixed-capacity pool of payload definitions.
+ *
+ * All storage is allocated once by init(). Payloads occupy the slots
+ * 0..size()-1 without gaps, removing one moves the last payload into the
+ * freed slot, so slots are only stable while the store is locked. The payload
+ * index is mapped to its slot by an open addressing hash table, which makes
+ * lookups O(1).
+ *
+ * The fields are kept as structure of arrays by slot: the aerodynamic
+ * properties read by the fall solver, the target, the release servo and the
+ * drop tables each live in their own array.
+ */
+
+#pragma once
+
+#include <pthread.h>
+#include <stdint.h>
+
+#include "ballistics.h"
+#include "drop_table.h"
+#include "manifest.h"
+
+class PayloadStore
+{
+public:
+	static constexpr int kInvalidSlot = -1;
+	static constexpr unsigned kMaxIndex = UINT16_MAX;
+
+	PayloadStore();
+	~PayloadStore();
+
+	PayloadStore(const PayloadStore &) = delete;
+	PayloadStore &operator=(const PayloadStore &) = delete;
+
+	/**
+	 * Allocate the pool, only the first call has an effect.
+	 * @return false if the allocation failed
+	 */
+	bool init(unsigned capacity);
+
+	unsigned capacity() const { return _capacity; }
+	unsigned size() const { return _size; }
+
+	/** @return slot of the payload with the given index, kInvalidSlot if there is none */
+	int find(unsigned index) const;
+
+	/**
+	 * Add a payload with its drop table.
+	 * @return slot of the new payload, kInvalidSlot if the store is full or the index is taken
+	 */
+	int insert(const PayloadManifest::Record &record, const DropTable &table);
+
+	/**
+	 * Replace the definition of a payload, including its index.
+	 * @return false if the new index is taken by another payload
+	 */
+	bool update(int slot, const PayloadManifest::Record &record, const DropTable &table);
+
+	/** @return false if there is no payload with the given index */
+	bool remove(unsigned index);
+
+	PayloadManifest::Record record(int slot) const;
+
+	unsigned index(int slot) const { return _index[slot]; }
+	ballistics::Body body(int slot) const { return {_weight[slot], _area_x[slot], _area_y[slot], _drag_coef[slot]}; }
+	float altitude(int slot) const { return _altitude[slot]; }
+	double destination_lat(int slot) const { return _destination[slot].lat; }
+	double destination_lon(int slot) const { return _destination[slot].lon; }
+	float destination_alt(int slot) const { return _destination[slot].alt; }
+	const DropTable &drop_table(int slot) const { return _drop_table[slot]; }
+	int pwm_id(int slot) const { return _servo[slot].pwm_id; }
+	int pwm_open(int slot) const { return _servo[slot].pwm_open; }
+	int pwm_close(int slot) const { return _servo[slot].pwm_close; }
+
+	/** guards the slots against concurrent modification */
+	pthread_mutex_t &mutex() { return _mutex; }
+
+private:
+	struct Destination {
+		double lat;
+		double lon;
+		float alt; ///< AMSL, NaN if at the elevation of home
+	};
+
+	struct Servo {
+		int32_t pwm_id;
+		int32_t pwm_open;
+		int32_t pwm_close;
+	};
+
+	unsigned bucket(unsigned index) const { return (index * 2654435761u) & _hash_mask; }
+	void hash_insert(unsigned index, int slot);
+	void hash_remove(unsigned index);
+	void free_arrays();
+	void assign(int slot, const PayloadManifest::Record &record, const DropTable &table);
+
+	pthread_mutex_t _mutex;
+
+	unsigned _capacity{0};
+	unsigned _size{0};
+
+	// by slot
+	uint16_t *_index{nullptr};
+	float *_weight{nullptr};
+	float *_area_x{nullptr};
+	float *_area_y{nullptr};
+	float *_drag_coef{nullptr};
+	float *_altitude{nullptr};
+	Destination *_destination{nullptr};
+	Servo *_servo{nullptr};
+	DropTable *_drop_table{nullptr};
+
+	// index -> slot, a power of two of at least twice the capacity, kInvalidSlot if empty
+	int16_t *_hash{nullptr};
+	unsigned _hash_mask{0};
+};
@@ -0,0 +1,160 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * Test code for the payload store
+ * Run this test only using make tests TESTFILTER=payload_store
+ */
+
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+
+#include "payload_store.h"
+
+static PayloadManifest::Record make_record(unsigned index)
+{
+	PayloadManifest::Record record{};
+	record.destination_lat = 35. + index * 1e-4;
+	record.destination_lon = 42.;
+	record.weight = 0.1f * index;
+	record.area_x = 0.007f;
+	record.area_y = 0.0022f;
+	record.drag_coef = 0.42f;
+	record.altitude = 100.f;
+	record.destination_alt = 480.f;
+	record.index = index;
+	record.pwm_id = 1 + index % 6;
+	record.pwm_open = 1900;
+	record.pwm_close = 1100;
+	return record;
+}
+
+TEST(PayloadStoreTest, MatchesReferenceMap)
+{
+	static constexpr unsigned kCapacity = 50;
+	PayloadStore store;
+	ASSERT_TRUE(store.init(kCapacity));
+
+	const DropTable table{};
+	std::map<unsigned, float> reference; // index -> weight
+	std::default_random_engine generator(7);
+	// small index range to force collisions and reuse
+	std::uniform_int_distribution<unsigned> index_distribution(1, 120);
+	std::uniform_int_distribution<int> operation(0, 2);
+
+	for (int i = 0; i < 20000; i++) {
+		const unsigned index = index_distribution(generator);
+
+		switch (operation(generator)) {
+		case 0: {
+				const int slot = store.insert(make_record(index), table);
+				const bool expected = reference.count(index) == 0 && reference.size() < kCapacity;
+				ASSERT_EQ(slot != PayloadStore::kInvalidSlot, expected);
+
+				if (expected) {
+					reference[index] = make_record(index).weight;
+				}
+			}
+			break;
+
+		case 1:
+			ASSERT_EQ(store.remove(index), reference.erase(index) == 1);
+			break;
+
+		default: {
+				// move a payload to another index
+				const int slot = store.find(index);
+				ASSERT_EQ(slot != PayloadStore::kInvalidSlot, reference.count(index) == 1);
+
+				if (slot != PayloadStore::kInvalidSlot) {
+					PayloadManifest::Record record = store.record(slot);
+					record.index = index_distribution(generator);
+					const bool expected = record.index == index || reference.count(record.index) == 0;
+					ASSERT_EQ(store.update(slot, record, table), expected);
+
+					if (expected) {
+						const float weight = reference[index];
+						reference.erase(index);
+						reference[record.index] = weight;
+					}
+				}
+			}
+			break;
+		}
+
+		ASSERT_EQ(store.size(), reference.size());
+	}
+
+	for (unsigned index = 1; index <= 120; index++) {
+		const int slot = store.find(index);
+		ASSERT_EQ(slot != PayloadStore::kInvalidSlot, reference.count(index) == 1);
+
+		if (slot != PayloadStore::kInvalidSlot) {
+			EXPECT_EQ(store.index(slot), index);
+			EXPECT_FLOAT_EQ(store.body(slot).mass, reference[index]);
+		}
+	}
+}
+
+TEST(PayloadStoreTest, RecordRoundTrip)
+{
+	PayloadStore store;
+	ASSERT_TRUE(store.init(4));
+
+	const PayloadManifest::Record record = make_record(17);
+	const int slot = store.insert(record, DropTable{});
+	ASSERT_NE(slot, PayloadStore::kInvalidSlot);
+
+	const PayloadManifest::Record stored = store.record(slot);
+	EXPECT_EQ(memcmp(&stored, &record, sizeof(record)), 0);
+	EXPECT_EQ(store.pwm_id(slot), record.pwm_id);
+	EXPECT_DOUBLE_EQ(store.destination_lat(slot), record.destination_lat);
+	EXPECT_FLOAT_EQ(store.destination_alt(slot), record.destination_alt);
+}
+
+TEST(PayloadStoreTest, RejectsInvalidInput)
+{
+	PayloadStore store;
+	EXPECT_EQ(store.find(1), PayloadStore::kInvalidSlot);
+	EXPECT_EQ(store.insert(make_record(1), DropTable{}), PayloadStore::kInvalidSlot);
+
+	ASSERT_TRUE(store.init(2));
+	EXPECT_EQ(store.insert(make_record(0), DropTable{}), PayloadStore::kInvalidSlot);
+	EXPECT_EQ(store.insert(make_record(PayloadStore::kMaxIndex + 1), DropTable{}), PayloadStore::kInvalidSlot);
+	EXPECT_NE(store.insert(make_record(1), DropTable{}), PayloadStore::kInvalidSlot);
+	EXPECT_NE(store.insert(make_record(2), DropTable{}), PayloadStore::kInvalidSlot);
+	EXPECT_EQ(store.insert(make_record(3), DropTable{}), PayloadStore::kInvalidSlot);
+	EXPECT_FALSE(store.remove(3));
+}
@@ -693,22 +693,37 @@ Replay::readDropout(std::ifstream &file, uint16_t msg_size)
 }
 
 bool
-Replay::nextDataMessage(std::ifstream &file, Subscription &subscription, int msg_id)
+Replay::nextDataMessage(std::ifstream &file, Subscription &subscription, int msg_id, bool skip_first)
 {
 	ulog_message_header_s message_header;
 	file.seekg(subscription.next_read_pos);
-	//ignore the first message (it's data we already read)
-	file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
 
-	if (file) {
-		file.seekg(message_header.msg_size, ios::cur);
+	if (skip_first) {
+		//ignore the first message (it's data we already read)
+		file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
+
+		if (file) {
+			file.seekg(message_header.msg_size, ios::cur);
+		}
 	}
 
 	uint16_t file_msg_id;
 	bool done = false;
+	streamoff check_index_at = 0;
 
 	while (file && !done) {
 		streampos cur_pos = file.tellg();
+
+		// skip the parts of the file without this topic
+		if (!_index.empty() && (streamoff)cur_pos >= check_index_at) {
+			const streamoff seek_pos = _index.seek(msg_id, cur_pos, check_index_at);
+
+			if (seek_pos != (streamoff)cur_pos) {
+				file.seekg(seek_pos);
+				cur_pos = seek_pos;
+			}
+		}
+
 		file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
 
 		if (!file) {
@@ -776,6 +791,44 @@ Replay::nextDataMessage(std::ifstream &file, Subscription &subscription, int msg
 	return file.good();
 }
 
+std::streampos
+Replay::seekToTime(std::ifstream &file, uint64_t timestamp)
+{
+	streampos pos = _data_section_start;
+
+	// start of the interval that contains timestamp
+	const streamoff interval_start = _index.intervalStart(timestamp);
+
+	if (interval_start >= 0) {
+		pos = interval_start;
+
+	} else {
+		PX4_WARN("No log index for the start time, searching the file");
+	}
+
+	for (size_t i = 0; i < _subscriptions.size(); ++i) {
+		Subscription *subscription = _subscriptions[i];
+
+		if (!subscription || !subscription->orb_meta) {
+			continue;
+		}
+
+		if (subscription->next_read_pos < pos) {
+			subscription->next_read_pos = pos;
+			nextDataMessage(file, *subscription, i, false);
+		}
+
+		while (subscription->orb_meta && subscription->next_timestamp < timestamp) {
+			if (!nextDataMessage(file, *subscription, i)) {
+				break;
+			}
+		}
+	}
+
+	file.clear();
+	return pos;
+}
+
 const orb_metadata *
 Replay::findTopic(const std::string &name)
 {
@@ -889,6 +942,14 @@ Replay::run()
 		return;
 	}
 
+	_index.read(replay_file);
+
+	const char *replay_start = getenv(replay::ENV_START);
+
+	if (replay_start) {
+		_start_offset = (uint64_t)(std::max(atof(replay_start), 0.) * 1e6);
+	}
+
 	_speed_factor = 1.f;
 	const char *speedup = getenv("PX4_SIM_SPEED_FACTOR");
 
@@ -918,6 +979,11 @@ Replay::run()
 		if (message_header.msg_type == (int)ULogMessageType::ADD_LOGGED_MSG) {
 			readAndAddSubscription(replay_file, message_header.msg_size);
 
+		} else if (message_header.msg_type == (int)ULogMessageType::PARAMETER && _start_offset > 0) {
+			// remember parameter changes, the ones before the start time are applied when seeking
+			_parameter_offsets.push_back((streamoff)replay_file.tellg() - ULOG_MSG_HEADER_LEN);
+			replay_file.seekg(message_header.msg_size, ios::cur);
+
 		} else {
 			// Not important for now, skip
 			replay_file.seekg(message_header.msg_size, ios::cur);
@@ -932,6 +998,29 @@ Replay::run()
 	uint32_t nr_published_messages = 0;
 	streampos last_additional_message_pos = _data_section_start;
 
+	if (_start_offset > 0) {
+		// data messages before the start time are skipped, but the parameter changes logged before it are applied.
+		// Scheduled parameter changes are applied before the first published message.
+		PX4_INFO("Starting replay at t=%.3lf s", (double)_start_offset / 1.e6);
+		last_additional_message_pos = seekToTime(replay_file, _file_start_time + _start_offset);
+
+		for (const streamoff parameter_offset : _parameter_offsets) {
+			if (parameter_offset >= (streamoff)last_additional_message_pos) {
+				break;
+			}
+
+			replay_file.seekg(parameter_offset);
+			replay_file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
+
+			if (!replay_file || !readAndApplyParameter(replay_file, message_header.msg_size)) {
+				break;
+			}
+		}
+
+		_parameter_offsets.clear();
+		replay_file.clear();
+	}
+
 	while (!should_exit() && replay_file) {
 
 		//Find the next message to publish. Messages from different subscriptions don't need
@@ -1245,6 +1334,12 @@ the log file to be replayed. The second is the mode, specified via `replay_mode`
 - Generic otherwise: this can be used to replay any module(s), but the replay will be done with the same speed as the
   log was recorded.
 
+Optionally, `replay_start` can be set to a time in seconds (relative to the start of the log) at which to start the
+replay. Parameter changes logged before that time are applied. If the log contains a seek index (see `SDLOG_INDEX`),
+the data messages before the start time are not read, and the index is also used to skip over parts of the log
+without data of a topic. The message headers of the whole log are still read once at startup, to find the logged
+topics and parameter changes.
+
 The module is typically used together with uORB publisher rules, to specify which messages should be replayed.
 The replay module will just publish all messages that are found in the log. It also applies the parameters from
 the log.
@@ -41,6 +41,7 @@
 #include <string>
 
 #include "definitions.hpp"
+#include "ReplayIndex.hpp"
 
 #include <px4_platform_common/module.h>
 #include <uORB/topics/uORBTopics.hpp>
@@ -200,18 +201,18 @@ protected:
 
 	/**
 	 * Find next data message for this subscription, starting with the stored file offset.
-	 * Skip the first message, and if found, read the timestamp and store the new file offset.
+	 * Skip the first message (unless skip_first is false), and if found, read the timestamp and store the new file offset.
 	 * When reaching EOF, the subscription is set to invalid.
 	 * File seek position is arbitrary after this call.
 	 * @return false on file error
 	 */
-	bool nextDataMessage(std::ifstream &file, Subscription &subscription, int msg_id);
+	bool nextDataMessage(std::ifstream &file, Subscription &subscription, int msg_id, bool skip_first = true);
 
 	virtual uint64_t getTimestampOffset()
 	{
 		//we update the timestamps from the file by a constant offset to match
 		//the current replay time
-		return _replay_start_time - _file_start_time;
+		return _replay_start_time - _file_start_time - _start_offset;
 	}
 
 	std::vector<Subscription *> _subscriptions;
@@ -249,6 +250,17 @@ private:
 
 	int64_t _read_until_file_position = 1ULL << 60; ///< read limit if log contains appended data
 
+	uint64_t _start_offset{0}; ///< replay start, relative to the log start [us] (from the replay_start env variable)
+	std::vector<std::streamoff> _parameter_offsets; ///< PARAMETER messages in the data section (only with _start_offset)
+
+	ReplayIndex _index; ///< seek index of the log, empty if it has none
+
+	/**
+	 * Move all subscriptions to the first message at or after the given log time
+	 * @return file position from where additional messages are handled
+	 */
+	std::streampos seekToTime(std::ifstream &file, uint64_t timestamp);
+
 	float _accumulated_delay{0.f};
 
 	bool readFileHeader(std::ifstream &file);
@@ -0,0 +1,286 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "ReplayIndex.hpp"
+
+#include <px4_platform_common/log.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include <logger/messages.h>
+
+using namespace std;
+
+namespace px4
+{
+
+bool
+ReplayIndex::read(std::istream &file)
+{
+	_buckets.clear();
+
+	file.seekg(0, ios::end);
+	const streamoff file_size = file.tellg();
+
+	if (!file || file_size < (streamoff)(sizeof(ulog_file_header_s) + ULOG_INDEX_TRAILER_LEN)) {
+		file.clear();
+		return false;
+	}
+
+	// the trailer is the last message: 'uint64_t ulog_index_dir' info message
+	uint8_t trailer[ULOG_INDEX_TRAILER_LEN];
+	file.seekg(file_size - ULOG_INDEX_TRAILER_LEN);
+	file.read((char *)trailer, sizeof(trailer));
+
+	const size_t key_len = sizeof(ULOG_INDEX_TRAILER_KEY) - 1;
+	ulog_message_header_s trailer_header;
+	memcpy(&trailer_header, trailer, ULOG_MSG_HEADER_LEN);
+
+	if (!file || trailer_header.msg_type != (uint8_t)ULogMessageType::INFO
+	    || trailer_header.msg_size != ULOG_INDEX_TRAILER_LEN - ULOG_MSG_HEADER_LEN
+	    || trailer[ULOG_MSG_HEADER_LEN] != key_len
+	    || memcmp(trailer + ULOG_MSG_HEADER_LEN + 1, ULOG_INDEX_TRAILER_KEY, key_len) != 0) {
+		file.clear();
+		return false;
+	}
+
+	uint64_t directory_offset;
+	memcpy(&directory_offset, trailer + ULOG_MSG_HEADER_LEN + 1 + key_len, sizeof(directory_offset));
+
+	std::vector<uint8_t> data;
+	streamoff next;
+
+	if (!readInfoMultipleData(file, directory_offset, "ulog_index_dir", data, next)
+	    || data.size() < sizeof(ulog_index_dir_header_s)) {
+		PX4_WARN("Invalid log index directory, ignoring the index");
+		return false;
+	}
+
+	ulog_index_dir_header_s directory;
+	memcpy(&directory, data.data(), sizeof(directory));
+
+	if (directory.version != 1
+	    || data.size() < sizeof(directory) + directory.num_entries * sizeof(ulog_index_dir_entry_s)) {
+		PX4_WARN("Unsupported log index (version %i), ignoring the index", directory.version);
+		return false;
+	}
+
+	std::vector<ulog_index_dir_entry_s> entries(directory.num_entries);
+	memcpy(entries.data(), data.data() + sizeof(directory), directory.num_entries * sizeof(ulog_index_dir_entry_s));
+
+	for (const ulog_index_dir_entry_s &entry : entries) {
+		// follow the links back to the previous directory entry to get the buckets in between (coarsened directory)
+		const streamoff previous_end = _buckets.empty() ? 0 : _buckets.back().next;
+		std::vector<Bucket> buckets;
+		streamoff bucket_pos = entry.offset;
+
+		while (bucket_pos >= previous_end && bucket_pos > 0) {
+			Bucket index_bucket{};
+			streamoff previous;
+
+			if (!readBucket(file, bucket_pos, index_bucket, previous) || index_bucket.offset < previous_end
+			    || previous >= index_bucket.offset) {
+				break;
+			}
+
+			buckets.push_back(std::move(index_bucket));
+			bucket_pos = previous;
+		}
+
+		_buckets.insert(_buckets.end(), std::make_move_iterator(buckets.rbegin()),
+			      std::make_move_iterator(buckets.rend()));
+	}
+
+	// sanity check: the first indexed message must be a data message of that topic
+	if (!_buckets.empty() && !_buckets.front().first.empty()) {
+		const auto &first = *_buckets.front().first.begin();
+		uint8_t message[ULOG_MSG_HEADER_LEN + sizeof(uint16_t)];
+		file.seekg(first.second);
+		file.read((char *)message, sizeof(message));
+
+		if (!file || message[2] != (uint8_t)ULogMessageType::DATA
+		    || (message[3] | (message[4] << 8)) != first.first) {
+			PX4_WARN("Log index does not match the data, ignoring the index");
+			_buckets.clear();
+		}
+	}
+
+	file.clear();
+
+	if (!_buckets.empty()) {
+		PX4_INFO("Using log index (%zu intervals)", _buckets.size());
+	}
+
+	return !_buckets.empty();
+}
+
+bool
+ReplayIndex::readBucket(std::istream &file, std::streamoff offset, Bucket &index_bucket,
+			std::streamoff &previous)
+{
+	std::vector<uint8_t> data;
+	ulog_index_bucket_s bucket;
+
+	if (!readInfoMultipleData(file, offset, "ulog_index", data, index_bucket.next)
+	    || data.size() < sizeof(bucket)) {
+		return false;
+	}
+
+	memcpy(&bucket, data.data(), sizeof(bucket));
+
+	if (data.size() < sizeof(bucket) + bucket.num_entries * sizeof(ulog_index_entry_s)
+	    || (streamoff)bucket.offset > offset) {
+		return false;
+	}
+
+	index_bucket.timestamp = bucket.timestamp;
+	index_bucket.offset = bucket.offset;
+	index_bucket.end = offset;
+	previous = bucket.previous;
+
+	for (int i = 0; i < bucket.num_entries; ++i) {
+		ulog_index_entry_s index_entry;
+		memcpy(&index_entry, data.data() + sizeof(bucket) + i * sizeof(index_entry), sizeof(index_entry));
+		index_bucket.first[index_entry.msg_id] = bucket.offset + index_entry.offset;
+	}
+
+	return true;
+}
+
+bool
+ReplayIndex::readInfoMultipleData(std::istream &file, std::streamoff offset, const char *name,
+				  std::vector<uint8_t> &data, std::streamoff &next)
+{
+	data.clear();
+	file.seekg(offset);
+
+	while (true) {
+		const streamoff message_pos = file.tellg();
+		ulog_message_header_s message_header;
+		file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
+
+		if (!file || message_header.msg_type != (uint8_t)ULogMessageType::INFO_MULTIPLE
+		    || message_header.msg_size < 2) {
+			file.clear();
+			next = message_pos;
+			return !data.empty();
+		}
+
+		_read_buffer.reserve(message_header.msg_size + 1);
+		uint8_t *message = _read_buffer.data();
+		file.read((char *)message, message_header.msg_size);
+		message[message_header.msg_size] = 0;
+
+		const bool is_continued = message[0];
+		const uint8_t key_len = message[1];
+
+		// key: "uint8_t[N] <name>"
+		const char *key_name = nullptr;
+
+		if (file && key_len + 2 <= message_header.msg_size) {
+			key_name = (const char *)memchr(message + 2, ' ', key_len);
+		}
+
+		if (!key_name || strncmp((const char *)message + 2, "uint8_t[", 8) != 0
+		    || (size_t)(message + 2 + key_len - (uint8_t *)key_name - 1) != strlen(name)
+		    || strncmp(key_name + 1, name, strlen(name)) != 0 || is_continued != !data.empty()) {
+			// not (a continuation of) the requested value
+			file.clear();
+			next = message_pos;
+			return !data.empty();
+		}
+
+		data.insert(data.end(), message + 2 + key_len, message + message_header.msg_size);
+	}
+}
+
+std::streamoff
+ReplayIndex::seek(uint16_t msg_id, std::streamoff pos, std::streamoff &check_until) const
+{
+	static constexpr streamoff end_of_file = 1LL << 62;
+
+	// first bucket that ends after pos
+	auto it = std::upper_bound(_buckets.begin(), _buckets.end(), pos, [](streamoff p, const Bucket & bucket) {
+		return p < bucket.end;
+	});
+
+	if (it == _buckets.end()) {
+		check_until = end_of_file;
+		return pos;
+	}
+
+	if (it->offset > pos) {
+		// not indexed (before the first bucket, or a bucket missing in the directory)
+		check_until = it->offset;
+		return pos;
+	}
+
+	for (; it != _buckets.end(); ++it) {
+		const auto first = it->first.find(msg_id);
+
+		if (first != it->first.end()) {
+			check_until = it->end;
+			// further messages within the bucket are not indexed: continue from pos if the first one is before
+			return std::max(first->second, pos);
+		}
+
+		// not in this bucket: move on, as long as the next bucket directly follows
+		auto next = it + 1;
+
+		if (next == _buckets.end() || next->offset != it->next) {
+			check_until = next == _buckets.end() ? end_of_file : next->offset;
+			return std::max(it->end, pos);
+		}
+	}
+
+	check_until = end_of_file;
+	return pos;
+}
+
+std::streamoff
+ReplayIndex::intervalStart(uint64_t timestamp) const
+{
+	auto it = std::upper_bound(_buckets.begin(), _buckets.end(), timestamp, [](uint64_t t, const Bucket & bucket) {
+		return t < bucket.timestamp;
+	});
+
+	if (it == _buckets.begin()) {
+		return -1;
+	}
+
+	return (--it)->offset;
+}
+
+} // namespace px4
@@ -0,0 +1,102 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#pragma once
+
+#include <istream>
+#include <map>
+#include <vector>
+
+namespace px4
+{
+
+/**
+ * @class ReplayIndex
+ * Reads the seek index of a log (@see ulog_index_bucket_s), to skip the parts of the file without data of a topic.
+ */
+class ReplayIndex
+{
+public:
+	/**
+	 * Read the log index via the trailer at the end of the file, if the log has one
+	 * @return true if an index was found
+	 */
+	bool read(std::istream &file);
+
+	bool empty() const { return _buckets.empty(); }
+	size_t size() const { return _buckets.size(); }
+
+	/**
+	 * Use the index to skip data that does not contain a data message with msg_id
+	 * @param pos current file position
+	 * @param check_until set to the file position where the index should be checked again
+	 * @return file position to continue searching from (>= pos)
+	 */
+	std::streamoff seek(uint16_t msg_id, std::streamoff pos, std::streamoff &check_until) const;
+
+	/**
+	 * @return file position of the interval that contains the given log time, -1 if it is not indexed
+	 */
+	std::streamoff intervalStart(uint64_t timestamp) const;
+
+private:
+	/** interval of the log index */
+	struct Bucket {
+		uint64_t timestamp;
+		std::streamoff offset; ///< first message of the interval
+		std::streamoff end; ///< end of the interval (the 'ulog_index' message)
+		std::streamoff next; ///< after the 'ulog_index' message
+		std::map<uint16_t, std::streamoff> first; ///< msg_id -> first data message in the interval
+	};
+
+	/**
+	 * Read a 'ulog_index' message
+	 * @param previous set to the file offset of the previous 'ulog_index' message (0 if none)
+	 * @return true on success
+	 */
+	bool readBucket(std::istream &file, std::streamoff offset, Bucket &bucket, std::streamoff &previous);
+
+	/**
+	 * Read the value of a uint8_t[] multi info message with the given name, including continued messages
+	 * @param next set to the file position after the message(s)
+	 * @return true on success
+	 */
+	bool readInfoMultipleData(std::istream &file, std::streamoff offset, const char *name,
+				  std::vector<uint8_t> &data, std::streamoff &next);
+
+	std::vector<Bucket> _buckets; ///< sorted by offset
+	std::vector<uint8_t> _read_buffer;
+};
+
+} // namespace px4
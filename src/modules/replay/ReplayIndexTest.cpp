@@ -0,0 +1,286 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * Test code for the log index as read by replay
+ * Run this test only using make tests TESTFILTER=ReplayIndex
+ */
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string.h>
+#include <vector>
+
+#include <logger/log_index.h>
+#include <logger/messages.h>
+
+#include "ReplayIndex.hpp"
+
+using namespace px4;
+
+static constexpr uint64_t S = 1000000;
+static constexpr uint16_t TOPIC_ID = 1;
+static constexpr uint16_t EVENT_ID = 7;
+
+/**
+ * Writes a log the way the logger does: every message goes through LogIndex::add_message(), the buckets are
+ * written every interval and the directory and trailer at the end.
+ */
+class TestLog
+{
+public:
+	TestLog()
+	{
+		ulog_file_header_s header{};
+		append(&header, sizeof(header));
+		_index.start(0, _log.size());
+	}
+
+	void data(uint16_t msg_id, uint64_t timestamp)
+	{
+		uint8_t msg[ULOG_MSG_HEADER_LEN + sizeof(msg_id) + sizeof(timestamp)];
+		write_header(msg, sizeof(msg), ULogMessageType::DATA);
+		memcpy(msg + ULOG_MSG_HEADER_LEN, &msg_id, sizeof(msg_id));
+		memcpy(msg + ULOG_MSG_HEADER_LEN + sizeof(msg_id), &timestamp, sizeof(timestamp));
+		write(msg, sizeof(msg));
+	}
+
+	void logging(uint64_t timestamp)
+	{
+		ulog_message_logging_s msg{};
+		const size_t msg_size = sizeof(msg) - sizeof(msg.message) + strlen("text");
+		msg.msg_size = msg_size - ULOG_MSG_HEADER_LEN;
+		msg.timestamp = timestamp;
+		memcpy(msg.message, "text", strlen("text"));
+		write(&msg, msg_size);
+	}
+
+	void update(uint64_t now)
+	{
+		if (_index.interval_elapsed(now)) {
+			write_bucket(now);
+		}
+	}
+
+	std::string finish(uint64_t now)
+	{
+		write_bucket(now);
+
+		const uint64_t directory_offset = _log.size();
+		write_info_multiple("ulog_index_dir", _index.directory(), _index.directory_size());
+
+		uint8_t trailer[ULOG_INDEX_TRAILER_LEN];
+		const size_t key_len = strlen(ULOG_INDEX_TRAILER_KEY);
+		write_header(trailer, sizeof(trailer), ULogMessageType::INFO);
+		trailer[ULOG_MSG_HEADER_LEN] = key_len;
+		memcpy(trailer + ULOG_MSG_HEADER_LEN + 1, ULOG_INDEX_TRAILER_KEY, key_len);
+		memcpy(trailer + ULOG_MSG_HEADER_LEN + 1 + key_len, &directory_offset, sizeof(directory_offset));
+		write(trailer, sizeof(trailer));
+
+		return std::string(_log.begin(), _log.end());
+	}
+
+private:
+	static void write_header(uint8_t *msg, size_t size, ULogMessageType type)
+	{
+		const uint16_t msg_size = size - ULOG_MSG_HEADER_LEN;
+		memcpy(msg, &msg_size, sizeof(msg_size));
+		msg[2] = static_cast<uint8_t>(type);
+	}
+
+	void append(const void *data, size_t size)
+	{
+		const uint8_t *bytes = static_cast<const uint8_t *>(data);
+		_log.insert(_log.end(), bytes, bytes + size);
+	}
+
+	// Logger::write_message()
+	void write(const void *msg, size_t size)
+	{
+		_index.add_message(static_cast<const uint8_t *>(msg), _log.size());
+		append(msg, size);
+	}
+
+	void write_info_multiple(const char *name, const uint8_t *data, size_t size)
+	{
+		ulog_message_info_multiple_s msg{};
+		msg.is_continued = false;
+
+		while (size > 0) {
+			const size_t chunk_length = std::min(size, sizeof(msg.key_value_str) - strlen(name) - 16);
+			msg.key_len = snprintf(msg.key_value_str, sizeof(msg.key_value_str), "uint8_t[%zu] %s", chunk_length,
+					       name);
+			size_t msg_size = sizeof(msg) - sizeof(msg.key_value_str) + msg.key_len;
+			memcpy(reinterpret_cast<uint8_t *>(&msg) + msg_size, data, chunk_length);
+			msg_size += chunk_length;
+			msg.msg_size = msg_size - ULOG_MSG_HEADER_LEN;
+			write(&msg, msg_size);
+
+			data += chunk_length;
+			size -= chunk_length;
+			msg.is_continued = true;
+		}
+	}
+
+	void write_bucket(uint64_t now)
+	{
+		const uint64_t bucket_offset = _log.size();
+		write_info_multiple("ulog_index", _index.bucket(), _index.bucket_size());
+		_index.next_bucket(now, bucket_offset, _log.size());
+	}
+
+	std::vector<uint8_t> _log;
+	logger::LogIndex _index;
+};
+
+class ReplayIndexTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		TestLog log;
+
+		for (uint64_t t = 0; t < 10 * S; t += 10000) {
+			log.data(TOPIC_ID, t);
+
+			// events are sparse, several intervals have none
+			if (t == 1250000 || t == 1260000 || t == 4500000 || t == 7900000) {
+				log.data(EVENT_ID, t);
+			}
+
+			if (t % S == 0) {
+				log.logging(t);
+			}
+
+			log.update(t);
+		}
+
+		_file.str(log.finish(10 * S));
+		_data_start = sizeof(ulog_file_header_s);
+	}
+
+	/**
+	 * Offsets of the data messages of msg_id, searched like Replay::nextDataMessage()
+	 * @param headers_read set to the number of message headers read
+	 */
+	std::vector<std::streamoff> find(uint16_t msg_id, bool use_index, int &headers_read)
+	{
+		std::vector<std::streamoff> offsets;
+		std::streamoff pos = _data_start;
+		std::streamoff check_index_at = 0;
+		headers_read = 0;
+
+		_file.clear();
+
+		while (true) {
+			if (use_index && pos >= check_index_at) {
+				pos = _index.seek(msg_id, pos, check_index_at);
+			}
+
+			uint8_t header[ULOG_MSG_HEADER_LEN + sizeof(uint16_t)];
+			_file.seekg(pos);
+			_file.read((char *)header, sizeof(header));
+
+			if (!_file) {
+				break;
+			}
+
+			++headers_read;
+
+			if (header[2] == static_cast<uint8_t>(ULogMessageType::DATA)
+			    && (header[3] | (header[4] << 8)) == msg_id) {
+				offsets.push_back(pos);
+			}
+
+			pos += ULOG_MSG_HEADER_LEN + (header[0] | (header[1] << 8));
+		}
+
+		return offsets;
+	}
+
+	std::stringstream _file;
+	std::streamoff _data_start{0};
+	ReplayIndex _index;
+};
+
+TEST_F(ReplayIndexTest, FindsEvents)
+{
+	ASSERT_TRUE(_index.read(_file));
+	EXPECT_EQ(_index.size(), 10u);
+
+	int linear_headers;
+	int indexed_headers;
+	const std::vector<std::streamoff> linear = find(EVENT_ID, false, linear_headers);
+	const std::vector<std::streamoff> indexed = find(EVENT_ID, true, indexed_headers);
+
+	EXPECT_EQ(linear.size(), 4u);
+	EXPECT_EQ(indexed, linear);
+
+	// only the intervals with events are searched
+	EXPECT_LT(indexed_headers * 3, linear_headers);
+}
+
+TEST_F(ReplayIndexTest, FindsTopic)
+{
+	ASSERT_TRUE(_index.read(_file));
+
+	int linear_headers;
+	int indexed_headers;
+	const std::vector<std::streamoff> linear = find(TOPIC_ID, false, linear_headers);
+
+	EXPECT_EQ(linear.size(), 1000u);
+	EXPECT_EQ(find(TOPIC_ID, true, indexed_headers), linear);
+}
+
+TEST_F(ReplayIndexTest, IntervalStart)
+{
+	ASSERT_TRUE(_index.read(_file));
+
+	int headers_read;
+	const std::vector<std::streamoff> events = find(EVENT_ID, false, headers_read);
+	ASSERT_EQ(events.size(), 4u);
+
+	// the interval of the event at 4.5 s starts before it, after the previous event
+	const std::streamoff start = _index.intervalStart(4500000);
+	EXPECT_GT(start, events[1]);
+	EXPECT_LE(start, events[2]);
+}
+
+TEST_F(ReplayIndexTest, NoIndex)
+{
+	std::stringstream file(std::string(_file.str(), 0, 1000));
+	EXPECT_FALSE(_index.read(file));
+	EXPECT_TRUE(_index.empty());
+}
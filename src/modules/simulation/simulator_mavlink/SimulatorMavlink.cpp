@@ -484,7 +484,7 @@ void SimulatorMavlink::handle_message_hil_sensor(const mavlink_message_t *msg)
 	// Assume imu with id 0 is the primary imu an base lockstep based on this.
 	if (imu.id == 0) {
 		if (_lockstep_component == -1) {
-			_lockstep_component = px4_lockstep_register_component();
+			_lockstep_component = px4_lockstep_register_component(nullptr);
 		}
 
 		struct timespec ts;
@@ -117,10 +117,19 @@ void Sih::lockstep_loop()
 		speed_factor = atof(speedup);
 	}
 
-	int rt_interval_us = int(roundf(sim_interval_us / speed_factor));
+	// a speed factor of 0 (or below) fast-forwards: once in lockstep, run as fast as the components allow
+	const bool fast_forward = !(speed_factor > 0.f);
+	int rt_interval_us = fast_forward ? 0 : int(roundf(sim_interval_us / speed_factor));
 
 	PX4_INFO("Simulation loop with %d Hz (%d us sim time interval)", rate, sim_interval_us);
-	PX4_INFO("Simulation with %.1fx speedup. Loop with (%d us wall time interval)", (double)speed_factor, rt_interval_us);
+
+	if (fast_forward) {
+		PX4_INFO("Simulation fast-forward, running as fast as possible");
+
+	} else {
+		PX4_INFO("Simulation with %.1fx speedup. Loop with (%d us wall time interval)", (double)speed_factor, rt_interval_us);
+	}
+
 	uint64_t pre_compute_wall_time_us;
 
 	while (!should_exit()) {
@@ -146,15 +155,42 @@ void Sih::lockstep_loop()
 			sleep_time = math::max(0, sim_interval_us - (int)(current_wall_time_us - pre_compute_wall_time_us));
 
 		} else {
+			if (_lockstep_start_wall_time_us == 0) {
+				_lockstep_start_wall_time_us = pre_compute_wall_time_us;
+				_lockstep_start_simulation_time_us = _current_simulation_time_us - sim_interval_us;
+			}
+
 			px4_lockstep_wait_for_components();
 			current_wall_time_us = micros();
 			sleep_time = math::max(0, rt_interval_us - (int)(current_wall_time_us - pre_compute_wall_time_us));
 		}
 
-		_achieved_speedup = 0.99f * _achieved_speedup + 0.01f * ((float)sim_interval_us / (float)(
-					    current_wall_time_us - pre_compute_wall_time_us + sleep_time));
-		usleep(sleep_time);
+		_achieved_speedup = 0.99f * _achieved_speedup + 0.01f * ((float)sim_interval_us / (float)math::max((uint64_t)1,
+				    current_wall_time_us - pre_compute_wall_time_us + sleep_time));
+
+		if (sleep_time > 0) {
+			usleep(sleep_time);
+		}
 	}
+
+	if (_lockstep_start_wall_time_us != 0) {
+		PX4_INFO("Simulated %.1f s in %.1f s wall time (%.2fX)",
+			 (double)((_current_simulation_time_us - _lockstep_start_simulation_time_us) / 1e6),
+			 (double)((micros() - _lockstep_start_wall_time_us) / 1e6), (double)overall_speedup());
+		px4_lockstep_print_status();
+	}
+}
+
+float Sih::overall_speedup() const
+{
+	if (_lockstep_start_wall_time_us == 0) {
+		return 0.f;
+	}
+
+	const uint64_t wall_time_us = micros() - _lockstep_start_wall_time_us;
+	const uint64_t simulation_time_us = _current_simulation_time_us - _lockstep_start_simulation_time_us;
+
+	return wall_time_us > 0 ? (float)((double)simulation_time_us / wall_time_us) : 0.f;
 }
 #endif
 
@@ -712,7 +748,8 @@ int Sih::print_status()
 {
 #if defined(ENABLE_LOCKSTEP_SCHEDULER)
 	PX4_INFO("Running in lockstep mode");
-	PX4_INFO("Achieved speedup: %.2fX", (double)_achieved_speedup);
+	PX4_INFO("Achieved speedup: %.2fX (overall %.2fX)", (double)_achieved_speedup, (double)overall_speedup());
+	px4_lockstep_print_status();
 #endif
 
 	if (_vehicle == VehicleType::Multicopter) {
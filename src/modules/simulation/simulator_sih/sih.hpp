@@ -179,8 +179,13 @@ private:
 
 #if defined(ENABLE_LOCKSTEP_SCHEDULER)
 	void lockstep_loop();
+	float overall_speedup() const;
 	uint64_t _current_simulation_time_us{0};
 	float _achieved_speedup{0.f};
+
+	// wall and simulation time when lockstep started, for the speedup over the whole run
+	uint64_t _lockstep_start_wall_time_us{0};
+	uint64_t _lockstep_start_simulation_time_us{0};
 #endif
 
 	void realtime_loop();
@@ -0,0 +1,274 @@
+/****************************************************************************
+ *
+ *  Copyright (C) 2025 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file test_microbench_work_queue.cpp
+ * Microbenchmark the WorkQueue run queue: the lock-free IntrusiveMPSCQueue against
+ * a semaphore protected IntrusiveQueue (the previous WorkQueue::Add()/Run() path)
+ * and a BlockingQueue.
+ */
+
+#include <unit_test.h>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <containers/BlockingQueue.hpp>
+#include <containers/IntrusiveMPSCQueue.hpp>
+#include <containers/IntrusiveQueue.hpp>
+#include <drivers/drv_hrt.h>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+#include <px4_platform_common/sem.h>
+
+#ifndef __PX4_NUTTX
+#include <pthread.h>
+#endif
+
+namespace MicroBenchWorkQueue
+{
+
+#define PERF(name, op, count) do { \
+		px4_usleep(1000); \
+		perf_counter_t p = perf_alloc(PC_ELAPSED, name); \
+		for (int i = 0; i < count; i++) { \
+			px4_usleep(1); \
+			perf_begin(p); \
+			op; \
+			perf_end(p); \
+		} \
+		perf_print_counter(p); \
+		perf_free(p); \
+	} while (0)
+
+struct Item : public IntrusiveQueueNode<Item *> {
+	int value{0};
+};
+
+// the run queue as WorkQueue had it: an IntrusiveQueue behind a semaphore
+class LockedQueue
+{
+public:
+	LockedQueue() { px4_sem_init(&_lock, 0, 1); }
+	~LockedQueue() { px4_sem_destroy(&_lock); }
+
+	void push(Item *item)
+	{
+		do {} while (px4_sem_wait(&_lock) != 0);
+
+		_q.push(item);
+		px4_sem_post(&_lock);
+	}
+
+	Item *pop()
+	{
+		do {} while (px4_sem_wait(&_lock) != 0);
+
+		Item *item = _q.pop();
+		px4_sem_post(&_lock);
+		return item;
+	}
+
+private:
+	IntrusiveQueue<Item *> _q;
+	px4_sem_t _lock;
+};
+
+class LockFreeQueue
+{
+public:
+	void push(Item *item) { _pending.push(item); }
+
+	Item *pop()
+	{
+		if (_q.empty()) {
+			_pending.drain(_q);
+		}
+
+		return _q.pop();
+	}
+
+private:
+	IntrusiveMPSCQueue<Item *> _pending;
+	IntrusiveQueue<Item *> _q; // consumer side
+};
+
+template<class Q>
+static void push_pop(Q &queue, Item *items, int count)
+{
+	for (int i = 0; i < count; i++) {
+		queue.push(&items[i]);
+	}
+
+	for (int i = 0; i < count; i++) {
+		queue.pop();
+	}
+}
+
+class MicroBenchWorkQueue : public UnitTest
+{
+public:
+	bool run_tests() override;
+
+private:
+	bool time_single_thread();
+#ifndef __PX4_NUTTX
+	bool time_contended();
+
+	template<class Q>
+	bool contended(const char *name);
+#endif
+
+	static constexpr int ITEMS = 16;
+
+	Item _items[ITEMS] {};
+};
+
+bool MicroBenchWorkQueue::run_tests()
+{
+	ut_run_test(time_single_thread);
+#ifndef __PX4_NUTTX
+	ut_run_test(time_contended);
+#endif
+
+	return (_tests_failed == 0);
+}
+
+ut_declare_test_c(test_microbench_work_queue, MicroBenchWorkQueue)
+
+bool MicroBenchWorkQueue::time_single_thread()
+{
+	BlockingQueue<Item *, ITEMS> blocking_queue;
+	LockedQueue locked_queue;
+	LockFreeQueue lock_free_queue;
+
+	PERF("BlockingQueue push+pop", push_pop(blocking_queue, _items, ITEMS), 100);
+	PERF("locked IntrusiveQueue push+pop", push_pop(locked_queue, _items, ITEMS), 100);
+	PERF("IntrusiveMPSCQueue push+pop", push_pop(lock_free_queue, _items, ITEMS), 100);
+
+	return true;
+}
+
+#ifndef __PX4_NUTTX
+
+// BlockingQueue has a fixed capacity and blocks instead of returning nullptr
+class BoundedQueue
+{
+public:
+	void push(Item *item) { _q.push(item); }
+	Item *pop() { return _q.pop(); }
+
+private:
+	BlockingQueue<Item *, 64> _q;
+};
+
+template<class Q>
+struct Producer {
+	Q *queue;
+	Item *items;
+	int count;
+};
+
+template<class Q>
+static void *produce(void *arg)
+{
+	Producer<Q> *producer = (Producer<Q> *)arg;
+
+	for (int i = 0; i < producer->count; i++) {
+		producer->queue->push(&producer->items[i]);
+	}
+
+	return nullptr;
+}
+
+template<class Q>
+bool MicroBenchWorkQueue::contended(const char *name)
+{
+	static constexpr int PRODUCERS = 4;
+	static constexpr int COUNT = 20000;
+
+	Item *items = new Item[PRODUCERS * COUNT];
+	Q *queue = new Q();
+
+	if (items == nullptr || queue == nullptr) {
+		delete[] items;
+		delete queue;
+		return false;
+	}
+
+	Producer<Q> producers[PRODUCERS];
+	pthread_t threads[PRODUCERS];
+
+	const hrt_abstime start = hrt_absolute_time();
+
+	for (int i = 0; i < PRODUCERS; i++) {
+		producers[i] = {queue, &items[i * COUNT], COUNT};
+		pthread_create(&threads[i], nullptr, produce<Q>, &producers[i]);
+	}
+
+	int received = 0;
+
+	while (received < PRODUCERS * COUNT) {
+		if (queue->pop() != nullptr) {
+			received++;
+		}
+	}
+
+	const hrt_abstime elapsed = hrt_elapsed_time(&start);
+
+	for (int i = 0; i < PRODUCERS; i++) {
+		pthread_join(threads[i], nullptr);
+	}
+
+	PX4_INFO_RAW("%-32s %d producers: %8.1f ns per item\n", name, PRODUCERS,
+		     (double)elapsed * 1000. / (PRODUCERS * COUNT));
+
+	delete[] items;
+	delete queue;
+
+	return true;
+}
+
+bool MicroBenchWorkQueue::time_contended()
+{
+	ut_assert_true(contended<BoundedQueue>("BlockingQueue"));
+	ut_assert_true(contended<LockedQueue>("locked IntrusiveQueue"));
+	ut_assert_true(contended<LockFreeQueue>("IntrusiveMPSCQueue"));
+
+	return true;
+}
+
+#endif // __PX4_NUTTX
+
+} // namespace MicroBenchWorkQueue
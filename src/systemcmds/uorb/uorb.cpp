@@ -31,6 +31,7 @@
  *
  ****************************************************************************/
 
+#include <stdlib.h>
 #include <string.h>
 
 #include <uORB/uORB.h>
@@ -57,6 +58,42 @@ int uorb_main(int argc, char *argv[])
 
 	} else if (!strcmp(argv[1], "top")) {
 		return uorb_top(argv + 2, argc - 2);
+
+	} else if (!strcmp(argv[1], "latency")) {
+		const bool reset = (argc > 2) && !strcmp(argv[2], "-r");
+		return uorb_latency(argv + 2 + reset, argc - 2 - reset, reset);
+
+	} else if (!strcmp(argv[1], "graph")) {
+		const char *source = "sensor_gyro";
+		const char *sink = "actuator_motors";
+		bool json = false;
+		uint32_t interval_us = 1000000;
+
+		for (int i = 2; i < argc; i++) {
+			if (!strcmp(argv[i], "-j")) {
+				json = true;
+
+			} else if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+				source = argv[++i];
+
+			} else if (!strcmp(argv[i], "-e") && i + 1 < argc) {
+				sink = argv[++i];
+
+			} else if (!strcmp(argv[i], "-i") && i + 1 < argc) {
+				interval_us = strtoul(argv[++i], nullptr, 10) * 1000;
+
+				if (interval_us == 0) {
+					PX4_ERR("interval must be at least 1 ms");
+					return -1;
+				}
+
+			} else {
+				usage();
+				return -1;
+			}
+		}
+
+		return uorb_graph(source, sink, json, interval_us);
 	}
 
 	usage();
@@ -84,6 +121,18 @@ modules are allowed to publish which topics. This is used for system-wide replay
 ### Examples
 Monitor topic publication rates. Besides `top`, this is an important command for general system inspection:
 $ uorb top
+
+If built with ORB_LATENCY, each topic records log2 histograms of the time from a publication to the copies of
+its subscribers, separately for subscribers that are called back (work items) and the others. They show which
+hop of a chain of work queues adds latency or jitter. Print and reset the histograms of the rate controller inputs:
+$ uorb latency -r vehicle_angular_velocity vehicle_attitude_setpoint
+
+If built with ORB_GRAPH, topics record which WorkItems or tasks publish them. `uorb graph` prints the graph of
+publishers, topics and the WorkItems they call back, with the publication rates and the lag and run time of the
+WorkItems, as DOT or JSON. It marks the chain from a source to a sink topic with the highest latency: the sum of
+the lag from each publication to the WorkItem it calls back, and the run time of that WorkItem.
+From the shell of a SITL instance built with CONFIG_ORB_GRAPH=y:
+$ px4-uorb graph -s sensor_gyro -e actuator_motors > uorb.dot && dot -Tsvg uorb.dot -o uorb.svg
 )DESCR_STR");
 
 	PRINT_MODULE_USAGE_NAME("uorb", "communication");
@@ -92,4 +141,12 @@ $ uorb top
 	PRINT_MODULE_USAGE_PARAM_FLAG('a', "print all instead of only currently publishing topics with subscribers", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('1', "run only once, then exit", true);
 	PRINT_MODULE_USAGE_ARG("<filter1> [<filter2>]", "topic(s) to match (implies -a)", true);
+	PRINT_MODULE_USAGE_COMMAND_DESCR("latency", "Print the latency histograms of the topics, and publish them as orb_latency");
+	PRINT_MODULE_USAGE_PARAM_FLAG('r', "reset the histograms after printing them", true);
+	PRINT_MODULE_USAGE_ARG("<filter1> [<filter2>]", "topic(s) to match", true);
+	PRINT_MODULE_USAGE_COMMAND_DESCR("graph", "Print the graph of publishers, topics and callbacks, with the critical path");
+	PRINT_MODULE_USAGE_PARAM_STRING('s', "sensor_gyro", nullptr, "Topic the critical path starts from", true);
+	PRINT_MODULE_USAGE_PARAM_STRING('e', "actuator_motors", nullptr, "Topic the critical path ends at", true);
+	PRINT_MODULE_USAGE_PARAM_INT('i', 1000, 10, 10000, "Time to measure the rates (ms)", true);
+	PRINT_MODULE_USAGE_PARAM_FLAG('j', "print JSON instead of DOT", true);
 }